@@ -0,0 +1,165 @@
+// Copyright (c) 2026 Mikhail Kurinnoi
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+// Helpers shared by microbenchmarks and tools in `benchmarks` directory: time measurement, JSON output,
+// command line options parsing and portable PDB tables access.
+
+#ifndef BENCHMARKS_BENCHMARK_UTILS_H
+#define BENCHMARKS_BENCHMARK_UTILS_H
+
+#include <dnmd.h>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace benchmark
+{
+
+using Clock = std::chrono::steady_clock;
+
+// Run `func` repeatedly during `duration`, returns nanoseconds per call.
+template <class Func>
+double Measure(std::chrono::milliseconds duration, Func &&func)
+{
+    size_t iterations = 0;
+    size_t batch = 1;
+    const Clock::time_point start = Clock::now();
+    Clock::time_point now = start;
+    while (now - start < duration)
+    {
+        for (size_t i = 0; i < batch; ++i)
+        {
+            func();
+        }
+        iterations += batch;
+        batch *= 2;
+        now = Clock::now();
+    }
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(now - start).count()) /
+           static_cast<double>(iterations);
+}
+
+// Repeat `text` until result is at least `size` bytes long.
+inline std::string Repeat(const std::string &text, size_t size)
+{
+    std::string result;
+    while (result.size() < size)
+    {
+        result += text;
+    }
+    return result;
+}
+
+// Quoted and escaped JSON string.
+inline std::string JsonString(const std::string &str)
+{
+    std::string result("\"");
+    for (const char c : str)
+    {
+        if (c == '"' || c == '\\')
+        {
+            result += '\\';
+            result += c;
+        }
+        else if (static_cast<unsigned char>(c) < 0x20)
+        {
+            std::array<char, 8> buf{};
+            std::snprintf(buf.data(), buf.size(), "\\u%04x", static_cast<unsigned>(c));
+            result += buf.data();
+        }
+        else
+        {
+            result += c;
+        }
+    }
+    result += '"';
+    return result;
+}
+
+// Returns true in case `arg` is `option` (for example, `--time=`) with value, text after option is stored into `value`.
+inline bool ParseOption(const std::string &arg, std::string_view option, std::string &value)
+{
+    if (arg.compare(0, option.size(), option) != 0)
+    {
+        return false;
+    }
+    value = arg.substr(option.size());
+    return true;
+}
+
+template <class T>
+std::enable_if_t<std::is_arithmetic_v<T>, bool> ParseOption(const std::string &arg, std::string_view option, T &value)
+{
+    if (arg.compare(0, option.size(), option) != 0)
+    {
+        return false;
+    }
+    const char *str = arg.c_str() + option.size();
+    if constexpr (std::is_floating_point_v<T>)
+    {
+        value = static_cast<T>(std::strtod(str, nullptr));
+    }
+    else if constexpr (std::is_unsigned_v<T>)
+    {
+        value = static_cast<T>(std::strtoull(str, nullptr, 10));
+    }
+    else
+    {
+        value = static_cast<T>(std::strtoll(str, nullptr, 10));
+    }
+    return true;
+}
+
+template <class Rep, class Period>
+bool ParseOption(const std::string &arg, std::string_view option, std::chrono::duration<Rep, Period> &value)
+{
+    Rep count{};
+    if (!ParseOption(arg, option, count))
+    {
+        return false;
+    }
+    value = std::chrono::duration<Rep, Period>(count);
+    return true;
+}
+
+// Add input file, or all files with `extension` from input directory (recursively).
+inline void AddInputPath(const std::string &path, std::string_view extension, std::vector<std::string> &paths)
+{
+    if (!std::filesystem::is_directory(path))
+    {
+        paths.emplace_back(path);
+        return;
+    }
+
+    for (const auto &entry : std::filesystem::recursive_directory_iterator(path))
+    {
+        if (entry.is_regular_file() && entry.path().extension() == extension)
+        {
+            paths.emplace_back(entry.path().string());
+        }
+    }
+}
+
+// Rows count of portable PDB table, 0 in case table is not available.
+inline uint32_t GetTableRowCount(mdhandle_t pdbHandle, mdtable_id_t tableId)
+{
+    mdcursor_t cursor{};
+    uint32_t count = 0;
+    if (!md_create_cursor(pdbHandle, tableId, &cursor, &count))
+    {
+        return 0;
+    }
+    return count;
+}
+
+} // namespace benchmark
+
+#endif // BENCHMARKS_BENCHMARK_UTILS_H
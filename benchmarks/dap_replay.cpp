@@ -0,0 +1,837 @@
+// Copyright (c) 2026 Mikhail Kurinnoi
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+// DAP session replay from protocol log (see `--logProtocol` option), Unix only.
+// Debugger is started with protocol on stdin/stdout, recorded requests are sent again and per command response
+// latency distribution is reported, live responses are compared with recorded responses.
+//
+// Usage: dap_replay [--original-pacing] [--timeout=<milliseconds, 10000 by default>] [--map=<from>=<to>]
+//                   [--diff] [--json] <protocol log> <debugger path> [debugger arguments]...
+//
+// Each request is sent only after all responses and events, that were logged before this request, are received
+// (by default, as fast as possible). With `--original-pacing` option requests are also delayed in order to keep
+// recorded time offsets from session start (protocol log records must have time prefix).
+// Thread, frame, variables, breakpoint, module and memory references in requests are mapped from recorded to live
+// values, mapping is learned from responses and events (recorded and live messages are walked in parallel).
+// With `--map` option string arguments prefix is replaced (for example, program and sources paths).
+// With `--diff` option differences between recorded and live responses are printed.
+
+#include "benchmark_utils.h"
+#include <json/json.hpp>
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <spawn.h>
+#include <string>
+#include <string_view>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+extern char **environ; // NOLINT(readability-redundant-declaration)
+
+namespace
+{
+
+using namespace benchmark;
+using json = nlohmann::json;
+
+constexpr std::string_view logCommand("-> (C) ");
+constexpr std::string_view logResponse("<- (R) ");
+constexpr std::string_view logEvent("<- (E) ");
+constexpr std::string_view contentLength("Content-Length: ");
+constexpr std::string_view twoCRLF("\r\n\r\n");
+constexpr size_t maxDiffsPerResponse = 10;
+
+struct Options
+{
+    bool originalPacing{false};
+    bool diff{false};
+    bool json{false};
+    std::chrono::milliseconds timeout{10000};
+    std::vector<std::pair<std::string, std::string>> pathMap;
+    std::string logPath;
+    std::vector<std::string> debuggerArgs;
+};
+
+struct LogRecord
+{
+    enum class Kind : uint8_t
+    {
+        Request,
+        Response,
+        Event
+    };
+
+    Kind kind;
+    std::optional<double> time; // Seconds since protocol log start.
+    json message;
+};
+
+// Protocol log line: `[<time>] ` (optional), record prefix and JSON message.
+bool ParseLogLine(const std::string &line, LogRecord &record)
+{
+    std::string_view text(line);
+    record.time.reset();
+    if (!text.empty() && text.front() == '[')
+    {
+        const size_t end = text.find("] ");
+        if (end == std::string_view::npos)
+        {
+            return false;
+        }
+        record.time = std::strtod(std::string(text.substr(1, end - 1)).c_str(), nullptr);
+        text.remove_prefix(end + 2);
+    }
+
+    if (text.compare(0, logCommand.size(), logCommand) == 0)
+    {
+        record.kind = LogRecord::Kind::Request;
+    }
+    else if (text.compare(0, logResponse.size(), logResponse) == 0)
+    {
+        record.kind = LogRecord::Kind::Response;
+    }
+    else if (text.compare(0, logEvent.size(), logEvent) == 0)
+    {
+        record.kind = LogRecord::Kind::Event;
+    }
+    else
+    {
+        return false;
+    }
+    text.remove_prefix(logCommand.size());
+
+    record.message = json::parse(text, nullptr, false);
+    return !record.message.is_discarded() && record.message.is_object();
+}
+
+bool ReadLog(const std::string &path, std::vector<LogRecord> &records)
+{
+    std::ifstream file(path);
+    if (!file)
+    {
+        std::fprintf(stderr, "%s: can't open protocol log\n", path.c_str());
+        return false;
+    }
+    std::string line;
+    LogRecord record;
+    while (std::getline(file, line))
+    {
+        if (!line.empty() && line.back() == '\r')
+        {
+            line.pop_back();
+        }
+        if (ParseLogLine(line, record))
+        {
+            records.emplace_back(std::move(record));
+        }
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Debugger process with DAP on stdin/stdout.
+
+struct Received
+{
+    json message;
+    Clock::time_point time;
+};
+
+class DebuggerProcess
+{
+  public:
+
+    ~DebuggerProcess()
+    {
+        Stop();
+    }
+
+    bool Start(const std::vector<std::string> &args)
+    {
+        std::array<int, 2> inPipe{-1, -1};
+        std::array<int, 2> outPipe{-1, -1};
+        if (pipe(inPipe.data()) != 0 || pipe(outPipe.data()) != 0)
+        {
+            return false;
+        }
+
+        posix_spawn_file_actions_t actions;
+        posix_spawn_file_actions_init(&actions);
+        posix_spawn_file_actions_adddup2(&actions, inPipe[0], STDIN_FILENO);
+        posix_spawn_file_actions_adddup2(&actions, outPipe[1], STDOUT_FILENO);
+        posix_spawn_file_actions_addclose(&actions, inPipe[1]);
+        posix_spawn_file_actions_addclose(&actions, outPipe[0]);
+
+        std::vector<char *> argv;
+        argv.reserve(args.size() + 1);
+        for (const auto &arg : args)
+        {
+            argv.push_back(const_cast<char *>(arg.c_str()));
+        }
+        argv.push_back(nullptr);
+
+        const int error = posix_spawn(&m_pid, argv.front(), &actions, nullptr, argv.data(), environ);
+        posix_spawn_file_actions_destroy(&actions);
+        close(inPipe[0]);
+        close(outPipe[1]);
+        if (error != 0)
+        {
+            close(inPipe[1]);
+            close(outPipe[0]);
+            m_pid = -1;
+            return false;
+        }
+
+        m_input = inPipe[1];
+        m_output = outPipe[0];
+        m_reader = std::thread(&DebuggerProcess::ReaderWorker, this);
+        return true;
+    }
+
+    bool Send(const json &message)
+    {
+        const std::string body = message.dump();
+        std::string data(contentLength);
+        data += std::to_string(body.size());
+        data += twoCRLF;
+        data += body;
+
+        size_t written = 0;
+        while (written < data.size())
+        {
+            const ssize_t result = write(m_input, data.data() + written, data.size() - written);
+            if (result < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (result <= 0)
+            {
+                return false;
+            }
+            written += static_cast<size_t>(result);
+        }
+        return true;
+    }
+
+    // Wait for next received message till `deadline`, return false in case of timeout or debugger exit.
+    bool Receive(Clock::time_point deadline, Received &received)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (!m_cv.wait_until(lock, deadline, [this]() { return !m_received.empty() || m_eof; }) ||
+            m_received.empty())
+        {
+            return false;
+        }
+        received = std::move(m_received.front());
+        m_received.pop_front();
+        return true;
+    }
+
+    bool IsExited()
+    {
+        const std::scoped_lock<std::mutex> lock(m_mutex);
+        return m_eof && m_received.empty();
+    }
+
+    void Stop()
+    {
+        if (m_pid == -1)
+        {
+            return;
+        }
+
+        close(m_input);
+        int status = 0;
+        const Clock::time_point deadline = Clock::now() + std::chrono::seconds(5);
+        while (waitpid(m_pid, &status, WNOHANG) == 0)
+        {
+            if (Clock::now() > deadline)
+            {
+                kill(m_pid, SIGKILL);
+                waitpid(m_pid, &status, 0);
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        m_pid = -1;
+
+        if (m_reader.joinable())
+        {
+            m_reader.join();
+        }
+        close(m_output);
+    }
+
+  private:
+
+    pid_t m_pid{-1};
+    int m_input{-1};
+    int m_output{-1};
+    std::thread m_reader;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::deque<Received> m_received;
+    bool m_eof{false};
+
+    void ReaderWorker()
+    {
+        std::string buffer;
+        std::array<char, 64 * 1024> chunk{};
+        while (true)
+        {
+            const ssize_t result = read(m_output, chunk.data(), chunk.size());
+            if (result < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (result <= 0)
+            {
+                break;
+            }
+            const Clock::time_point time = Clock::now();
+            buffer.append(chunk.data(), static_cast<size_t>(result));
+
+            // Content-Length framed messages.
+            size_t start = 0;
+            while (true)
+            {
+                const size_t headerEnd = buffer.find(twoCRLF, start);
+                if (headerEnd == std::string::npos)
+                {
+                    break;
+                }
+                const size_t lengthPos = buffer.find(contentLength, start);
+                if (lengthPos == std::string::npos || lengthPos > headerEnd)
+                {
+                    start = headerEnd + twoCRLF.size();
+                    continue;
+                }
+                const size_t length = std::strtoul(buffer.c_str() + lengthPos + contentLength.size(), nullptr, 10);
+                const size_t bodyStart = headerEnd + twoCRLF.size();
+                if (buffer.size() - bodyStart < length)
+                {
+                    break;
+                }
+                json message = json::parse(buffer.begin() + static_cast<std::ptrdiff_t>(bodyStart),
+                                           buffer.begin() + static_cast<std::ptrdiff_t>(bodyStart + length), nullptr, false);
+                start = bodyStart + length;
+                if (message.is_discarded())
+                {
+                    continue;
+                }
+
+                const std::scoped_lock<std::mutex> lock(m_mutex);
+                m_received.push_back({std::move(message), time});
+                m_cv.notify_one();
+            }
+            buffer.erase(0, start);
+        }
+
+        const std::scoped_lock<std::mutex> lock(m_mutex);
+        m_eof = true;
+        m_cv.notify_one();
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Recorded to live values mapping and responses comparison.
+
+// Group of referenced values for field, empty string in case field is not a reference.
+const char *GetReferenceGroup(const std::string &key, const std::string &parentKey)
+{
+    static const std::unordered_map<std::string, const char *> keyGroups{
+        {"threadId", "thread"},          {"frameId", "frame"},   {"variablesReference", "variables"},
+        {"memoryReference", "memory"},   {"sourceReference", "source"}, {"moduleId", "module"}};
+    static const std::unordered_map<std::string, const char *> idGroups{
+        {"threads", "thread"},   {"stackFrames", "frame"}, {"breakpoints", "breakpoint"},
+        {"breakpoint", "breakpoint"}, {"modules", "module"},    {"module", "module"}};
+
+    const auto &groups = key == "id" ? idGroups : keyGroups;
+    const auto find = groups.find(key == "id" ? parentKey : key);
+    return find == groups.end() ? "" : find->second;
+}
+
+class Replay
+{
+  public:
+
+    explicit Replay(const Options &options)
+        : m_options(options)
+    {
+    }
+
+    bool Run(std::vector<LogRecord> &records, DebuggerProcess &debugger);
+    void PrintReport() const;
+
+  private:
+
+    struct CommandStats
+    {
+        std::vector<double> latencies; // milliseconds
+        std::vector<double> recordedLatencies; // milliseconds
+        size_t responsesWithDiffs{0};
+    };
+
+    struct PendingRequest
+    {
+        std::string command;
+        int64_t recordedSeq;
+        Clock::time_point sendTime;
+    };
+
+    const Options &m_options;
+    DebuggerProcess *m_debugger{nullptr};
+    std::map<std::string, CommandStats> m_stats;
+    // Reference group and recorded value to live value.
+    std::map<std::pair<std::string, std::string>, json> m_references;
+    // Recorded request `seq` to recorded response and its log index.
+    std::unordered_map<int64_t, std::pair<const LogRecord *, size_t>> m_recordedResponses;
+    // Recorded events by name, in log order.
+    std::unordered_map<std::string, std::vector<const LogRecord *>> m_recordedEvents;
+    std::unordered_map<std::string, size_t> m_liveEvents;
+    std::unordered_map<int64_t, PendingRequest> m_pending; // live `seq` to pending request
+    std::set<int64_t> m_answeredRecordedSeqs;
+    int64_t m_seq{1};
+    size_t m_timeouts{0};
+
+    void Compare(const json &recorded, const json &live, const std::string &path, const std::string &parentKey,
+                 std::vector<std::string> &diffs);
+    void MapReferences(json &value, const std::string &parentKey) const;
+    void ProcessReceived(const Received &received);
+    bool WaitFor(Clock::time_point deadline, const std::function<bool()> &condition);
+};
+
+void Replay::Compare(const json &recorded, const json &live, const std::string &path, const std::string &parentKey,
+                     std::vector<std::string> &diffs)
+{
+    auto AddDiff = [&](const std::string &text)
+    {
+        if (diffs.size() < maxDiffsPerResponse)
+        {
+            diffs.emplace_back(path + ": " + text);
+        }
+        else if (diffs.size() == maxDiffsPerResponse)
+        {
+            diffs.emplace_back("...");
+        }
+    };
+
+    if (recorded.type() != live.type())
+    {
+        AddDiff(recorded.dump() + " -> " + live.dump());
+        return;
+    }
+
+    if (recorded.is_object())
+    {
+        for (const auto &[key, value] : recorded.items())
+        {
+            if (key == "seq" || key == "request_seq")
+            {
+                continue;
+            }
+            const auto find = live.find(key);
+            if (find == live.end())
+            {
+                AddDiff("missing `" + key + "`");
+                continue;
+            }
+            const char *group = GetReferenceGroup(key, parentKey);
+            if (*group != '\0' && !value.is_structured())
+            {
+                m_references[{group, value.dump()}] = *find;
+                continue;
+            }
+            Compare(value, *find, path + "." + key, key, diffs);
+        }
+        for (const auto &[key, value] : live.items())
+        {
+            if (recorded.find(key) == recorded.end())
+            {
+                AddDiff("unexpected `" + key + "`");
+            }
+        }
+    }
+    else if (recorded.is_array())
+    {
+        if (recorded.size() != live.size())
+        {
+            AddDiff("array size " + std::to_string(recorded.size()) + " -> " + std::to_string(live.size()));
+        }
+        const size_t size = std::min(recorded.size(), live.size());
+        for (size_t i = 0; i < size; ++i)
+        {
+            Compare(recorded.at(i), live.at(i), path + "[" + std::to_string(i) + "]", parentKey, diffs);
+        }
+    }
+    else if (recorded != live)
+    {
+        AddDiff(recorded.dump() + " -> " + live.dump());
+    }
+}
+
+void Replay::MapReferences(json &value, const std::string &parentKey) const
+{
+    if (value.is_object())
+    {
+        for (auto &[key, member] : value.items())
+        {
+            const char *group = GetReferenceGroup(key, parentKey);
+            if (*group != '\0' && !member.is_structured())
+            {
+                const auto find = m_references.find({group, member.dump()});
+                if (find != m_references.end())
+                {
+                    member = find->second;
+                }
+                continue;
+            }
+            MapReferences(member, key);
+        }
+    }
+    else if (value.is_array())
+    {
+        for (auto &element : value)
+        {
+            MapReferences(element, parentKey);
+        }
+    }
+    else if (value.is_string())
+    {
+        for (const auto &[from, to] : m_options.pathMap)
+        {
+            const std::string &str = value.get_ref<const std::string &>();
+            if (str.compare(0, from.size(), from) == 0)
+            {
+                value = to + str.substr(from.size());
+                break;
+            }
+        }
+    }
+}
+
+void Replay::ProcessReceived(const Received &received)
+{
+    const json &message = received.message;
+    const std::string type = message.value("type", "");
+    if (type == "event")
+    {
+        const std::string event = message.value("event", "");
+        const size_t index = m_liveEvents[event]++;
+        const auto find = m_recordedEvents.find(event);
+        if (find != m_recordedEvents.end() && index < find->second.size())
+        {
+            // Events are used for references mapping only (content depends on debuggee timings).
+            std::vector<std::string> diffs;
+            Compare(find->second.at(index)->message, message, event, "", diffs);
+        }
+        return;
+    }
+    if (type != "response")
+    {
+        return;
+    }
+
+    const auto findPending = m_pending.find(message.value("request_seq", int64_t{0}));
+    if (findPending == m_pending.end())
+    {
+        return;
+    }
+    const PendingRequest request = std::move(findPending->second);
+    m_pending.erase(findPending);
+    m_answeredRecordedSeqs.insert(request.recordedSeq);
+
+    CommandStats &stats = m_stats[request.command];
+    stats.latencies.push_back(std::chrono::duration<double, std::milli>(received.time - request.sendTime).count());
+
+    const auto findRecorded = m_recordedResponses.find(request.recordedSeq);
+    if (findRecorded == m_recordedResponses.end())
+    {
+        return;
+    }
+    std::vector<std::string> diffs;
+    Compare(findRecorded->second.first->message, message, request.command, "", diffs);
+    if (diffs.empty())
+    {
+        return;
+    }
+    ++stats.responsesWithDiffs;
+    if (m_options.diff)
+    {
+        std::printf("diff %s (recorded seq %lld):\n", request.command.c_str(), static_cast<long long>(request.recordedSeq));
+        for (const auto &diff : diffs)
+        {
+            std::printf("    %s\n", diff.c_str());
+        }
+    }
+}
+
+bool Replay::WaitFor(Clock::time_point deadline, const std::function<bool()> &condition)
+{
+    Received received;
+    while (!condition())
+    {
+        if (!m_debugger->Receive(deadline, received))
+        {
+            return condition();
+        }
+        ProcessReceived(received);
+    }
+    return true;
+}
+
+bool Replay::Run(std::vector<LogRecord> &records, DebuggerProcess &debugger)
+{
+    m_debugger = &debugger;
+
+    for (size_t i = 0; i < records.size(); ++i)
+    {
+        const LogRecord &record = records.at(i);
+        if (record.kind == LogRecord::Kind::Response)
+        {
+            m_recordedResponses[record.message.value("request_seq", int64_t{0})] = {&record, i};
+        }
+        else if (record.kind == LogRecord::Kind::Event)
+        {
+            m_recordedEvents[record.message.value("event", "")].push_back(&record);
+        }
+    }
+
+    std::optional<double> startTime;
+    const Clock::time_point replayStart = Clock::now();
+    std::unordered_map<std::string, size_t> requiredEvents;
+    std::vector<int64_t> requiredResponses;
+    for (size_t i = 0; i < records.size(); ++i)
+    {
+        const LogRecord &record = records.at(i);
+        if (record.kind == LogRecord::Kind::Event)
+        {
+            ++requiredEvents[record.message.value("event", "")];
+            continue;
+        }
+        if (record.kind == LogRecord::Kind::Response)
+        {
+            requiredResponses.push_back(record.message.value("request_seq", int64_t{0}));
+            continue;
+        }
+
+        // All responses and events logged before this request must be received first.
+        const bool ready = WaitFor(Clock::now() + m_options.timeout, [&]()
+            {
+                for (const auto &[event, count] : requiredEvents)
+                {
+                    const auto find = m_liveEvents.find(event);
+                    if (find == m_liveEvents.end() || find->second < count)
+                    {
+                        return false;
+                    }
+                }
+                requiredResponses.erase(std::remove_if(requiredResponses.begin(), requiredResponses.end(),
+                                                       [&](int64_t seq) { return m_answeredRecordedSeqs.count(seq) != 0; }),
+                                        requiredResponses.end());
+                return requiredResponses.empty();
+            });
+        if (!ready)
+        {
+            ++m_timeouts;
+            if (debugger.IsExited())
+            {
+                std::fprintf(stderr, "Debugger exited\n");
+                return false;
+            }
+        }
+
+        if (m_options.originalPacing && record.time)
+        {
+            if (!startTime)
+            {
+                startTime = record.time;
+            }
+            const Clock::time_point sendTime = replayStart + std::chrono::duration_cast<Clock::duration>(
+                                                                 std::chrono::duration<double>(*record.time - *startTime));
+            WaitFor(sendTime, []() { return false; });
+        }
+
+        json request = record.message;
+        const std::string command = request.value("command", "");
+        const int64_t recordedSeq = request.value("seq", int64_t{0});
+        const auto arguments = request.find("arguments");
+        if (arguments != request.end())
+        {
+            MapReferences(*arguments, "");
+        }
+        request["seq"] = m_seq;
+        m_pending[m_seq] = {command, recordedSeq, Clock::now()};
+        ++m_seq;
+        if (!debugger.Send(request))
+        {
+            std::fprintf(stderr, "Failed to send `%s` request\n", command.c_str());
+            return false;
+        }
+
+        const auto findRecorded = m_recordedResponses.find(recordedSeq);
+        if (findRecorded != m_recordedResponses.end() && record.time && findRecorded->second.first->time)
+        {
+            m_stats[command].recordedLatencies.push_back((*findRecorded->second.first->time - *record.time) * 1000.0);
+        }
+    }
+
+    if (!WaitFor(Clock::now() + m_options.timeout, [&]() { return m_pending.empty(); }))
+    {
+        m_timeouts += m_pending.size();
+    }
+    return true;
+}
+
+double Percentile(std::vector<double> values, double percentile)
+{
+    if (values.empty())
+    {
+        return 0.0;
+    }
+    std::sort(values.begin(), values.end());
+    const auto index = static_cast<size_t>(percentile * static_cast<double>(values.size() - 1) + 0.5);
+    return values.at(std::min(index, values.size() - 1));
+}
+
+void Replay::PrintReport() const
+{
+    if (!m_options.json)
+    {
+        std::printf("%-28s %6s %10s %10s %10s %10s %10s %12s %6s\n", "command", "count", "min, ms", "p50, ms",
+                    "p90, ms", "p99, ms", "max, ms", "rec p50, ms", "diffs");
+    }
+    for (const auto &[command, stats] : m_stats)
+    {
+        if (stats.latencies.empty())
+        {
+            continue;
+        }
+        const double minLatency = Percentile(stats.latencies, 0.0);
+        const double p50 = Percentile(stats.latencies, 0.5);
+        const double p90 = Percentile(stats.latencies, 0.9);
+        const double p99 = Percentile(stats.latencies, 0.99);
+        const double maxLatency = Percentile(stats.latencies, 1.0);
+        const double recordedP50 = Percentile(stats.recordedLatencies, 0.5);
+        if (m_options.json)
+        {
+            std::printf("{\"command\":\"%s\",\"count\":%zu,\"min_ms\":%.3f,\"p50_ms\":%.3f,\"p90_ms\":%.3f,"
+                        "\"p99_ms\":%.3f,\"max_ms\":%.3f,\"recorded_p50_ms\":%.3f,\"diffs\":%zu}\n",
+                        command.c_str(), stats.latencies.size(), minLatency, p50, p90, p99, maxLatency, recordedP50,
+                        stats.responsesWithDiffs);
+        }
+        else
+        {
+            std::printf("%-28s %6zu %10.3f %10.3f %10.3f %10.3f %10.3f %12.3f %6zu\n", command.c_str(),
+                        stats.latencies.size(), minLatency, p50, p90, p99, maxLatency, recordedP50,
+                        stats.responsesWithDiffs);
+        }
+    }
+    if (m_timeouts != 0)
+    {
+        std::fprintf(stderr, "Timeouts: %zu\n", m_timeouts);
+    }
+}
+
+bool ParseOptions(int argc, char *argv[], Options &options)
+{
+    int i = 1;
+    for (; i < argc; ++i)
+    {
+        const std::string arg(argv[i]);
+        std::string map;
+        if (arg == "--original-pacing")
+        {
+            options.originalPacing = true;
+        }
+        else if (arg == "--diff")
+        {
+            options.diff = true;
+        }
+        else if (arg == "--json")
+        {
+            options.json = true;
+        }
+        else if (ParseOption(arg, "--map=", map))
+        {
+            const size_t delim = map.find('=');
+            if (delim == std::string::npos)
+            {
+                return false;
+            }
+            options.pathMap.emplace_back(map.substr(0, delim), map.substr(delim + 1));
+        }
+        else if (!ParseOption(arg, "--timeout=", options.timeout))
+        {
+            break;
+        }
+    }
+
+    if (argc - i < 2)
+    {
+        return false;
+    }
+    options.logPath = argv[i];
+    options.debuggerArgs.assign(argv + i + 1, argv + argc);
+    return true;
+}
+
+} // unnamed namespace
+
+int main(int argc, char *argv[])
+{
+    Options options;
+    if (!ParseOptions(argc, argv, options))
+    {
+        std::fprintf(stderr, "Usage: %s [--original-pacing] [--timeout=<milliseconds>] [--map=<from>=<to>] [--diff] "
+                             "[--json] <protocol log> <debugger path> [debugger arguments]...\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    std::vector<LogRecord> records;
+    if (!ReadLog(options.logPath, records))
+    {
+        return EXIT_FAILURE;
+    }
+    if (options.originalPacing &&
+        std::any_of(records.begin(), records.end(), [](const LogRecord &record) { return !record.time; }))
+    {
+        std::fprintf(stderr, "%s: protocol log records have no time, original pacing is not possible\n",
+                     options.logPath.c_str());
+        return EXIT_FAILURE;
+    }
+
+    std::signal(SIGPIPE, SIG_IGN);
+    DebuggerProcess debugger;
+    if (!debugger.Start(options.debuggerArgs))
+    {
+        std::fprintf(stderr, "%s: can't start debugger\n", options.debuggerArgs.front().c_str());
+        return EXIT_FAILURE;
+    }
+
+    Replay replay(options);
+    const bool result = replay.Run(records, debugger);
+    debugger.Stop();
+    replay.PrintReport();
+
+    return result ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,57 @@
+// Copyright (c) 2026 Mikhail Kurinnoi
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+// String value escaping microbenchmark (see `EscapeString()`).
+//
+// Usage: escape_benchmark [milliseconds per case, 200 by default]
+
+#include "benchmark_utils.h"
+#include "utils/print.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+using namespace benchmark;
+
+struct Dataset
+{
+    const char *name;
+    std::string text;
+};
+
+std::vector<Dataset> CreateDatasets()
+{
+    static constexpr size_t longSize = 4 * 1024 * 1024;
+    return {
+        {"short", "System.Collections.Generic.List`1"},
+        {"plain-4M", Repeat("The quick brown fox jumps over the lazy dog. ", longSize)},
+        {"json-4M", Repeat("{\"id\": 42, \"name\": \"value\", \"tags\": [\"a\", \"b\"]},\n", longSize)},
+        {"paths-4M", Repeat("C:\\Users\\user\\source\\repos\\Project\\bin\\Debug\\net8.0\\", longSize)},
+        {"escapes-4M", Repeat("\"\\\n\t", longSize)},
+    };
+}
+
+} // unnamed namespace
+
+int main(int argc, char *argv[])
+{
+    static constexpr long defaultDuration = 200;
+    const std::chrono::milliseconds duration(argc > 1 ? std::strtol(argv[1], nullptr, 10) : defaultDuration);
+
+    volatile size_t sink = 0;
+    std::printf("%-16s %14s %12s\n", "dataset", "ns/op", "MB/s");
+    for (const auto &dataset : CreateDatasets())
+    {
+        const double mb = static_cast<double>(dataset.text.size()) / (1024.0 * 1024.0);
+        const double time = Measure(duration, [&]() { sink = sink + dncdbg::EscapeString(dataset.text, '"').size(); });
+        std::printf("%-16s %14.1f %12.1f\n", dataset.name, time, mb / (time / 1e9));
+    }
+
+    return sink == 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
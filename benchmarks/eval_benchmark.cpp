@@ -0,0 +1,1324 @@
+// Copyright (c) 2026 Mikhail Kurinnoi
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+// Expression evaluation microbenchmark (see `Parser::GenerateProgram()` and `EvalStackMachine`), runs without runtime.
+// Each expression goes through stages:
+//   parse    - tree-sitter C# parse only (same source wrapping as `GenerateProgram()`);
+//   generate - stack machine program generation (`GenerateProgram()`, parse included);
+//   evaluate - `EvalStackMachine::EvaluateExpression()` call (program generation included), values are provided by
+//              mock backend instead of debuggee (see "Mock values backend" part below).
+// Allocations (count and bytes) are measured for single run of each stage by `AllocationProfile` (benchmark is
+// always built with `ALLOCATION_PROFILE`), tree-sitter allocations are counted by tree-sitter allocator.
+//
+// Mock values backend replaces runtime and metadata dependent parts at link time: ICorDebug values, function
+// evaluation (`EvalWaiter`), identifiers resolve and methods walk (`Evaluator`), type names (`TypePrinter`).
+// Stack machine, primitive types operations, `EvalHelpers` and value helpers are real debugger code.
+//
+// Usage: eval_benchmark [--json] [--time=<milliseconds per case, 200 by default>] [--corpus=<file>]...
+//
+// Corpus file contains one expression per line, empty lines and lines started with `#` are ignored, file name
+// is used as category. Built-in corpus (conditions, logpoint holes and watches) is used if no corpus provided.
+// Note, identifiers and methods are resolved by mock backend tables, see `mockVariables` and `mockMethods`.
+
+#include "benchmark_utils.h"
+#include "debugger/evalhelpers.h"
+#include "debugger/evalstackmachine.h"
+#include "debugger/evaluator.h"
+#include "debugger/evalwaiter.h"
+#include "expressionparser/parser.h"
+#include "metadata/attributes.h"
+#include "metadata/modules.h"
+#include "metadata/typeprinter.h"
+#include "utils/allocationprofile.h"
+#include "utils/hresult.h"
+#include "utils/torelease.h"
+#include "utils/utf.h"
+#include <tree_sitter/api.h>
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+extern "C" const TSLanguage *tree_sitter_c_sharp();
+
+namespace
+{
+
+using namespace benchmark;
+using namespace dncdbg;
+
+////////////////////////////////////////////////////////////////////////////////
+// Mock values backend.
+
+size_t GetPrimitiveSize(CorElementType elemType)
+{
+    switch (elemType)
+    {
+    case ELEMENT_TYPE_BOOLEAN:
+    case ELEMENT_TYPE_I1:
+    case ELEMENT_TYPE_U1:
+        return 1;
+    case ELEMENT_TYPE_CHAR:
+    case ELEMENT_TYPE_I2:
+    case ELEMENT_TYPE_U2:
+        return 2;
+    case ELEMENT_TYPE_I4:
+    case ELEMENT_TYPE_U4:
+    case ELEMENT_TYPE_R4:
+        return 4;
+    default:
+        return 8;
+    }
+}
+
+class MockType final : public ICorDebugType
+{
+  public:
+
+    MockType(CorElementType elemType, std::string typeName)
+        : m_elemType(elemType),
+          m_typeName(std::move(typeName))
+    {
+    }
+
+    [[nodiscard]] const std::string &GetTypeName() const
+    {
+        return m_typeName;
+    }
+
+    HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void **ppInterface) override
+    {
+        if (riid != IID_ICorDebugType) // NOLINT(readability-implicit-bool-conversion)
+        {
+            *ppInterface = nullptr;
+            return E_NOINTERFACE;
+        }
+        *ppInterface = static_cast<ICorDebugType *>(this);
+        AddRef();
+        return S_OK;
+    }
+    ULONG STDMETHODCALLTYPE AddRef() override
+    {
+        return ++m_refCount;
+    }
+    ULONG STDMETHODCALLTYPE Release() override
+    {
+        const ULONG refCount = --m_refCount;
+        if (refCount == 0)
+        {
+            delete this;
+        }
+        return refCount;
+    }
+
+    HRESULT STDMETHODCALLTYPE GetType(CorElementType *ty) override
+    {
+        *ty = m_elemType;
+        return S_OK;
+    }
+    HRESULT STDMETHODCALLTYPE GetClass(ICorDebugClass ** /*ppClass*/) override { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE EnumerateTypeParameters(ICorDebugTypeEnum ** /*ppTyParEnum*/) override { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE GetFirstTypeParameter(ICorDebugType ** /*value*/) override { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE GetBase(ICorDebugType ** /*pBase*/) override { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE GetStaticFieldValue(mdFieldDef /*fieldDef*/, ICorDebugFrame * /*pFrame*/, ICorDebugValue ** /*ppValue*/) override { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE GetRank(ULONG32 * /*pnRank*/) override { return E_NOTIMPL; }
+
+  private:
+
+    ULONG m_refCount{1};
+    CorElementType m_elemType;
+    std::string m_typeName;
+};
+
+// Primitive value, reference (null in case no target), string object or class/array/value type object.
+class MockValue final : public ICorDebugGenericValue,
+                        public ICorDebugReferenceValue,
+                        public ICorDebugStringValue,
+                        public ICorDebugValue2
+{
+  public:
+
+    enum class Kind : uint8_t
+    {
+        Primitive,
+        Reference,
+        String,
+        Object
+    };
+
+    MockValue(Kind kind, CorElementType elemType, std::string typeName)
+        : m_kind(kind),
+          m_elemType(elemType),
+          m_typeName(std::move(typeName))
+    {
+    }
+
+    static MockValue *CreatePrimitive(CorElementType elemType, const void *data)
+    {
+        auto *value = new MockValue(Kind::Primitive, elemType, "");
+        value->m_data.resize(GetPrimitiveSize(elemType), 0);
+        if (data != nullptr)
+        {
+            std::memcpy(value->m_data.data(), data, value->m_data.size());
+        }
+        return value;
+    }
+
+    static MockValue *CreateString(const WSTRING &text)
+    {
+        auto *object = new MockValue(Kind::String, ELEMENT_TYPE_STRING, "System.String");
+        object->m_string = text;
+        return CreateReference(object, ELEMENT_TYPE_STRING, object->m_typeName);
+    }
+
+    // Class instance, array (element type name for `typeName`) or boxed value type, `data` is value type data.
+    static MockValue *CreateObject(CorElementType elemType, const std::string &typeName, size_t dataSize = 0)
+    {
+        auto *object = new MockValue(Kind::Object, elemType, typeName);
+        object->m_data.resize(dataSize, 0);
+        return CreateReference(object, elemType == ELEMENT_TYPE_VALUETYPE ? ELEMENT_TYPE_CLASS : elemType, typeName);
+    }
+
+    static MockValue *CreateNull(const std::string &typeName)
+    {
+        return CreateReference(nullptr, ELEMENT_TYPE_CLASS, typeName);
+    }
+
+    HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void **ppInterface) override
+    {
+        // NOLINTBEGIN(readability-implicit-bool-conversion)
+        if (riid == IID_ICorDebugValue)
+        {
+            *ppInterface = static_cast<ICorDebugValue *>(static_cast<ICorDebugGenericValue *>(this));
+        }
+        else if (riid == IID_ICorDebugValue2)
+        {
+            *ppInterface = static_cast<ICorDebugValue2 *>(this);
+        }
+        else if (riid == IID_ICorDebugGenericValue && !m_data.empty())
+        {
+            *ppInterface = static_cast<ICorDebugGenericValue *>(this);
+        }
+        else if (riid == IID_ICorDebugReferenceValue && m_kind == Kind::Reference)
+        {
+            *ppInterface = static_cast<ICorDebugReferenceValue *>(this);
+        }
+        else if ((riid == IID_ICorDebugStringValue || riid == IID_ICorDebugHeapValue) && m_kind == Kind::String)
+        {
+            *ppInterface = static_cast<ICorDebugStringValue *>(this);
+        }
+        else
+        {
+            *ppInterface = nullptr;
+            return E_NOINTERFACE;
+        }
+        // NOLINTEND(readability-implicit-bool-conversion)
+        AddRef();
+        return S_OK;
+    }
+    ULONG STDMETHODCALLTYPE AddRef() override
+    {
+        return ++m_refCount;
+    }
+    ULONG STDMETHODCALLTYPE Release() override
+    {
+        const ULONG refCount = --m_refCount;
+        if (refCount == 0)
+        {
+            delete this;
+        }
+        return refCount;
+    }
+
+    // ICorDebugValue
+
+    HRESULT STDMETHODCALLTYPE GetType(CorElementType *pType) override
+    {
+        *pType = m_elemType;
+        return S_OK;
+    }
+    HRESULT STDMETHODCALLTYPE GetSize(ULONG32 *pSize) override
+    {
+        *pSize = m_kind == Kind::Reference ? sizeof(void *)
+                 : m_kind == Kind::String  ? static_cast<ULONG32>(m_string.size() * sizeof(WCHAR))
+                                           : static_cast<ULONG32>(m_data.size());
+        return S_OK;
+    }
+    HRESULT STDMETHODCALLTYPE GetAddress(CORDB_ADDRESS *pAddress) override
+    {
+        *pAddress = reinterpret_cast<CORDB_ADDRESS>(this);
+        return S_OK;
+    }
+    HRESULT STDMETHODCALLTYPE CreateBreakpoint(ICorDebugValueBreakpoint ** /*ppBreakpoint*/) override { return E_NOTIMPL; }
+
+    // ICorDebugGenericValue
+
+    HRESULT STDMETHODCALLTYPE GetValue(void *pTo) override
+    {
+        std::memcpy(pTo, m_data.data(), m_data.size());
+        return S_OK;
+    }
+    HRESULT STDMETHODCALLTYPE SetValue(void *pFrom) override
+    {
+        std::memcpy(m_data.data(), pFrom, m_data.size());
+        return S_OK;
+    }
+
+    // ICorDebugReferenceValue
+
+    HRESULT STDMETHODCALLTYPE IsNull(BOOL *pbNull) override
+    {
+        *pbNull = m_target == nullptr ? TRUE : FALSE;
+        return S_OK;
+    }
+    HRESULT STDMETHODCALLTYPE GetValue(CORDB_ADDRESS *pValue) override
+    {
+        *pValue = reinterpret_cast<CORDB_ADDRESS>(m_target.GetPtr());
+        return S_OK;
+    }
+    HRESULT STDMETHODCALLTYPE SetValue(CORDB_ADDRESS /*value*/) override { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE Dereference(ICorDebugValue **ppValue) override
+    {
+        if (m_target == nullptr)
+        {
+            return CORDBG_E_BAD_REFERENCE_VALUE;
+        }
+        m_target->AddRef();
+        *ppValue = m_target.GetPtr();
+        return S_OK;
+    }
+    HRESULT STDMETHODCALLTYPE DereferenceStrong(ICorDebugValue **ppValue) override
+    {
+        return Dereference(ppValue);
+    }
+
+    // ICorDebugHeapValue, ICorDebugStringValue
+
+    HRESULT STDMETHODCALLTYPE IsValid(BOOL *pbValid) override
+    {
+        *pbValid = TRUE;
+        return S_OK;
+    }
+    HRESULT STDMETHODCALLTYPE CreateRelocBreakpoint(ICorDebugValueBreakpoint ** /*ppBreakpoint*/) override { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE GetLength(ULONG32 *pcchString) override
+    {
+        *pcchString = static_cast<ULONG32>(m_string.size());
+        return S_OK;
+    }
+    HRESULT STDMETHODCALLTYPE GetString(ULONG32 cchString, ULONG32 *pcchString, WCHAR szString[]) override
+    {
+        const size_t size = std::min(static_cast<size_t>(cchString), m_string.size());
+        std::copy_n(m_string.begin(), size, szString);
+        *pcchString = static_cast<ULONG32>(size);
+        return S_OK;
+    }
+
+    // ICorDebugValue2
+
+    HRESULT STDMETHODCALLTYPE GetExactType(ICorDebugType **ppType) override
+    {
+        *ppType = new MockType(m_elemType, m_typeName);
+        return S_OK;
+    }
+
+  private:
+
+    ULONG m_refCount{1};
+    Kind m_kind;
+    CorElementType m_elemType;
+    // Class, value type or array element type name.
+    std::string m_typeName;
+    // Primitive or value type data.
+    std::vector<uint8_t> m_data;
+    WSTRING m_string;
+    ToRelease<ICorDebugValue> m_target;
+
+    static MockValue *CreateReference(MockValue *target, CorElementType elemType, const std::string &typeName)
+    {
+        auto *reference = new MockValue(Kind::Reference, elemType, typeName);
+        reference->m_target = static_cast<ICorDebugValue *>(static_cast<ICorDebugGenericValue *>(target));
+        return reference;
+    }
+};
+
+ICorDebugValue *ToValue(MockValue *value)
+{
+    return static_cast<ICorDebugValue *>(static_cast<ICorDebugGenericValue *>(value));
+}
+
+// Local variables and members of any object (resolved by name only).
+struct MockVariable
+{
+    CorElementType elemType;
+    // Class name (for class instance and null), array element type name or string value.
+    const char *typeName;
+    int64_t value; // Primitive value, `0` for null reference in case of class.
+};
+
+const std::unordered_map<std::string, MockVariable> mockVariables{
+    {"this", {ELEMENT_TYPE_CLASS, "Program", 1}},
+    {"i", {ELEMENT_TYPE_I4, "", 5}},
+    {"j", {ELEMENT_TYPE_I4, "", 2}},
+    {"a", {ELEMENT_TYPE_I4, "", 7}},
+    {"b", {ELEMENT_TYPE_I4, "", 3}},
+    {"x", {ELEMENT_TYPE_I4, "", 3}},
+    {"y", {ELEMENT_TYPE_I4, "", 4}},
+    {"radius", {ELEMENT_TYPE_I4, "", 5}},
+    {"count", {ELEMENT_TYPE_I4, "", 12}},
+    {"retries", {ELEMENT_TYPE_I4, "", 1}},
+    {"flags", {ELEMENT_TYPE_I4, "", 6}},
+    {"index", {ELEMENT_TYPE_I4, "", 1}},
+    {"offset", {ELEMENT_TYPE_I4, "", 10}},
+    {"state", {ELEMENT_TYPE_I4, "", 2}},
+    {"done", {ELEMENT_TYPE_BOOLEAN, "", 0}},
+    {"name", {ELEMENT_TYPE_STRING, "Main", 0}},
+    {"first", {ELEMENT_TYPE_STRING, "John", 0}},
+    {"last", {ELEMENT_TYPE_STRING, "Doe", 0}},
+    {"text", {ELEMENT_TYPE_STRING, "Hello, World", 0}},
+    {"item", {ELEMENT_TYPE_CLASS, "Item", 1}},
+    {"value", {ELEMENT_TYPE_CLASS, "Item", 0}},
+    {"defaultValue", {ELEMENT_TYPE_CLASS, "Item", 1}},
+    {"request", {ELEMENT_TYPE_CLASS, "Request", 1}},
+    {"response", {ELEMENT_TYPE_CLASS, "Response", 1}},
+    {"buffer", {ELEMENT_TYPE_CLASS, "Buffer", 1}},
+    {"user", {ELEMENT_TYPE_CLASS, "User", 1}},
+    {"elapsed", {ELEMENT_TYPE_CLASS, "TimeSpan", 1}},
+    {"order", {ELEMENT_TYPE_CLASS, "Order", 1}},
+    {"list", {ELEMENT_TYPE_CLASS, "List", 1}},
+    {"items", {ELEMENT_TYPE_CLASS, "List", 1}},
+    {"orders", {ELEMENT_TYPE_CLASS, "List", 1}},
+    {"names", {ELEMENT_TYPE_CLASS, "List", 1}},
+    {"customers", {ELEMENT_TYPE_CLASS, "List", 1}},
+    {"dict", {ELEMENT_TYPE_CLASS, "Dictionary", 1}},
+    {"args", {ELEMENT_TYPE_SZARRAY, "System.String", 1}},
+    {"matrix", {ELEMENT_TYPE_ARRAY, "System.Int32", 1}},
+    // Members.
+    {"Id", {ELEMENT_TYPE_I4, "", 300}},
+    {"Age", {ELEMENT_TYPE_I4, "", 30}},
+    {"Count", {ELEMENT_TYPE_I4, "", 2}},
+    {"Length", {ELEMENT_TYPE_I4, "", 12}},
+    {"Quantity", {ELEMENT_TYPE_I4, "", 4}},
+    {"StatusCode", {ELEMENT_TYPE_I4, "", 200}},
+    {"Price", {ELEMENT_TYPE_I4, "", 25}},
+    {"Total", {ELEMENT_TYPE_I4, "", 100}},
+    {"TotalMilliseconds", {ELEMENT_TYPE_I4, "", 1500}},
+    {"Name", {ELEMENT_TYPE_STRING, "Alice", 0}},
+    {"City", {ELEMENT_TYPE_STRING, "Paris", 0}},
+    {"Path", {ELEMENT_TYPE_STRING, "/index.html", 0}},
+    {"Headers", {ELEMENT_TYPE_CLASS, "Headers", 1}},
+    {"Address", {ELEMENT_TYPE_CLASS, "Address", 1}},
+    {"Orders", {ELEMENT_TYPE_CLASS, "List", 1}},
+    {"Lines", {ELEMENT_TYPE_SZARRAY, "Line", 1}}};
+
+ICorDebugValue *CreateMockValue(CorElementType elemType, const std::string &typeName, int64_t value)
+{
+    switch (elemType)
+    {
+    case ELEMENT_TYPE_STRING:
+        return ToValue(MockValue::CreateString(to_utf16(typeName)));
+    case ELEMENT_TYPE_CLASS:
+        return ToValue(value == 0 ? MockValue::CreateNull(typeName) : MockValue::CreateObject(elemType, typeName));
+    case ELEMENT_TYPE_SZARRAY:
+    case ELEMENT_TYPE_ARRAY:
+        return ToValue(MockValue::CreateObject(elemType, typeName));
+    case ELEMENT_TYPE_VALUETYPE:
+        return ToValue(MockValue::CreateObject(elemType, typeName, sizeof(int64_t) * 2));
+    default:
+        return ToValue(MockValue::CreatePrimitive(elemType, &value));
+    }
+}
+
+HRESULT GetMockVariable(const std::string &name, ICorDebugValue **ppValue)
+{
+    auto find = mockVariables.find(name);
+    if (find == mockVariables.end())
+    {
+        return E_FAIL;
+    }
+    *ppValue = CreateMockValue(find->second.elemType, find->second.typeName, find->second.value);
+    return S_OK;
+}
+
+// Type name, that have static members accessible from expressions.
+const std::unordered_map<std::string, std::string> mockStaticTypes{
+    {"System.String", "System.String"},
+    {"System.Math", "System.Math"},
+    {"Enumerable", "System.Linq.Enumerable"}};
+
+struct MockMethod
+{
+    // Type name, empty for methods of any class and extension methods.
+    std::string typeName;
+    bool isStatic;
+    bool isExtension;
+    std::string name;
+    std::vector<SigElementType> args;
+    SigElementType ret;
+};
+
+const SigElementType mockInt{ELEMENT_TYPE_I4, ""};
+const SigElementType mockBool{ELEMENT_TYPE_BOOLEAN, ""};
+const SigElementType mockString{ELEMENT_TYPE_STRING, ""};
+const SigElementType mockDecimal{ELEMENT_TYPE_VALUETYPE, "System.Decimal"};
+
+const std::vector<MockMethod> mockMethods{
+    {"", false, false, "ToString", {}, mockString},
+    {"", false, false, "Contains", {mockString}, mockBool},
+    {"", false, false, "get_Item", {mockString}, {ELEMENT_TYPE_CLASS, "Item"}},
+    {"", true, true, "Count", {}, mockInt},
+    {"", true, true, "Sum", {}, mockInt},
+    {"", true, true, "First", {}, {ELEMENT_TYPE_CLASS, "Customer"}},
+    {"", true, true, "Last", {}, {ELEMENT_TYPE_CLASS, "Order"}},
+    {"System.String", false, false, "Substring", {mockInt, mockInt}, mockString},
+    {"System.String", false, false, "ToUpper", {}, mockString},
+    {"System.String", true, false, "Concat", {mockString, mockString, mockString}, mockString},
+    {"System.Math", true, false, "Max", {mockInt, mockInt}, mockInt},
+    {"System.Math", true, false, "Min", {mockInt, mockInt}, mockInt},
+    {"System.Linq.Enumerable", true, false, "Range", {mockInt, mockInt}, {ELEMENT_TYPE_CLASS, "RangeIterator"}},
+    {"System.Decimal", true, false, "op_Addition", {mockDecimal, mockDecimal}, mockDecimal},
+    {"System.Decimal", true, false, "op_Division", {mockDecimal, mockDecimal}, mockDecimal}};
+
+class MockFunction final : public ICorDebugFunction
+{
+  public:
+
+    explicit MockFunction(const MockMethod &method)
+        : m_method(method)
+    {
+    }
+
+    // Result depends on method return type and arguments count only.
+    ICorDebugValue *Call(ULONG32 nArgs)
+    {
+        if (m_method.ret.corType == ELEMENT_TYPE_STRING)
+        {
+            return CreateMockValue(ELEMENT_TYPE_STRING, m_method.name, 0);
+        }
+        return CreateMockValue(m_method.ret.corType, m_method.ret.typeName, nArgs + 1);
+    }
+
+    HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void **ppInterface) override
+    {
+        if (riid != IID_ICorDebugFunction) // NOLINT(readability-implicit-bool-conversion)
+        {
+            *ppInterface = nullptr;
+            return E_NOINTERFACE;
+        }
+        *ppInterface = static_cast<ICorDebugFunction *>(this);
+        AddRef();
+        return S_OK;
+    }
+    ULONG STDMETHODCALLTYPE AddRef() override
+    {
+        return ++m_refCount;
+    }
+    ULONG STDMETHODCALLTYPE Release() override
+    {
+        const ULONG refCount = --m_refCount;
+        if (refCount == 0)
+        {
+            delete this;
+        }
+        return refCount;
+    }
+
+    HRESULT STDMETHODCALLTYPE GetModule(ICorDebugModule ** /*ppModule*/) override { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE GetClass(ICorDebugClass ** /*ppClass*/) override { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE GetToken(mdMethodDef * /*pMethodDef*/) override { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE GetILCode(ICorDebugCode ** /*ppCode*/) override { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE GetNativeCode(ICorDebugCode ** /*ppCode*/) override { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE CreateBreakpoint(ICorDebugFunctionBreakpoint ** /*ppBreakpoint*/) override { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE GetLocalVarSigToken(mdSignature * /*pmdSig*/) override { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE GetCurrentVersionNumber(ULONG32 * /*pnCurrentVersion*/) override { return E_NOTIMPL; }
+
+  private:
+
+    ULONG m_refCount{1};
+    const MockMethod &m_method;
+};
+
+// Function evaluation, completed right at setup call.
+class MockEval final : public ICorDebugEval, public ICorDebugEval2
+{
+  public:
+
+    HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void **ppInterface) override
+    {
+        // NOLINTBEGIN(readability-implicit-bool-conversion)
+        if (riid == IID_ICorDebugEval)
+        {
+            *ppInterface = static_cast<ICorDebugEval *>(this);
+        }
+        else if (riid == IID_ICorDebugEval2)
+        {
+            *ppInterface = static_cast<ICorDebugEval2 *>(this);
+        }
+        else
+        {
+            *ppInterface = nullptr;
+            return E_NOINTERFACE;
+        }
+        // NOLINTEND(readability-implicit-bool-conversion)
+        AddRef();
+        return S_OK;
+    }
+    ULONG STDMETHODCALLTYPE AddRef() override
+    {
+        return ++m_refCount;
+    }
+    ULONG STDMETHODCALLTYPE Release() override
+    {
+        const ULONG refCount = --m_refCount;
+        if (refCount == 0)
+        {
+            delete this;
+        }
+        return refCount;
+    }
+
+    // ICorDebugEval
+
+    HRESULT STDMETHODCALLTYPE CallFunction(ICorDebugFunction *pFunction, ULONG32 nArgs, ICorDebugValue *ppArgs[]) override
+    {
+        return CallParameterizedFunction(pFunction, 0, nullptr, nArgs, ppArgs);
+    }
+    HRESULT STDMETHODCALLTYPE NewObject(ICorDebugFunction * /*pConstructor*/, ULONG32 /*nArgs*/, ICorDebugValue * /*ppArgs*/[]) override { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE NewObjectNoConstructor(ICorDebugClass * /*pClass*/) override { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE NewString(LPCWSTR string) override
+    {
+        m_trResult = ToValue(MockValue::CreateString(string));
+        return S_OK;
+    }
+    HRESULT STDMETHODCALLTYPE NewArray(CorElementType /*elementType*/, ICorDebugClass * /*pElementClass*/, ULONG32 /*rank*/,
+                                       ULONG32 /*dims*/[], ULONG32 /*lowBounds*/[]) override { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE IsActive(BOOL *pbActive) override
+    {
+        *pbActive = FALSE;
+        return S_OK;
+    }
+    HRESULT STDMETHODCALLTYPE Abort() override { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE GetResult(ICorDebugValue **ppResult) override
+    {
+        if (m_trResult == nullptr)
+        {
+            return CORDBG_S_FUNC_EVAL_HAS_NO_RESULT;
+        }
+        m_trResult->AddRef();
+        *ppResult = m_trResult.GetPtr();
+        return S_OK;
+    }
+    HRESULT STDMETHODCALLTYPE GetThread(ICorDebugThread ** /*ppThread*/) override { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE CreateValue(CorElementType elementType, ICorDebugClass * /*pElementClass*/, ICorDebugValue **ppValue) override
+    {
+        *ppValue = elementType == ELEMENT_TYPE_CLASS ? ToValue(MockValue::CreateNull("System.Object"))
+                                                     : ToValue(MockValue::CreatePrimitive(elementType, nullptr));
+        return S_OK;
+    }
+
+    // ICorDebugEval2
+
+    HRESULT STDMETHODCALLTYPE CallParameterizedFunction(ICorDebugFunction *pFunction, ULONG32 /*nTypeArgs*/, ICorDebugType * /*ppTypeArgs*/[],
+                                                        ULONG32 nArgs, ICorDebugValue * /*ppArgs*/[]) override
+    {
+        m_trResult = static_cast<MockFunction *>(pFunction)->Call(nArgs);
+        return S_OK;
+    }
+    HRESULT STDMETHODCALLTYPE CreateValueForType(ICorDebugType * /*pType*/, ICorDebugValue ** /*ppValue*/) override { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE NewParameterizedObject(ICorDebugFunction * /*pConstructor*/, ULONG32 /*nTypeArgs*/, ICorDebugType * /*ppTypeArgs*/[],
+                                                     ULONG32 /*nArgs*/, ICorDebugValue * /*ppArgs*/[]) override { return E_NOTIMPL; }
+    // Note, used for decimal values creation only (class is not provided, since runtime is not available).
+    HRESULT STDMETHODCALLTYPE NewParameterizedObjectNoConstructor(ICorDebugClass * /*pClass*/, ULONG32 /*nTypeArgs*/, ICorDebugType * /*ppTypeArgs*/[]) override
+    {
+        m_trResult = CreateMockValue(ELEMENT_TYPE_VALUETYPE, "System.Decimal", 0);
+        return S_OK;
+    }
+    HRESULT STDMETHODCALLTYPE NewParameterizedArray(ICorDebugType * /*pElementType*/, ULONG32 /*rank*/, ULONG32 /*dims*/[], ULONG32 /*lowBounds*/[]) override { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE NewStringWithLength(LPCWSTR string, UINT uiLength) override
+    {
+        m_trResult = ToValue(MockValue::CreateString(WSTRING(string, uiLength)));
+        return S_OK;
+    }
+    HRESULT STDMETHODCALLTYPE RudeAbort() override { return E_NOTIMPL; }
+
+  private:
+
+    ULONG m_refCount{1};
+    ToRelease<ICorDebugValue> m_trResult;
+};
+
+class MockThread final : public ICorDebugThread
+{
+  public:
+
+    HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void **ppInterface) override
+    {
+        if (riid != IID_ICorDebugThread) // NOLINT(readability-implicit-bool-conversion)
+        {
+            *ppInterface = nullptr;
+            return E_NOINTERFACE;
+        }
+        *ppInterface = static_cast<ICorDebugThread *>(this);
+        AddRef();
+        return S_OK;
+    }
+    // Note, thread object is owned by benchmark, only references counting is used.
+    ULONG STDMETHODCALLTYPE AddRef() override
+    {
+        return ++m_refCount;
+    }
+    ULONG STDMETHODCALLTYPE Release() override
+    {
+        return --m_refCount;
+    }
+
+    HRESULT STDMETHODCALLTYPE GetProcess(ICorDebugProcess ** /*ppProcess*/) override { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE GetID(DWORD *pdwThreadId) override
+    {
+        *pdwThreadId = 1;
+        return S_OK;
+    }
+    HRESULT STDMETHODCALLTYPE GetHandle(HTHREAD * /*phThreadHandle*/) override { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE GetAppDomain(ICorDebugAppDomain ** /*ppAppDomain*/) override { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE SetDebugState(CorDebugThreadState /*state*/) override { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE GetDebugState(CorDebugThreadState * /*pState*/) override { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE GetUserState(CorDebugUserState * /*pState*/) override { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE GetCurrentException(ICorDebugValue ** /*ppExceptionObject*/) override { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE ClearCurrentException() override { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE CreateStepper(ICorDebugStepper ** /*ppStepper*/) override { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE EnumerateChains(ICorDebugChainEnum ** /*ppChains*/) override { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE GetActiveChain(ICorDebugChain ** /*ppChain*/) override { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE GetActiveFrame(ICorDebugFrame ** /*ppFrame*/) override { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE GetRegisterSet(ICorDebugRegisterSet ** /*ppRegisters*/) override { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE CreateEval(ICorDebugEval **ppEval) override
+    {
+        *ppEval = new MockEval();
+        return S_OK;
+    }
+    HRESULT STDMETHODCALLTYPE GetObject(ICorDebugValue ** /*ppObject*/) override { return E_NOTIMPL; }
+
+  private:
+
+    ULONG m_refCount{0};
+};
+
+const std::string &GetMockTypeName(ICorDebugType *pType)
+{
+    return static_cast<MockType *>(pType)->GetTypeName();
+}
+
+} // unnamed namespace
+
+// Debugger parts replaced by mock values backend.
+namespace dncdbg
+{
+
+HRESULT EvalWaiter::WaitEvalResult(ICorDebugThread *pThread, ICorDebugValue **ppEvalResult,
+                                   const WaitEvalResultCallback &cbSetupEval)
+{
+    HRESULT Status = S_OK;
+    ToRelease<ICorDebugEval> trEval;
+    IfFailRet(pThread->CreateEval(&trEval));
+    IfFailRet(cbSetupEval(trEval));
+    ToRelease<ICorDebugValue> trResult;
+    IfFailRet(trEval->GetResult(&trResult));
+    if (ppEvalResult != nullptr)
+    {
+        *ppEvalResult = trResult.Detach();
+    }
+    return Status;
+}
+
+HRESULT Evaluator::ResolveIdentifiers(ICorDebugThread * /*pThread*/, FrameLevel /*frameLevel*/, ICorDebugValue *pInputValue,
+                                      SetterData * /*inputSetterData*/, std::vector<std::string> &identifiers,
+                                      ICorDebugValue **ppResultValue, std::unique_ptr<SetterData> * /*resultSetterData*/,
+                                      ICorDebugType **ppResultType)
+{
+    HRESULT Status = S_OK;
+    ToRelease<ICorDebugValue> trValue;
+    size_t nextIdentifier = 0;
+    if (pInputValue != nullptr)
+    {
+        pInputValue->AddRef();
+        trValue = pInputValue;
+    }
+    else
+    {
+        if (ppResultType != nullptr)
+        {
+            std::string typeName;
+            for (const auto &identifier : identifiers)
+            {
+                typeName += (typeName.empty() ? "" : ".") + identifier;
+            }
+            auto find = mockStaticTypes.find(typeName);
+            if (find != mockStaticTypes.end())
+            {
+                *ppResultType = new MockType(ELEMENT_TYPE_CLASS, find->second);
+                return S_OK;
+            }
+        }
+        IfFailRet(GetMockVariable(identifiers.at(0), &trValue));
+        nextIdentifier = 1;
+    }
+
+    for (; nextIdentifier < identifiers.size(); ++nextIdentifier)
+    {
+        ToRelease<ICorDebugValue> trObject;
+        BOOL isNull = FALSE;
+        IfFailRet(DereferenceAndUnboxValue(trValue, &trObject, &isNull));
+        if (isNull == TRUE)
+        {
+            return E_FAIL;
+        }
+        trValue.Free();
+        IfFailRet(GetMockVariable(identifiers.at(nextIdentifier), &trValue));
+    }
+
+    *ppResultValue = trValue.Detach();
+    return S_OK;
+}
+
+HRESULT Evaluator::GetMethodClass(ICorDebugThread * /*pThread*/, FrameLevel /*frameLevel*/, std::string &methodClass, bool &haveThis)
+{
+    methodClass = "Program";
+    haveThis = true;
+    return S_OK;
+}
+
+HRESULT Evaluator::WalkMethods(ICorDebugValue *pInputTypeValue, bool walkBaseType, const WalkMethodsCallback &cb)
+{
+    HRESULT Status = S_OK;
+    ToRelease<ICorDebugValue2> trValue2;
+    IfFailRet(pInputTypeValue->QueryInterface(IID_ICorDebugValue2, reinterpret_cast<void **>(&trValue2)));
+    ToRelease<ICorDebugType> trType;
+    IfFailRet(trValue2->GetExactType(&trType));
+    ToRelease<ICorDebugType> trResultType;
+    return WalkMethods(trType, walkBaseType, &trResultType, cb);
+}
+
+HRESULT Evaluator::WalkMethods(ICorDebugType *pInputType, bool walkBaseType, ICorDebugType ** /*ppResultType*/,
+                               const WalkMethodsCallback &cb)
+{
+    HRESULT Status = S_OK;
+    CorElementType elemType = ELEMENT_TYPE_MAX;
+    IfFailRet(pInputType->GetType(&elemType));
+    const std::string &typeName = GetMockTypeName(pInputType);
+    const bool isObject = elemType == ELEMENT_TYPE_CLASS || elemType == ELEMENT_TYPE_STRING;
+    for (const auto &method : mockMethods)
+    {
+        if (method.isExtension || (method.typeName != typeName && (!method.typeName.empty() || !walkBaseType || !isObject)))
+        {
+            continue;
+        }
+
+        SigElementType ret = method.ret;
+        std::vector<SigElementType> args = method.args;
+        IfFailRet(cb(method.isStatic, method.name, ret, args,
+            [&](ICorDebugFunction **ppFunction) -> HRESULT
+            {
+                *ppFunction = new MockFunction(method);
+                return S_OK;
+            }));
+        if (Status == S_CAN_EXIT)
+        {
+            return S_OK;
+        }
+    }
+    return S_OK;
+}
+
+HRESULT Evaluator::WalkExtensionMethods(ICorDebugType *pInputType, const std::string &methodName,
+                                        std::size_t methodArgsCount, const Evaluator::WalkMethodsCallback &cb)
+{
+    HRESULT Status = S_OK;
+    CorElementType elemType = ELEMENT_TYPE_MAX;
+    IfFailRet(pInputType->GetType(&elemType));
+    if (elemType != ELEMENT_TYPE_CLASS)
+    {
+        return S_OK;
+    }
+    for (const auto &method : mockMethods)
+    {
+        if (!method.isExtension || method.name != methodName || method.args.size() != methodArgsCount)
+        {
+            continue;
+        }
+
+        SigElementType ret = method.ret;
+        std::vector<SigElementType> args = method.args;
+        // Pass `false` as isStatic - extension methods require `this` as their first parameter.
+        IfFailRet(cb(false, method.name, ret, args,
+            [&](ICorDebugFunction **ppFunction) -> HRESULT
+            {
+                *ppFunction = new MockFunction(method);
+                return S_OK;
+            }));
+        if (Status == S_CAN_EXIT)
+        {
+            return S_OK;
+        }
+    }
+    return S_OK;
+}
+
+HRESULT Evaluator::GetElement(ICorDebugValue *pInputValue, std::vector<uint32_t> & /*indexes*/, ICorDebugValue **ppResultValue)
+{
+    HRESULT Status = S_OK;
+    ToRelease<ICorDebugValue2> trValue2;
+    IfFailRet(pInputValue->QueryInterface(IID_ICorDebugValue2, reinterpret_cast<void **>(&trValue2)));
+    ToRelease<ICorDebugType> trType;
+    IfFailRet(trValue2->GetExactType(&trType));
+    const std::string &elementTypeName = GetMockTypeName(trType);
+    if (elementTypeName == "System.String")
+    {
+        *ppResultValue = CreateMockValue(ELEMENT_TYPE_STRING, "arg", 0);
+    }
+    else if (elementTypeName == "System.Int32")
+    {
+        *ppResultValue = CreateMockValue(ELEMENT_TYPE_I4, "", 1);
+    }
+    else
+    {
+        *ppResultValue = CreateMockValue(ELEMENT_TYPE_CLASS, elementTypeName, 1);
+    }
+    return S_OK;
+}
+
+SigElementType Evaluator::GetElementTypeByTypeName(const std::string &typeName)
+{
+    return {ELEMENT_TYPE_CLASS, typeName};
+}
+
+HRESULT Evaluator::CallOverriddenToString(ICorDebugThread * /*pThread*/, ICorDebugValue * /*pInputValue*/, std::string & /*output*/)
+{
+    return E_NOTIMPL;
+}
+
+HRESULT Modules::ForEachModule(ICorDebugThread * /*pThread*/, const std::function<HRESULT(ICorDebugModule *pModule)> & /*cb*/)
+{
+    return E_NOTIMPL;
+}
+
+HRESULT Modules::GetModuleWithName(ICorDebugThread * /*pThread*/, const std::string & /*name*/, ICorDebugModule ** /*ppModule*/)
+{
+    return E_NOTIMPL;
+}
+
+bool HasAttribute(IMetaDataImport * /*pMDImport*/, mdToken /*tok*/, std::string_view /*attrName*/)
+{
+    return false;
+}
+
+bool HasAttribute(IMetaDataImport * /*pMDImport*/, mdToken /*tok*/, const std::vector<std::string_view> & /*attrNames*/)
+{
+    return false;
+}
+
+namespace TypePrinter
+{
+
+HRESULT FullyQualifiedNameForTypeByToken(mdToken /*mb*/, IMetaDataImport * /*pMDImport*/, std::string & /*mdName*/)
+{
+    return E_NOTIMPL;
+}
+
+HRESULT NameForToken(mdToken /*mb*/, IMetaDataImport * /*pMDImport*/, std::string & /*mdName*/, bool /*bClassName*/,
+                     std::list<std::string> * /*args*/)
+{
+    return E_NOTIMPL;
+}
+
+HRESULT NameForTypeByType(ICorDebugType *pType, std::string &mdName)
+{
+    mdName = GetMockTypeName(pType);
+    return S_OK;
+}
+
+HRESULT NameForTypeByValue(ICorDebugValue *pValue, std::string &mdName)
+{
+    HRESULT Status = S_OK;
+    ToRelease<ICorDebugValue2> trValue2;
+    IfFailRet(pValue->QueryInterface(IID_ICorDebugValue2, reinterpret_cast<void **>(&trValue2)));
+    ToRelease<ICorDebugType> trType;
+    IfFailRet(trValue2->GetExactType(&trType));
+    return NameForTypeByType(trType, mdName);
+}
+
+HRESULT GetTypeOfValue(ICorDebugType *pType, std::string &output)
+{
+    return NameForTypeByType(pType, output);
+}
+
+HRESULT GetTypeOfValue(ICorDebugValue *pValue, std::string &output)
+{
+    return NameForTypeByValue(pValue, output);
+}
+
+HRESULT GetTypeOfValue(ICorDebugType *pType, std::string &elementType, std::string &arrayType)
+{
+    arrayType.clear();
+    return NameForTypeByType(pType, elementType);
+}
+
+std::string RenameToSystem(const std::string &typeName)
+{
+    return typeName;
+}
+
+} // namespace TypePrinter
+
+} // namespace dncdbg
+
+namespace
+{
+
+struct Allocations
+{
+    size_t count{0};
+    size_t bytes{0};
+};
+
+// Tree-sitter use C allocation functions, that are not accounted by `AllocationProfile`.
+Allocations treeSitterAllocations;
+
+void CountTreeSitterAllocation(size_t size)
+{
+    ++treeSitterAllocations.count;
+    treeSitterAllocations.bytes += size;
+}
+
+void *CountingMalloc(size_t size)
+{
+    CountTreeSitterAllocation(size);
+    return std::malloc(size);
+}
+
+void *CountingCalloc(size_t count, size_t size)
+{
+    CountTreeSitterAllocation(count * size);
+    return std::calloc(count, size);
+}
+
+void *CountingRealloc(void *ptr, size_t size)
+{
+    CountTreeSitterAllocation(size);
+    return std::realloc(ptr, size);
+}
+
+struct Expression
+{
+    std::string category;
+    std::string text;
+};
+
+std::vector<Expression> CreateBuiltinCorpus()
+{
+    std::vector<Expression> corpus;
+    // Breakpoint conditions.
+    for (const char *text : {"i == 5",
+                             "count > 10 && !done",
+                             "name == \"Main\" || retries >= 3",
+                             "item.Id % 100 == 0",
+                             "request?.Headers?.Count > 0",
+                             "this.state == 2 && buffer.Length < 4096",
+                             "(flags & 0x4) != 0",
+                             "list.Count - 1 == index",
+                             "user.Name.Length > 0 && user.Age >= 18 && user.Address.City != \"Berlin\"",
+                             "x * x + y * y <= radius * radius"})
+    {
+        corpus.push_back({"condition", text});
+    }
+    // Logpoint message holes (`{...}` parts of log message).
+    for (const char *text : {"i",
+                             "request.Path",
+                             "items.Count",
+                             "elapsed.TotalMilliseconds",
+                             "System.String.Concat(first, \" \", last)",
+                             "args[0]",
+                             "order.Lines[i].Price * order.Lines[i].Quantity",
+                             "response?.StatusCode"})
+    {
+        corpus.push_back({"logpoint", text});
+    }
+    // Watches, including LINQ-like method chains.
+    for (const char *text : {"orders.Count()",
+                             "names.Contains(\"admin\")",
+                             "dict[\"key\"].ToString()",
+                             "Enumerable.Range(0, 10).Sum()",
+                             "matrix[i, j] + offset",
+                             "System.Math.Max(a, b) - System.Math.Min(a, b)",
+                             "text.Substring(0, 5).ToUpper()",
+                             "customers.First().Orders.Last().Total",
+                             "value ?? defaultValue",
+                             "sizeof(int) * 8",
+                             "-x + ~y",
+                             "1.5m / 3.0m"})
+    {
+        corpus.push_back({"watch", text});
+    }
+    return corpus;
+}
+
+template <class Func>
+Allocations CountAllocations(const char *stage, Func &&func)
+{
+    AllocationProfile::Report report;
+    AllocationProfile::GetReport(report, true);
+    const Allocations treeSitterStart = treeSitterAllocations;
+    {
+        const AllocationProfile::Scope scope(AllocationProfile::Kind::Request, stage);
+        func();
+    }
+    AllocationProfile::GetReport(report, true);
+
+    Allocations result{treeSitterAllocations.count - treeSitterStart.count,
+                       treeSitterAllocations.bytes - treeSitterStart.bytes};
+    for (const auto &stats : report.tags)
+    {
+        if (stats.name == stage)
+        {
+            result.count += stats.allocations;
+            result.bytes += stats.bytes;
+        }
+    }
+    return result;
+}
+
+bool ParseOnly(const std::string &expression)
+{
+    static const std::string prefix = "class W{void M(){_ = ";
+    static const std::string suffix = ";}}";
+    const std::string fullSource = prefix + expression + suffix;
+
+    TSParser *parser = ts_parser_new();
+    ts_parser_set_language(parser, tree_sitter_c_sharp());
+    TSTree *tree = ts_parser_parse_string(parser, nullptr, fullSource.c_str(), static_cast<uint32_t>(fullSource.length()));
+    const bool result = !ts_node_has_error(ts_tree_root_node(tree));
+    ts_tree_delete(tree);
+    ts_parser_delete(parser);
+    return result;
+}
+
+// Stack machine with mock values backend.
+class Evaluation
+{
+  public:
+
+    Evaluation()
+    {
+        std::shared_ptr<DebugInfo> sharedDebugInfo;
+        auto sharedEvalWaiter = std::make_shared<EvalWaiter>();
+        auto sharedEvalHelpers = std::make_shared<EvalHelpers>(sharedEvalWaiter);
+        m_sharedEvalStackMachine = std::make_shared<EvalStackMachine>();
+        auto sharedEvaluator = std::make_shared<Evaluator>(sharedDebugInfo, sharedEvalHelpers, m_sharedEvalStackMachine,
+                                                           sharedEvalWaiter);
+        m_sharedEvalStackMachine->SetupEval(sharedEvaluator, sharedEvalHelpers, sharedEvalWaiter);
+    }
+    Evaluation(Evaluation &&) = delete;
+    Evaluation(const Evaluation &) = delete;
+    Evaluation &operator=(Evaluation &&) = delete;
+    Evaluation &operator=(const Evaluation &) = delete;
+    ~Evaluation()
+    {
+        // Break Evaluator <-> EvalStackMachine references cycle.
+        m_sharedEvalStackMachine->ResetEval();
+    }
+
+    HRESULT Evaluate(const std::string &expression, std::string &output)
+    {
+        ToRelease<ICorDebugValue> trResult;
+        return m_sharedEvalStackMachine->EvaluateExpression(&m_thread, FrameLevel(0), expression, &trResult, output);
+    }
+
+  private:
+
+    MockThread m_thread;
+    std::shared_ptr<EvalStackMachine> m_sharedEvalStackMachine;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct Options
+{
+    bool json{false};
+    std::chrono::milliseconds duration{200};
+    std::vector<std::string> corpusPaths;
+};
+
+constexpr std::array<const char *, 3> stageNames{"parse", "generate", "evaluate"};
+
+struct StageResult
+{
+    double ns{0.0};
+    Allocations allocations;
+};
+
+void PrintResult(const Options &options, const Expression &expression, const char *stage, const StageResult &result)
+{
+    if (options.json)
+    {
+        std::printf("{\"category\":%s,\"expression\":%s,\"stage\":\"%s\",\"ns\":%.1f,\"allocations\":%zu,\"bytes\":%zu}\n",
+                    JsonString(expression.category).c_str(), JsonString(expression.text).c_str(), stage, result.ns,
+                    result.allocations.count, result.allocations.bytes);
+    }
+    else
+    {
+        static constexpr size_t maxTextLength = 40;
+        std::string text = expression.text;
+        if (text.size() > maxTextLength)
+        {
+            text.resize(maxTextLength - 3);
+            text += "...";
+        }
+        std::printf("%-10s %-40s %-9s %12.1f %8zu %10zu\n", expression.category.c_str(), text.c_str(), stage, result.ns,
+                    result.allocations.count, result.allocations.bytes);
+    }
+}
+
+bool RunExpression(const Options &options, Evaluation &evaluation, const Expression &expression,
+                   std::array<StageResult, stageNames.size()> &totals)
+{
+    std::string output;
+    if (FAILED(evaluation.Evaluate(expression.text, output)))
+    {
+        std::fprintf(stderr, "%s: evaluation failed %s\n", expression.text.c_str(), output.c_str());
+        return false;
+    }
+
+    std::array<StageResult, stageNames.size()> results;
+    auto Parse = [&]() { ParseOnly(expression.text); };
+    results[0].allocations = CountAllocations(stageNames[0], Parse);
+    results[0].ns = Measure(options.duration, Parse);
+
+    auto Generate = [&]()
+    {
+        std::list<Parser::Opcode> stackProgram;
+        std::string generateOutput;
+        Parser::GenerateProgram(expression.text, stackProgram, generateOutput);
+    };
+    results[1].allocations = CountAllocations(stageNames[1], Generate);
+    results[1].ns = Measure(options.duration, Generate);
+
+    auto Evaluate = [&]()
+    {
+        std::string evaluateOutput;
+        evaluation.Evaluate(expression.text, evaluateOutput);
+    };
+    results[2].allocations = CountAllocations(stageNames[2], Evaluate);
+    results[2].ns = Measure(options.duration, Evaluate);
+
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        PrintResult(options, expression, stageNames.at(i), results.at(i));
+        totals.at(i).ns += results.at(i).ns;
+        totals.at(i).allocations.count += results.at(i).allocations.count;
+        totals.at(i).allocations.bytes += results.at(i).allocations.bytes;
+    }
+    return true;
+}
+
+bool LoadCorpus(const std::string &path, std::vector<Expression> &corpus)
+{
+    std::ifstream file(path);
+    if (!file)
+    {
+        std::fprintf(stderr, "%s: can't open corpus file\n", path.c_str());
+        return false;
+    }
+    const std::string category = std::filesystem::path(path).stem().string();
+    std::string line;
+    while (std::getline(file, line))
+    {
+        line.erase(std::find_if(line.rbegin(), line.rend(), [](unsigned char ch) { return !std::isspace(ch); }).base(),
+                   line.end());
+        if (!line.empty() && line.front() != '#')
+        {
+            corpus.push_back({category, line});
+        }
+    }
+    return true;
+}
+
+bool ParseOptions(int argc, char *argv[], Options &options)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg(argv[i]);
+        std::string corpusPath;
+        if (arg == "--json")
+        {
+            options.json = true;
+        }
+        else if (ParseOption(arg, "--corpus=", corpusPath))
+        {
+            options.corpusPaths.emplace_back(corpusPath);
+        }
+        else if (!ParseOption(arg, "--time=", options.duration))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // unnamed namespace
+
+int main(int argc, char *argv[])
+{
+    Options options;
+    if (!ParseOptions(argc, argv, options))
+    {
+        std::fprintf(stderr, "Usage: %s [--json] [--time=<milliseconds per case>] [--corpus=<file>]...\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    std::vector<Expression> corpus;
+    for (const auto &path : options.corpusPaths)
+    {
+        if (!LoadCorpus(path, corpus))
+        {
+            return EXIT_FAILURE;
+        }
+    }
+    if (options.corpusPaths.empty())
+    {
+        corpus = CreateBuiltinCorpus();
+    }
+
+    ts_set_allocator(CountingMalloc, CountingCalloc, CountingRealloc, std::free);
+
+    if (!options.json)
+    {
+        std::printf("%-10s %-40s %-9s %12s %8s %10s\n", "category", "expression", "stage", "ns", "allocs", "bytes");
+    }
+
+    size_t measured = 0;
+    std::array<StageResult, stageNames.size()> totals;
+    Evaluation evaluation;
+    for (const auto &expression : corpus)
+    {
+        if (RunExpression(options, evaluation, expression, totals))
+        {
+            ++measured;
+        }
+    }
+
+    const Expression total{"total", std::to_string(measured) + " expressions"};
+    for (size_t i = 0; i < totals.size(); ++i)
+    {
+        PrintResult(options, total, stageNames.at(i), totals.at(i));
+    }
+
+    return measured == corpus.size() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
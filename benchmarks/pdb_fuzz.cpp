@@ -0,0 +1,517 @@
+// Copyright (c) 2026 Mikhail Kurinnoi
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+// Portable PDB reading fuzzing harness (see `PDBReader` and `DebugSources`), runs without runtime.
+// Each input is opened as portable PDB and whole reader API is called in the same way debugger does during module
+// load, stepping, breakpoints resolve and variables evaluation.
+//
+// By default harness is built as standalone mutational fuzzer (no coverage feedback) that mutates seed PDBs, reports
+// throughput and detects:
+// - crashes: input is saved into `<out>/crash-input.pdb` from signal handler, signal is raised again;
+// - hangs: input that runs longer than `--timeout` is saved into `<out>/timeout-input.pdb`, harness exits;
+// - slow inputs (quadratic blow-up): input that runs `--slow-ratio` times longer than its seed (and at least 1ms)
+//   is saved into `<out>/slow-<N>.pdb`, harness exits with failure code at the end.
+// Build with `-DFUZZING=1` (clang only) for libFuzzer entry point with coverage feedback and AddressSanitizer,
+// standalone build is better to run with AddressSanitizer too (with `ASAN_OPTIONS=abort_on_error=1`, so crash input is
+// saved by harness). Note, dnmd asserts are not disabled in Debug build.
+//
+// Usage: pdb_fuzz [--json] [--time=<seconds, 10 by default>] [--timeout=<milliseconds per input, 1000 by default>]
+//                 [--slow-ratio=<ratio, 20 by default>] [--max-len=<bytes, 1048576 by default>]
+//                 [--seed=<random seed, 1 by default>] [--out=<directory for found inputs, current by default>]
+//                 <seed portable PDB file or directory>...
+//
+// Small seeds are preferable (more executions per second), for example `pdbgen --documents=3 --methods=20 seed.pdb`.
+
+#include "benchmark_utils.h"
+#include "debuginfo/debugsources.h"
+#include "debuginfo/pdbreader.h"
+#include <dnmd.h>
+#include <dnmd_pdb.h>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#ifndef PDB_FUZZ_LIBFUZZER
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <thread>
+#endif // PDB_FUZZ_LIBFUZZER
+
+namespace
+{
+
+using namespace benchmark;
+using namespace dncdbg;
+
+// Returns false in case input can't be opened as portable PDB.
+bool RunInput(const uint8_t *data, size_t size)
+{
+    if (size > std::numeric_limits<uint32_t>::max())
+    {
+        return false;
+    }
+
+    PDBInfo pdbInfo;
+    if (!md_create_handle(data, static_cast<uint32_t>(size), &pdbInfo.m_pdbHandle))
+    {
+        return false;
+    }
+    const mdhandle_t pdbHandle = pdbInfo.m_pdbHandle;
+    const uint32_t docCount = GetTableRowCount(pdbHandle, mdtid_Document);
+    const uint32_t methodCount = GetTableRowCount(pdbHandle, mdtid_MethodDebugInformation);
+
+    // Module load (see DebugInfo::TryLoadModuleSymbols()), one index out of range is checked too.
+    std::string sourceFilePath;
+    for (uint32_t i = 0; i <= docCount; ++i)
+    {
+        PDBReader::GetSourceFile(pdbHandle, i, sourceFilePath);
+    }
+    PDBReader::GetAllSourceFiles(pdbHandle, pdbInfo.m_sourceFileNameToIndices);
+    DebugSources::FillMethodRanges(std::unordered_set<uint32_t>(), pdbHandle, pdbInfo.m_sourceMethodRanges);
+    PDBReader::GetStateMachineMethods(pdbHandle, pdbInfo.m_moveNextToKickoff, pdbInfo.m_kickoffToMoveNext);
+    PDBReader::GetAsyncMethods(pdbHandle, pdbInfo.m_asyncMethods);
+
+    // Stepping and variables evaluation.
+    for (uint32_t i = 1; i <= methodCount + 1; ++i)
+    {
+        const mdMethodDef methodToken = TokenFromRid(i, mdtMethodDef);
+
+        std::vector<uint32_t> ilOffsets;
+        PDBReader::GetUserCodeILOffsets(pdbHandle, methodToken, ilOffsets);
+        const uint32_t ilOffset = ilOffsets.empty() ? 0 : ilOffsets.back();
+
+        PDB::SequencePoint sequencePoint;
+        PDBReader::GetSequencePointByILOffset(pdbHandle, methodToken, ilOffset, sequencePoint);
+        PDBReader::GetSequencePointByILOffset(pdbHandle, methodToken, std::numeric_limits<uint32_t>::max(), sequencePoint);
+
+        WSTRING localName;
+        for (uint32_t localIndex = 0; localIndex < 2; ++localIndex)
+        {
+            PDBReader::GetLocalVariableName(pdbHandle, methodToken, ilOffset, localIndex, localName);
+            PDBReader::IsHoistedLocalInScope(pdbHandle, methodToken, ilOffset, localIndex);
+        }
+
+        std::vector<PDB::LocalConstant> constants;
+        PDBReader::GetLocalConstants(pdbHandle, methodToken, ilOffset, constants);
+
+        std::vector<PDB::AsyncAwaitInfoBlock> awaits;
+        PDBReader::GetAsyncMethodSteppingInfo(pdbHandle, methodToken, awaits);
+        uint32_t lastIlOffset = 0;
+        PDBReader::GetLastIlOffset(pdbHandle, methodToken, lastIlOffset);
+    }
+
+    // Breakpoints resolve at first and last line of each method.
+    std::vector<PDB::ResolvedBreakpoint> resolvedPoints;
+    for (const auto &[sourceIndex, methodRanges] : pdbInfo.m_sourceMethodRanges)
+    {
+        for (const auto &nestedLevel : methodRanges)
+        {
+            for (const auto &methodRange : nestedLevel)
+            {
+                DebugSources::ResolveBreakpoints(pdbInfo, sourceIndex, methodRange.startLine, resolvedPoints);
+                DebugSources::ResolveBreakpoints(pdbInfo, sourceIndex, methodRange.endLine, resolvedPoints);
+            }
+        }
+    }
+
+    return true;
+}
+
+} // unnamed namespace
+
+#ifdef PDB_FUZZ_LIBFUZZER
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) // NOLINT(misc-use-internal-linkage)
+{
+    RunInput(data, size);
+    return 0;
+}
+
+#else // PDB_FUZZ_LIBFUZZER
+
+namespace
+{
+
+using namespace benchmark;
+
+constexpr size_t maxSlowInputs = 10;
+constexpr std::chrono::milliseconds minSlowTime{1};
+
+struct Options
+{
+    bool json{false};
+    std::chrono::seconds duration{10};
+    std::chrono::milliseconds timeout{1000};
+    double slowRatio{20.0};
+    size_t maxLength{1024 * 1024};
+    uint32_t seed{1};
+    std::string outDir{"."};
+    std::vector<std::string> seedPaths;
+};
+
+struct Seed
+{
+    std::string path;
+    std::vector<uint8_t> data;
+    Clock::duration baseline{0}; // Best of several runs.
+};
+
+// Current input, for signal handler and watchdog thread (lock-free atomics are async-signal-safe).
+std::atomic<const uint8_t *> currentData{nullptr};
+std::atomic<size_t> currentSize{0};
+static_assert(std::atomic<const uint8_t *>::is_always_lock_free && std::atomic<size_t>::is_always_lock_free);
+std::atomic<Clock::rep> currentStart{0}; // Zero in case no input is running.
+std::array<char, 4096> crashPath{};
+
+bool WriteInput(const std::string &path, const uint8_t *data, size_t size)
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char *>(data), static_cast<std::streamsize>(size));
+    return file.good();
+}
+
+// Note, only async-signal-safe calls are allowed here.
+void CrashHandler(int signal)
+{
+    const int fd = open(crashPath.data(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd != -1)
+    {
+        const uint8_t *data = currentData.load();
+        size_t size = currentSize.load();
+        while (data != nullptr && size > 0)
+        {
+            const ssize_t written = write(fd, data, size);
+            if (written <= 0)
+            {
+                break;
+            }
+            data += written;
+            size -= static_cast<size_t>(written);
+        }
+        close(fd);
+    }
+
+    static const char message[] = "pdb_fuzz: crash, input saved\n";
+    [[maybe_unused]] const ssize_t written = write(STDERR_FILENO, message, sizeof(message) - 1);
+
+    std::signal(signal, SIG_DFL);
+    std::raise(signal);
+}
+
+void Watchdog(const Options &options, const std::atomic<bool> &finished)
+{
+    while (!finished.load())
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        const Clock::rep start = currentStart.load();
+        if (start == 0 || Clock::now() - Clock::time_point(Clock::duration(start)) < options.timeout)
+        {
+            continue;
+        }
+
+        const std::string path = options.outDir + "/timeout-input.pdb";
+        WriteInput(path, currentData.load(), currentSize.load());
+        std::fprintf(stderr, "pdb_fuzz: timeout (%lld ms), input saved to %s\n",
+                     static_cast<long long>(options.timeout.count()), path.c_str());
+        std::_Exit(EXIT_FAILURE);
+    }
+}
+
+Clock::duration RunTimed(const std::vector<uint8_t> &input, bool &opened)
+{
+    currentData.store(input.data());
+    currentSize.store(input.size());
+    const Clock::time_point start = Clock::now();
+    currentStart.store(start.time_since_epoch().count());
+    opened = RunInput(input.data(), input.size());
+    const Clock::time_point end = Clock::now();
+    currentStart.store(0);
+    return end - start;
+}
+
+class Mutator
+{
+  public:
+
+    explicit Mutator(uint32_t seed)
+        : m_random(seed)
+    {
+    }
+
+    void Mutate(std::vector<uint8_t> &data, size_t maxLength)
+    {
+        const size_t count = 1 + Random(4);
+        for (size_t i = 0; i < count && !data.empty(); ++i)
+        {
+            switch (Random(7))
+            {
+            case 0: // Bit flip.
+                data[Random(data.size())] ^= static_cast<uint8_t>(1U << Random(8));
+                break;
+            case 1: // Random byte.
+                data[Random(data.size())] = static_cast<uint8_t>(Random(256));
+                break;
+            case 2: // Compressed integers and blob headers boundaries.
+            {
+                static constexpr std::array<uint8_t, 10> values{0x00, 0x01, 0x3F, 0x7F, 0x80, 0xBF, 0xC0, 0xDF, 0xFE, 0xFF};
+                data[Random(data.size())] = values[Random(values.size())];
+                break;
+            }
+            case 3: // Table row counts, heap offsets and sizes.
+            {
+                if (data.size() < 4)
+                {
+                    break;
+                }
+                static constexpr std::array<uint32_t, 8> values{0, 1, 0x7F, 0x80, 0xFFFF, 0x10000, 0x7FFFFFFF, 0xFFFFFFFF};
+                const uint32_t value = values[Random(values.size())];
+                const size_t pos = Random(data.size() - 3);
+                for (size_t j = 0; j < 4; ++j)
+                {
+                    data[pos + j] = static_cast<uint8_t>(value >> (j * 8));
+                }
+                break;
+            }
+            case 4: // Copy chunk inside input.
+            {
+                const size_t length = 1 + Random(std::min<size_t>(data.size(), 64));
+                const size_t from = Random(data.size() - length + 1);
+                const size_t to = Random(data.size() - length + 1);
+                std::copy_n(data.begin() + static_cast<ptrdiff_t>(from), length, data.begin() + static_cast<ptrdiff_t>(to));
+                break;
+            }
+            case 5: // Erase chunk (truncate in case of end).
+            {
+                const size_t length = 1 + Random(std::min<size_t>(data.size(), 64));
+                const auto from = data.begin() + static_cast<ptrdiff_t>(Random(data.size() - length + 1));
+                data.erase(from, from + static_cast<ptrdiff_t>(length));
+                break;
+            }
+            default: // Duplicate chunk.
+            {
+                const size_t length = 1 + Random(std::min<size_t>(data.size(), 64));
+                if (data.size() + length > maxLength)
+                {
+                    break;
+                }
+                const size_t from = Random(data.size() - length + 1);
+                const std::vector<uint8_t> chunk(data.begin() + static_cast<ptrdiff_t>(from),
+                                                 data.begin() + static_cast<ptrdiff_t>(from + length));
+                data.insert(data.begin() + static_cast<ptrdiff_t>(Random(data.size() + 1)), chunk.begin(), chunk.end());
+                break;
+            }
+            }
+        }
+    }
+
+    size_t Random(size_t bound)
+    {
+        return std::uniform_int_distribution<size_t>(0, bound - 1)(m_random);
+    }
+
+  private:
+
+    std::mt19937 m_random;
+};
+
+bool LoadSeeds(const Options &options, std::vector<Seed> &seeds)
+{
+    for (const auto &path : options.seedPaths)
+    {
+        std::ifstream file(path, std::ios::binary);
+        Seed seed;
+        seed.path = path;
+        seed.data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        if (seed.data.empty() || seed.data.size() > options.maxLength)
+        {
+            std::fprintf(stderr, "%s: empty or exceeds max length, skipped\n", path.c_str());
+            continue;
+        }
+
+        bool opened = false;
+        seed.baseline = Clock::duration::max();
+        for (int i = 0; i < 3; ++i)
+        {
+            seed.baseline = std::min(seed.baseline, RunTimed(seed.data, opened));
+        }
+        if (!opened)
+        {
+            std::fprintf(stderr, "%s: not a portable PDB, skipped\n", path.c_str());
+            continue;
+        }
+
+        seeds.emplace_back(std::move(seed));
+    }
+
+    return !seeds.empty();
+}
+
+double ToMilliseconds(Clock::duration duration)
+{
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+bool Run(const Options &options, const std::vector<Seed> &seeds)
+{
+    Mutator mutator(options.seed);
+    size_t executions = 0;
+    size_t opened = 0;
+    size_t bytes = 0;
+    size_t slowInputs = 0;
+    double maxRatio = 0.0;
+    Clock::duration maxTime{0};
+    std::vector<uint8_t> input;
+
+    const Clock::time_point start = Clock::now();
+    Clock::time_point status = start;
+    Clock::time_point now = start;
+    while (now - start < options.duration)
+    {
+        const Seed &seed = seeds[mutator.Random(seeds.size())];
+        input = seed.data;
+        mutator.Mutate(input, options.maxLength);
+
+        bool inputOpened = false;
+        Clock::duration time = RunTimed(input, inputOpened);
+        ++executions;
+        bytes += input.size();
+        opened += inputOpened ? 1 : 0;
+
+        // Slow input must be confirmed by best of several runs, single run could be delayed by scheduler.
+        const auto isSlow = [&options, &seed](Clock::duration inputTime)
+        {
+            return inputTime > minSlowTime &&
+                   static_cast<double>(inputTime.count()) > static_cast<double>(seed.baseline.count()) * options.slowRatio;
+        };
+        for (int i = 0; i < 2 && isSlow(time); ++i)
+        {
+            time = std::min(time, RunTimed(input, inputOpened));
+        }
+
+        const double ratio = static_cast<double>(time.count()) / static_cast<double>(std::max<Clock::rep>(seed.baseline.count(), 1));
+        maxRatio = std::max(maxRatio, ratio);
+        maxTime = std::max(maxTime, time);
+        if (isSlow(time))
+        {
+            if (slowInputs < maxSlowInputs)
+            {
+                const std::string path = options.outDir + "/slow-" + std::to_string(slowInputs) + ".pdb";
+                WriteInput(path, input.data(), input.size());
+                std::fprintf(stderr, "pdb_fuzz: slow input (%.2f ms, %.1fx of %s), saved to %s\n",
+                             ToMilliseconds(time), ratio, seed.path.c_str(), path.c_str());
+            }
+            ++slowInputs;
+        }
+
+        now = Clock::now();
+        if (!options.json && now - status >= std::chrono::seconds(1))
+        {
+            status = now;
+            const double seconds = std::chrono::duration<double>(now - start).count();
+            std::printf("#%zu execs/s: %.0f MB/s: %.1f opened: %zu slow: %zu max: %.2f ms\n", executions,
+                        static_cast<double>(executions) / seconds, static_cast<double>(bytes) / seconds / 1e6,
+                        opened, slowInputs, ToMilliseconds(maxTime));
+            std::fflush(stdout);
+        }
+    }
+
+    const double seconds = std::max(std::chrono::duration<double>(now - start).count(), 1e-9);
+    if (options.json)
+    {
+        std::printf("{\"executions\":%zu,\"opened\":%zu,\"execs_per_sec\":%.1f,\"mb_per_sec\":%.2f,"
+                    "\"slow\":%zu,\"max_ms\":%.3f,\"max_ratio\":%.1f}\n",
+                    executions, opened, static_cast<double>(executions) / seconds,
+                    static_cast<double>(bytes) / seconds / 1e6, slowInputs, ToMilliseconds(maxTime), maxRatio);
+    }
+    else
+    {
+        std::printf("Done: %zu executions (%zu opened as PDB) in %.1f s, %.0f execs/s, %.1f MB/s, "
+                    "slow inputs: %zu, max time: %.2f ms, max ratio to seed: %.1fx\n",
+                    executions, opened, seconds, static_cast<double>(executions) / seconds,
+                    static_cast<double>(bytes) / seconds / 1e6, slowInputs, ToMilliseconds(maxTime), maxRatio);
+    }
+
+    return slowInputs == 0;
+}
+
+bool ParseOptions(int argc, char *argv[], Options &options)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg(argv[i]);
+        if (arg == "--json")
+        {
+            options.json = true;
+        }
+        else if (!ParseOption(arg, "--time=", options.duration) &&
+                 !ParseOption(arg, "--timeout=", options.timeout) &&
+                 !ParseOption(arg, "--slow-ratio=", options.slowRatio) &&
+                 !ParseOption(arg, "--max-len=", options.maxLength) &&
+                 !ParseOption(arg, "--seed=", options.seed) &&
+                 !ParseOption(arg, "--out=", options.outDir))
+        {
+            AddInputPath(arg, ".pdb", options.seedPaths);
+        }
+    }
+
+    return !options.seedPaths.empty() && options.timeout.count() > 0 && options.maxLength > 0;
+}
+
+} // unnamed namespace
+
+int main(int argc, char *argv[])
+{
+    Options options;
+    if (!ParseOptions(argc, argv, options))
+    {
+        std::fprintf(stderr, "Usage: %s [--json] [--time=<seconds>] [--timeout=<milliseconds per input>] "
+                             "[--slow-ratio=<ratio>] [--max-len=<bytes>] [--seed=<random seed>] [--out=<directory>] "
+                             "<seed portable PDB file or directory>...\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    const std::string path = options.outDir + "/crash-input.pdb";
+    if (path.size() >= crashPath.size())
+    {
+        std::fprintf(stderr, "Output directory path is too long\n");
+        return EXIT_FAILURE;
+    }
+    std::copy(path.begin(), path.end(), crashPath.begin());
+    for (const int signal : {SIGSEGV, SIGBUS, SIGILL, SIGFPE, SIGABRT})
+    {
+        std::signal(signal, CrashHandler);
+    }
+
+    std::atomic<bool> finished{false};
+    std::thread watchdog(Watchdog, std::cref(options), std::cref(finished));
+
+    std::vector<Seed> seeds;
+    bool result = LoadSeeds(options, seeds);
+    if (result)
+    {
+        result = Run(options, seeds);
+    }
+    else
+    {
+        std::fprintf(stderr, "No usable seed PDBs\n");
+    }
+
+    finished.store(true);
+    watchdog.join();
+    return result ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+#endif // PDB_FUZZ_LIBFUZZER
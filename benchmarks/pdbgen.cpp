@@ -0,0 +1,627 @@
+// Copyright (c) 2026 Mikhail Kurinnoi
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+// Synthetic portable PDB generator for symbols reading scale testing (see `symbols_benchmark`).
+// Tables and heaps are written by dnmd, output is deterministic (PDB ID is derived from options).
+//
+// Usage: pdbgen [--documents=<count, 100 by default>] [--methods=<count, 10000 by default>]
+//               [--lambdas=<nested lambdas per method, 2 by default>]
+//               [--sequence-points=<per method, 8 by default>]
+//               [--local-scopes=<per method, 2 by default>] [--locals=<per local scope, 2 by default>]
+//               [--async-every=<each N-th method is async, 10 by default, 0 - no async methods>]
+//               <output PDB path>
+//
+// Methods are evenly distributed over documents. Async method is generated as kickoff method (without
+// sequence points) and state machine MoveNext method with async stepping information. Lambdas are separate
+// methods with sequence points nested into parent method lines. Generated PDB have no matching assembly,
+// method tokens are MethodDef RIDs in PDB tables order.
+
+#include "benchmark_utils.h"
+#include <dnmd.h>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+
+using namespace benchmark;
+
+struct Options
+{
+    uint32_t documents{100};
+    uint32_t methods{10000};
+    uint32_t lambdas{2};
+    uint32_t sequencePoints{8};
+    uint32_t localScopes{2};
+    uint32_t locals{2};
+    uint32_t asyncEvery{10};
+    std::string outputPath;
+};
+
+constexpr uint32_t ilStep = 6;       // IL code size of one sequence point.
+constexpr uint32_t hiddenEvery = 4;  // Each 4th sequence point is hidden.
+constexpr uint32_t columnWidth = 20; // Sequence point columns span.
+constexpr uint32_t awaitsCount = 2;  // Awaits in async method.
+constexpr uint32_t methodDefTable = 0x06000000;
+constexpr uint32_t localVariableTable = 0x33000000;
+constexpr uint32_t localConstantTable = 0x34000000;
+constexpr uint32_t importScopeTable = 0x35000000;
+
+// https://github.com/dotnet/runtime/blob/main/docs/design/specs/PortablePdb-Metadata.md
+constexpr mdguid_t guidSHA256{0x8829d00f, 0x11b8, 0x4213, {0x87, 0x8b, 0x77, 0x0e, 0x85, 0x97, 0xac, 0x16}};
+constexpr mdguid_t guidCSharp{0x3f5162f8, 0x07c6, 0x11d3, {0x90, 0x53, 0x00, 0xc0, 0x4f, 0xa3, 0x02, 0xa1}};
+constexpr mdguid_t guidAsyncMethodSteppingInformation{0x54fd2ac5, 0xe925, 0x401a,
+                                                     {0x9c, 0x2a, 0xf9, 0x4f, 0x17, 0x10, 0x72, 0xf8}};
+
+void WriteUInt16(std::vector<uint8_t> &data, uint16_t value)
+{
+    data.push_back(static_cast<uint8_t>(value));
+    data.push_back(static_cast<uint8_t>(value >> 8));
+}
+
+void WriteUInt32(std::vector<uint8_t> &data, uint32_t value)
+{
+    for (int i = 0; i < 4; ++i)
+    {
+        data.push_back(static_cast<uint8_t>(value >> (i * 8)));
+    }
+}
+
+void WriteUInt64(std::vector<uint8_t> &data, uint64_t value)
+{
+    WriteUInt32(data, static_cast<uint32_t>(value));
+    WriteUInt32(data, static_cast<uint32_t>(value >> 32));
+}
+
+void WriteAlign4(std::vector<uint8_t> &data)
+{
+    while (data.size() % 4 != 0)
+    {
+        data.push_back(0);
+    }
+}
+
+// ECMA-335 II.23.2 compressed unsigned integer.
+void WriteCompressedUInt(std::vector<uint8_t> &data, uint32_t value)
+{
+    if (value < 0x80)
+    {
+        data.push_back(static_cast<uint8_t>(value));
+    }
+    else if (value < 0x4000)
+    {
+        data.push_back(static_cast<uint8_t>(0x80 | (value >> 8)));
+        data.push_back(static_cast<uint8_t>(value));
+    }
+    else
+    {
+        data.push_back(static_cast<uint8_t>(0xC0 | (value >> 24)));
+        data.push_back(static_cast<uint8_t>(value >> 16));
+        data.push_back(static_cast<uint8_t>(value >> 8));
+        data.push_back(static_cast<uint8_t>(value));
+    }
+}
+
+// ECMA-335 II.23.2 compressed signed integer (two's complement value rotated left by 1 bit).
+void WriteCompressedInt(std::vector<uint8_t> &data, int32_t value)
+{
+    const auto raw = static_cast<uint32_t>(value);
+    if (value >= -0x40 && value < 0x40)
+    {
+        const uint32_t bits = raw & 0x7F;
+        WriteCompressedUInt(data, ((bits << 1) | (bits >> 6)) & 0x7F);
+    }
+    else if (value >= -0x2000 && value < 0x2000)
+    {
+        const uint32_t bits = raw & 0x3FFF;
+        WriteCompressedUInt(data, ((bits << 1) | (bits >> 13)) & 0x3FFF);
+    }
+    else
+    {
+        const uint32_t bits = raw & 0x1FFFFFFF;
+        WriteCompressedUInt(data, ((bits << 1) | (bits >> 28)) & 0x1FFFFFFF);
+    }
+}
+
+// Empty portable PDB image with #Pdb stream, that reference MethodDef table with `methodDefRows` rows.
+// dnmd can't create #Pdb stream for new image, so tables are added to this image by dnmd editor.
+std::vector<uint8_t> CreateEmptyPDB(const std::array<uint8_t, 20> &pdbId, uint32_t methodDefRows)
+{
+    static constexpr uint32_t metadataSignature = 0x424A5342;
+    static constexpr uint64_t methodDefTableBit = 1ULL << 0x06;
+    static const char version[] = "PDB v1.0";
+
+    std::vector<uint8_t> pdbStream(pdbId.begin(), pdbId.end());
+    WriteUInt32(pdbStream, 0); // EntryPoint
+    WriteUInt64(pdbStream, methodDefTableBit);
+    WriteUInt32(pdbStream, methodDefRows);
+
+    std::vector<uint8_t> tablesStream;
+    WriteUInt32(tablesStream, 0); // Reserved
+    tablesStream.push_back(2);    // MajorVersion
+    tablesStream.push_back(0);    // MinorVersion
+    tablesStream.push_back(0);    // HeapSizes
+    tablesStream.push_back(1);    // Reserved
+    WriteUInt64(tablesStream, 0); // Valid
+    WriteUInt64(tablesStream, 0); // Sorted
+
+    const std::vector<uint8_t> emptyHeap{0, 0, 0, 0};
+
+    struct Stream
+    {
+        const char *name;
+        const std::vector<uint8_t> &data;
+    };
+    const std::array<Stream, 4> streams{{
+        {"#Pdb", pdbStream},
+        {"#~", tablesStream},
+        {"#Strings", emptyHeap},
+        {"#Blob", emptyHeap},
+    }};
+
+    std::vector<uint8_t> header;
+    WriteUInt32(header, metadataSignature);
+    WriteUInt16(header, 1); // MajorVersion
+    WriteUInt16(header, 1); // MinorVersion
+    WriteUInt32(header, 0); // Reserved
+    const size_t versionLength = (sizeof(version) + 3) & ~static_cast<size_t>(3);
+    WriteUInt32(header, static_cast<uint32_t>(versionLength));
+    header.insert(header.end(), version, version + sizeof(version));
+    WriteAlign4(header);
+    WriteUInt16(header, 0); // Flags
+    WriteUInt16(header, static_cast<uint16_t>(streams.size()));
+
+    size_t headersSize = header.size();
+    for (const auto &stream : streams)
+    {
+        headersSize += 8 + ((std::strlen(stream.name) + 4) & ~static_cast<size_t>(3));
+    }
+
+    std::vector<uint8_t> image(header);
+    size_t offset = headersSize;
+    for (const auto &stream : streams)
+    {
+        WriteUInt32(image, static_cast<uint32_t>(offset));
+        WriteUInt32(image, static_cast<uint32_t>(stream.data.size()));
+        image.insert(image.end(), stream.name, stream.name + std::strlen(stream.name) + 1);
+        WriteAlign4(image);
+        offset += stream.data.size();
+    }
+    for (const auto &stream : streams)
+    {
+        image.insert(image.end(), stream.data.begin(), stream.data.end());
+    }
+
+    return image;
+}
+
+// FNV-1a, PDB ID should depend on options only.
+std::array<uint8_t, 20> CreatePdbId(const Options &options)
+{
+    const std::array<uint32_t, 7> values{options.documents, options.methods, options.lambdas, options.sequencePoints,
+                                         options.localScopes, options.locals, options.asyncEvery};
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    std::array<uint8_t, 20> pdbId{};
+    for (size_t i = 0; i < pdbId.size(); ++i)
+    {
+        for (const uint32_t value : values)
+        {
+            hash = (hash ^ (value + i)) * 0x100000001b3ULL;
+        }
+        pdbId[i] = static_cast<uint8_t>(hash >> 32);
+    }
+    return pdbId;
+}
+
+class Generator
+{
+  public:
+
+    Generator(const Options &options, mdhandle_t handle)
+        : m_options(options),
+          m_handle(handle)
+    {
+    }
+
+    bool Generate()
+    {
+        mdcursor_t importScope;
+        if (!md_append_row(m_handle, mdtid_ImportScope, &importScope) ||
+            !md_set_column_value_as_blob(importScope, mdtImportScope_Imports, nullptr, 0))
+        {
+            return false;
+        }
+        md_commit_row_add(importScope);
+
+        for (uint32_t i = 0; i < m_options.documents; ++i)
+        {
+            if (!AddDocument(i))
+            {
+                return false;
+            }
+        }
+
+        const uint32_t methodsPerDocument = (m_options.methods + m_options.documents - 1) / m_options.documents;
+        for (uint32_t i = 0; i < m_options.methods; ++i)
+        {
+            const uint32_t document = i / methodsPerDocument + 1;
+            if (document != m_document)
+            {
+                m_document = document;
+                m_line = 1;
+            }
+            if (!AddMethod(i))
+            {
+                return false;
+            }
+        }
+
+        // Note, each appended row cause scan of all tables that could refer appended row table (row references
+        // update), so tables are filled in order of references in order to avoid quadratic complexity: local
+        // variables, local scopes, custom debug information.
+        for (const auto &localScope : m_localScopes)
+        {
+            if (!AddLocalScope(localScope))
+            {
+                return false;
+            }
+        }
+        for (const auto &[kickoffRid, moveNextRid] : m_asyncMethods)
+        {
+            if (!AddAsyncInfo(kickoffRid, moveNextRid))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    static uint32_t MethodRows(const Options &options)
+    {
+        const uint32_t asyncMethods = options.asyncEvery == 0 ? 0 : (options.methods + options.asyncEvery - 1) / options.asyncEvery;
+        return options.methods * (1 + options.lambdas) + asyncMethods;
+    }
+
+  private:
+
+    struct LocalScope
+    {
+        uint32_t methodRid;
+        uint32_t variableList;
+        uint32_t startOffset;
+        uint32_t length;
+    };
+
+    const Options &m_options;
+    mdhandle_t m_handle;
+    uint32_t m_methodRid{0};
+    uint32_t m_localVariableRid{0};
+    uint32_t m_document{0};
+    uint32_t m_line{1};
+    std::vector<LocalScope> m_localScopes;
+    std::vector<std::pair<uint32_t, uint32_t>> m_asyncMethods; // kickoff and MoveNext methods rids
+
+    // Add blob to #Blob heap and return its index (blob is stored into `row` column as temporary value).
+    static bool AddBlob(mdcursor_t row, col_index_t column, const std::string &data, uint32_t &index)
+    {
+        if (!md_set_column_value_as_blob(row, column, reinterpret_cast<const uint8_t *>(data.data()),
+                                         static_cast<uint32_t>(data.size())))
+        {
+            return false;
+        }
+
+        std::array<bool, mdtDocument_ColCount> valuesToGet{};
+        std::array<uint32_t, mdtDocument_ColCount> values{};
+        valuesToGet.at(mdtDocument_Hash) = true;
+        if (!md_get_column_values_raw(row, static_cast<uint32_t>(values.size()), valuesToGet.data(), values.data()))
+        {
+            return false;
+        }
+        index = values.at(mdtDocument_Hash);
+        return true;
+    }
+
+    bool AddDocument(uint32_t index)
+    {
+        mdcursor_t document;
+        if (!md_append_row(m_handle, mdtid_Document, &document))
+        {
+            return false;
+        }
+
+        // Document name blob: separator and blob heap indexes of path parts.
+        const std::array<std::string, 4> parts{"", "src", "Project" + std::to_string(index % 16),
+                                               "File" + std::to_string(index) + ".cs"};
+        std::vector<uint8_t> name{'/'};
+        for (const auto &part : parts)
+        {
+            uint32_t partIndex = 0;
+            if (!part.empty() && !AddBlob(document, mdtDocument_Hash, part, partIndex))
+            {
+                return false;
+            }
+            WriteCompressedUInt(name, partIndex);
+        }
+
+        std::array<uint8_t, 32> hash{};
+        for (size_t i = 0; i < hash.size(); ++i)
+        {
+            hash.at(i) = static_cast<uint8_t>(index * 31 + i);
+        }
+
+        if (!md_set_column_value_as_blob(document, mdtDocument_Name, name.data(), static_cast<uint32_t>(name.size())) ||
+            !md_set_column_value_as_guid(document, mdtDocument_HashAlgorithm, guidSHA256) ||
+            !md_set_column_value_as_blob(document, mdtDocument_Hash, hash.data(), static_cast<uint32_t>(hash.size())) ||
+            !md_set_column_value_as_guid(document, mdtDocument_Language, guidCSharp))
+        {
+            return false;
+        }
+        md_commit_row_add(document);
+        return true;
+    }
+
+    bool AddMethodDebugInformation(uint32_t document, const std::vector<uint8_t> &sequencePoints)
+    {
+        mdcursor_t methodDebugInfo;
+        if (!md_append_row(m_handle, mdtid_MethodDebugInformation, &methodDebugInfo) ||
+            !md_set_column_value_as_token(methodDebugInfo, mdtMethodDebugInformation_Document, (mdtid_Document << 24) | document) ||
+            !md_set_column_value_as_blob(methodDebugInfo, mdtMethodDebugInformation_SequencePoints,
+                                         sequencePoints.data(), static_cast<uint32_t>(sequencePoints.size())))
+        {
+            return false;
+        }
+        md_commit_row_add(methodDebugInfo);
+        ++m_methodRid;
+        return true;
+    }
+
+    // Sequence points on lines [startLine, startLine + count), each `hiddenEvery` point is hidden.
+    static std::vector<uint8_t> CreateSequencePoints(uint32_t count, uint32_t startLine, uint32_t startColumn)
+    {
+        std::vector<uint8_t> blob;
+        WriteCompressedUInt(blob, 0); // LocalSignature
+
+        bool first = true;
+        uint32_t prevLine = startLine;
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            WriteCompressedUInt(blob, first ? 0 : ilStep);
+            if (i % hiddenEvery == hiddenEvery - 1 && !first)
+            {
+                WriteCompressedUInt(blob, 0); // Hidden sequence point
+                WriteCompressedUInt(blob, 0);
+                continue;
+            }
+
+            const uint32_t line = startLine + i;
+            WriteCompressedUInt(blob, 0); // Same line
+            WriteCompressedUInt(blob, columnWidth);
+            if (first)
+            {
+                WriteCompressedUInt(blob, line);
+                WriteCompressedUInt(blob, startColumn);
+            }
+            else
+            {
+                WriteCompressedInt(blob, static_cast<int32_t>(line - prevLine));
+                WriteCompressedInt(blob, 0);
+            }
+            prevLine = line;
+            first = false;
+        }
+        return blob;
+    }
+
+    bool AddLocalVariables(uint32_t methodRid, uint32_t ilSize)
+    {
+        for (uint32_t scope = 0; scope < m_options.localScopes; ++scope)
+        {
+            // Root scope for whole method and nested scopes, ordered by start offset.
+            const uint32_t startOffset = scope == 0 ? 0 : scope * ilStep;
+            const uint32_t length = scope == 0 ? ilSize : ilStep;
+            if (startOffset + length > ilSize)
+            {
+                break;
+            }
+            m_localScopes.push_back({methodRid, m_localVariableRid + 1, startOffset, length});
+
+            for (uint32_t local = 0; local < m_options.locals; ++local)
+            {
+                const std::string name = "local" + std::to_string(scope) + "_" + std::to_string(local);
+                mdcursor_t localVariable;
+                if (!md_append_row(m_handle, mdtid_LocalVariable, &localVariable) ||
+                    !md_set_column_value_as_constant(localVariable, mdtLocalVariable_Attributes, 0) ||
+                    !md_set_column_value_as_constant(localVariable, mdtLocalVariable_Index, scope * m_options.locals + local) ||
+                    !md_set_column_value_as_utf8(localVariable, mdtLocalVariable_Name, name.c_str()))
+                {
+                    return false;
+                }
+                md_commit_row_add(localVariable);
+                ++m_localVariableRid;
+            }
+        }
+        return true;
+    }
+
+    bool AddLocalScope(const LocalScope &scope)
+    {
+        // Note, list column that points to the end of table is moved by each appended row of target table, but
+        // local scopes are added after all local variables.
+        mdcursor_t localScope;
+        if (!md_append_row(m_handle, mdtid_LocalScope, &localScope) ||
+            !md_set_column_value_as_token(localScope, mdtLocalScope_Method, methodDefTable | scope.methodRid) ||
+            !md_set_column_value_as_token(localScope, mdtLocalScope_ImportScope, importScopeTable | 1) ||
+            !md_set_column_value_as_token(localScope, mdtLocalScope_VariableList, localVariableTable | scope.variableList) ||
+            !md_set_column_value_as_token(localScope, mdtLocalScope_ConstantList, localConstantTable | 1) ||
+            !md_set_column_value_as_constant(localScope, mdtLocalScope_StartOffset, scope.startOffset) ||
+            !md_set_column_value_as_constant(localScope, mdtLocalScope_Length, scope.length))
+        {
+            return false;
+        }
+        md_commit_row_add(localScope);
+        return true;
+    }
+
+    bool AddAsyncInfo(uint32_t kickoffRid, uint32_t moveNextRid)
+    {
+        mdcursor_t stateMachine;
+        if (!md_append_row(m_handle, mdtid_StateMachineMethod, &stateMachine) ||
+            !md_set_column_value_as_token(stateMachine, mdtStateMachineMethod_MoveNextMethod, methodDefTable | moveNextRid) ||
+            !md_set_column_value_as_token(stateMachine, mdtStateMachineMethod_KickoffMethod, methodDefTable | kickoffRid))
+        {
+            return false;
+        }
+        md_commit_row_add(stateMachine);
+
+        // Catch handler offset, then yield offset, resume offset and resume method for each await.
+        std::vector<uint8_t> value;
+        WriteUInt32(value, 0);
+        for (uint32_t i = 0; i < awaitsCount; ++i)
+        {
+            WriteUInt32(value, (2 * i + 1) * ilStep);
+            WriteUInt32(value, (2 * i + 2) * ilStep);
+            WriteCompressedUInt(value, moveNextRid);
+        }
+
+        mdcursor_t customDebugInfo;
+        if (!md_append_row(m_handle, mdtid_CustomDebugInformation, &customDebugInfo) ||
+            !md_set_column_value_as_token(customDebugInfo, mdtCustomDebugInformation_Parent, methodDefTable | moveNextRid) ||
+            !md_set_column_value_as_guid(customDebugInfo, mdtCustomDebugInformation_Kind, guidAsyncMethodSteppingInformation) ||
+            !md_set_column_value_as_blob(customDebugInfo, mdtCustomDebugInformation_Value, value.data(),
+                                         static_cast<uint32_t>(value.size())))
+        {
+            return false;
+        }
+        md_commit_row_add(customDebugInfo);
+        return true;
+    }
+
+    bool AddMethod(uint32_t index)
+    {
+        const uint32_t sequencePoints = m_options.sequencePoints == 0 ? 1 : m_options.sequencePoints;
+        const uint32_t startLine = m_line;
+        m_line += sequencePoints + 1;
+
+        const bool isAsync = m_options.asyncEvery != 0 && index % m_options.asyncEvery == 0;
+        uint32_t kickoffRid = 0;
+        if (isAsync)
+        {
+            // Kickoff method have no sequence points.
+            if (!AddMethodDebugInformation(0, {}))
+            {
+                return false;
+            }
+            kickoffRid = m_methodRid;
+        }
+
+        if (!AddMethodDebugInformation(m_document, CreateSequencePoints(sequencePoints, startLine, 9)))
+        {
+            return false;
+        }
+        const uint32_t methodRid = m_methodRid;
+
+        if (!AddLocalVariables(methodRid, sequencePoints * ilStep))
+        {
+            return false;
+        }
+
+        if (isAsync)
+        {
+            m_asyncMethods.emplace_back(kickoffRid, methodRid);
+        }
+
+        // Lambdas are placed on inner lines of method, after parent method sequence points columns.
+        const uint32_t innerLines = sequencePoints > 2 ? sequencePoints - 2 : 1;
+        for (uint32_t i = 0; i < m_options.lambdas; ++i)
+        {
+            const uint32_t line = sequencePoints > 2 ? startLine + 1 + i % innerLines : startLine;
+            const uint32_t column = 9 + columnWidth + 1 + (i / innerLines) * (columnWidth + 1);
+            if (!AddMethodDebugInformation(m_document, CreateSequencePoints(1, line, column)))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+};
+
+bool ParseOptions(int argc, char *argv[], Options &options)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg(argv[i]);
+        if (ParseOption(arg, "--documents=", options.documents) ||
+            ParseOption(arg, "--methods=", options.methods) ||
+            ParseOption(arg, "--lambdas=", options.lambdas) ||
+            ParseOption(arg, "--sequence-points=", options.sequencePoints) ||
+            ParseOption(arg, "--local-scopes=", options.localScopes) ||
+            ParseOption(arg, "--locals=", options.locals) ||
+            ParseOption(arg, "--async-every=", options.asyncEvery))
+        {
+            continue;
+        }
+        if (arg.compare(0, 2, "--") == 0 || !options.outputPath.empty())
+        {
+            return false;
+        }
+        options.outputPath = arg;
+    }
+
+    return !options.outputPath.empty() && options.documents != 0 && options.methods != 0;
+}
+
+} // unnamed namespace
+
+int main(int argc, char *argv[])
+{
+    Options options;
+    if (!ParseOptions(argc, argv, options))
+    {
+        std::fprintf(stderr, "Usage: %s [--documents=N] [--methods=N] [--lambdas=N] [--sequence-points=N] "
+                             "[--local-scopes=N] [--locals=N] [--async-every=N] <output PDB path>\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    const std::vector<uint8_t> emptyPDB = CreateEmptyPDB(CreatePdbId(options), Generator::MethodRows(options));
+    mdhandle_t handle = nullptr;
+    if (!md_create_handle(emptyPDB.data(), emptyPDB.size(), &handle))
+    {
+        std::fprintf(stderr, "Can't create PDB image\n");
+        return EXIT_FAILURE;
+    }
+
+    Generator generator(options, handle);
+    size_t size = 0;
+    std::vector<uint8_t> image;
+    if (!generator.Generate() ||
+        (md_write_to_buffer(handle, nullptr, &size), image.resize(size), !md_write_to_buffer(handle, image.data(), &size)))
+    {
+        std::fprintf(stderr, "Can't generate PDB tables\n");
+        md_destroy_handle(handle);
+        return EXIT_FAILURE;
+    }
+    md_destroy_handle(handle);
+
+    FILE *file = std::fopen(options.outputPath.c_str(), "wb");
+    if (file == nullptr || std::fwrite(image.data(), 1, image.size(), file) != image.size())
+    {
+        std::fprintf(stderr, "Can't write %s\n", options.outputPath.c_str());
+        if (file != nullptr)
+        {
+            std::fclose(file);
+        }
+        return EXIT_FAILURE;
+    }
+    std::fclose(file);
+
+    return EXIT_SUCCESS;
+}
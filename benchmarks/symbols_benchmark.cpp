@@ -0,0 +1,276 @@
+// Copyright (c) 2026 Mikhail Kurinnoi
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+// Symbols reading microbenchmark (see `PDBReader`, `DebugSources` and `SourceFileMap`), runs without runtime.
+// Note, module constructors tokens are not available without module metadata, so constructors are indexed as
+// ordinary methods.
+//
+// Usage: symbols_benchmark [--json] [--time=<milliseconds per case, 200 by default>]
+//                          [--map=<from>=<to>] <portable PDB file or directory>...
+//
+// With `--json` option each result printed as single line JSON object.
+// With `--map` option source file mapping is applied to document names (could be used several times).
+
+#include "benchmark_utils.h"
+#include "debuginfo/debugsources.h"
+#include "debuginfo/pdbreader.h"
+#include "debuginfo/sourcefilemap.h"
+#include <dnmd.h>
+#include <dnmd_pdb.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <limits>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace
+{
+
+using namespace benchmark;
+using namespace dncdbg;
+
+// Module stub for breakpoints resolve, only references counting is used.
+class ModuleStub final : public ICorDebugModule
+{
+  public:
+
+    HRESULT STDMETHODCALLTYPE QueryInterface(REFIID /*riid*/, void **ppInterface) override
+    {
+        *ppInterface = nullptr;
+        return E_NOINTERFACE;
+    }
+    ULONG STDMETHODCALLTYPE AddRef() override
+    {
+        return ++m_refCount;
+    }
+    ULONG STDMETHODCALLTYPE Release() override
+    {
+        return --m_refCount;
+    }
+
+    HRESULT STDMETHODCALLTYPE GetProcess(ICorDebugProcess ** /*ppProcess*/) override { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE GetBaseAddress(CORDB_ADDRESS * /*pAddress*/) override { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE GetAssembly(ICorDebugAssembly ** /*ppAssembly*/) override { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE GetName(ULONG32 /*cchName*/, ULONG32 * /*pcchName*/, WCHAR /*szName*/[]) override { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE EnableJITDebugging(BOOL /*bTrackJITInfo*/, BOOL /*bAllowJitOpts*/) override { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE EnableClassLoadCallbacks(BOOL /*bClassLoadCallbacks*/) override { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE GetFunctionFromToken(mdMethodDef /*methodDef*/, ICorDebugFunction ** /*ppFunction*/) override { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE GetFunctionFromRVA(CORDB_ADDRESS /*rva*/, ICorDebugFunction ** /*ppFunction*/) override { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE GetClassFromToken(mdTypeDef /*typeDef*/, ICorDebugClass ** /*ppClass*/) override { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE CreateBreakpoint(ICorDebugModuleBreakpoint ** /*ppBreakpoint*/) override { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE GetEditAndContinueSnapshot(ICorDebugEditAndContinueSnapshot ** /*ppSnapshot*/) override { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE GetMetaDataInterface(REFIID /*riid*/, IUnknown ** /*ppObj*/) override { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE GetToken(mdModule * /*pToken*/) override { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE IsDynamic(BOOL * /*pDynamic*/) override { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE GetGlobalVariableValue(mdFieldDef /*fieldDef*/, ICorDebugValue ** /*ppValue*/) override { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE GetSize(ULONG32 * /*pcBytes*/) override { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE IsInMemory(BOOL * /*pInMemory*/) override { return E_NOTIMPL; }
+
+  private:
+
+    ULONG m_refCount{0};
+};
+
+struct Options
+{
+    bool json{false};
+    std::chrono::milliseconds duration{200};
+    std::vector<std::string> pdbPaths;
+};
+
+void PrintResult(const Options &options, const std::string &pdbPath, const char *caseName, size_t items, double nsPerPass)
+{
+    const double nsPerItem = items == 0 ? 0.0 : nsPerPass / static_cast<double>(items);
+    if (options.json)
+    {
+        std::printf("{\"pdb\":%s,\"case\":\"%s\",\"items\":%zu,\"ns_per_pass\":%.1f,\"ns_per_item\":%.1f}\n",
+                    JsonString(pdbPath).c_str(), caseName, items, nsPerPass, nsPerItem);
+    }
+    else
+    {
+        std::printf("%-40s %-16s %10zu %14.1f %12.1f\n",
+                    std::filesystem::path(pdbPath).filename().string().c_str(), caseName, items, nsPerPass, nsPerItem);
+    }
+}
+
+bool RunPDB(const Options &options, const std::string &pdbPath)
+{
+    PDB::Identity pdbId{};
+    {
+        MemoryBuffer memBuff;
+        mdhandle_t pdbHandle = nullptr;
+        size_t size = PDB::IDSize;
+        if (!memBuff.Open(pdbPath) ||
+            !md_create_handle(memBuff.Data(), static_cast<uint32_t>(memBuff.Size()), &pdbHandle))
+        {
+            std::fprintf(stderr, "%s: not a portable PDB\n", pdbPath.c_str());
+            return false;
+        }
+        const bool idFound = md_get_pdb_id(pdbHandle, &size, pdbId.data());
+        md_destroy_handle(pdbHandle);
+        if (!idFound)
+        {
+            std::fprintf(stderr, "%s: PDB ID not found\n", pdbPath.c_str());
+            return false;
+        }
+    }
+
+    PrintResult(options, pdbPath, "open", 1, Measure(options.duration, [&]()
+        {
+            MemoryBuffer memBuff;
+            mdhandle_t pdbHandle = nullptr;
+            if (SUCCEEDED(PDBReader::OpenPDB(pdbPath, pdbId, memBuff, pdbHandle)))
+            {
+                md_destroy_handle(pdbHandle);
+            }
+        }));
+
+    // Note, stub must outlive PDB info and resolved breakpoints, since they hold stub references.
+    ModuleStub moduleStub;
+    PDBInfo pdbInfo;
+    moduleStub.AddRef();
+    pdbInfo.m_trModule = &moduleStub;
+    if (FAILED(PDBReader::OpenPDB(pdbPath, pdbId, pdbInfo.m_memBuff, pdbInfo.m_pdbHandle)))
+    {
+        std::fprintf(stderr, "%s: can't open PDB\n", pdbPath.c_str());
+        return false;
+    }
+    const mdhandle_t pdbHandle = pdbInfo.m_pdbHandle;
+    const uint32_t docCount = GetTableRowCount(pdbHandle, mdtid_Document);
+    const uint32_t methodCount = GetTableRowCount(pdbHandle, mdtid_MethodDebugInformation);
+
+    PrintResult(options, pdbPath, "document-name", docCount, Measure(options.duration, [&]()
+        {
+            std::string sourceFilePath;
+            for (uint32_t i = 0; i < docCount; ++i)
+            {
+                PDBReader::GetSourceFile(pdbHandle, i, sourceFilePath);
+            }
+        }));
+
+    PrintResult(options, pdbPath, "source-index", docCount, Measure(options.duration, [&]()
+        {
+            PDB::SourceNameMap sourceFileNameToIndices;
+            PDBReader::GetAllSourceFiles(pdbHandle, sourceFileNameToIndices);
+        }));
+
+    const std::unordered_set<uint32_t> constrTokens;
+    PrintResult(options, pdbPath, "method-ranges", methodCount, Measure(options.duration, [&]()
+        {
+            PDB::SourceMethodRanges sourceMethodRanges;
+            DebugSources::FillMethodRanges(constrTokens, pdbHandle, sourceMethodRanges);
+        }));
+
+    // Last sequence point lookup, whole method sequence points are decoded.
+    PrintResult(options, pdbPath, "sequence-point", methodCount, Measure(options.duration, [&]()
+        {
+            PDB::SequencePoint sequencePoint;
+            for (uint32_t i = 1; i <= methodCount; ++i)
+            {
+                PDBReader::GetSequencePointByILOffset(pdbHandle, TokenFromRid(i, mdtMethodDef),
+                                                      std::numeric_limits<uint32_t>::max(), sequencePoint);
+            }
+        }));
+
+    PrintResult(options, pdbPath, "step-offsets", methodCount, Measure(options.duration, [&]()
+        {
+            std::vector<uint32_t> ilOffsets;
+            for (uint32_t i = 1; i <= methodCount; ++i)
+            {
+                PDBReader::GetUserCodeILOffsets(pdbHandle, TokenFromRid(i, mdtMethodDef), ilOffsets);
+            }
+        }));
+
+    PrintResult(options, pdbPath, "local-name", methodCount, Measure(options.duration, [&]()
+        {
+            WSTRING localName;
+            for (uint32_t i = 1; i <= methodCount; ++i)
+            {
+                PDBReader::GetLocalVariableName(pdbHandle, TokenFromRid(i, mdtMethodDef), 0, 0, localName);
+            }
+        }));
+
+    // Breakpoint at first line of each top level method of each source file.
+    DebugSources::FillMethodRanges(constrTokens, pdbHandle, pdbInfo.m_sourceMethodRanges);
+    std::vector<std::pair<uint32_t, int>> breakpoints;
+    for (const auto &[sourceIndex, methodRanges] : pdbInfo.m_sourceMethodRanges)
+    {
+        if (methodRanges.empty())
+        {
+            continue;
+        }
+        for (const auto &methodRange : methodRanges.front())
+        {
+            breakpoints.emplace_back(sourceIndex, methodRange.startLine);
+        }
+    }
+
+    PrintResult(options, pdbPath, "breakpoint", breakpoints.size(), Measure(options.duration, [&]()
+        {
+            std::vector<PDB::ResolvedBreakpoint> resolvedPoints;
+            for (const auto &[sourceIndex, sourceLine] : breakpoints)
+            {
+                DebugSources::ResolveBreakpoints(pdbInfo, sourceIndex, sourceLine, resolvedPoints);
+            }
+        }));
+
+    return true;
+}
+
+bool ParseOptions(int argc, char *argv[], Options &options)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg(argv[i]);
+        std::string map;
+        if (arg == "--json")
+        {
+            options.json = true;
+        }
+        else if (ParseOption(arg, "--map=", map))
+        {
+            const size_t delim = map.find('=');
+            if (delim == std::string::npos)
+            {
+                return false;
+            }
+            SourceFileMap::GetMap()[map.substr(0, delim)] = map.substr(delim + 1);
+        }
+        else if (!ParseOption(arg, "--time=", options.duration))
+        {
+            AddInputPath(arg, ".pdb", options.pdbPaths);
+        }
+    }
+
+    return !options.pdbPaths.empty();
+}
+
+} // unnamed namespace
+
+int main(int argc, char *argv[])
+{
+    Options options;
+    if (!ParseOptions(argc, argv, options))
+    {
+        std::fprintf(stderr, "Usage: %s [--json] [--time=<milliseconds per case>] [--map=<from>=<to>] "
+                             "<portable PDB file or directory>...\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if (!options.json)
+    {
+        std::printf("%-40s %-16s %10s %14s %12s\n", "pdb", "case", "items", "ns/pass", "ns/item");
+    }
+
+    bool result = true;
+    for (const auto &pdbPath : options.pdbPaths)
+    {
+        result = RunPDB(options, pdbPath) && result;
+    }
+
+    return result ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,62 @@
+// Copyright (c) 2026 Mikhail Kurinnoi
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+// UTF-8 <-> UTF-16 conversion microbenchmark (see `to_utf8()` and `to_utf16()`).
+//
+// Usage: utf_benchmark [milliseconds per case, 200 by default]
+
+#include "benchmark_utils.h"
+#include "utils/utf.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+using namespace benchmark;
+
+struct Dataset
+{
+    const char *name;
+    std::string utf8;
+};
+
+std::vector<Dataset> CreateDatasets()
+{
+    static constexpr size_t longSize = 4096;
+    return {
+        {"ascii-short", "System.Collections.Generic.List`1"},
+        {"ascii-long", Repeat("The quick brown fox jumps over the lazy dog. ", longSize)},
+        {"cyrillic-mixed", Repeat("Test \xD1\x82\xD0\xB5\xD1\x81\xD1\x82 value = 42; ", longSize)},
+        {"cjk", Repeat("\xE4\xB8\xAD\xE6\x96\x87\xE5\xAD\x97\xE7\xAC\xA6\xE4\xB8\xB2", longSize)},
+        {"emoji-mixed", Repeat("log \xF0\x9F\x98\x80 message \xF0\x9F\x9A\x80 ", longSize)},
+    };
+}
+
+} // unnamed namespace
+
+int main(int argc, char *argv[])
+{
+    static constexpr long defaultDuration = 200;
+    const std::chrono::milliseconds duration(argc > 1 ? std::strtol(argv[1], nullptr, 10) : defaultDuration);
+
+    volatile size_t sink = 0;
+    std::printf("%-16s %-10s %12s %12s\n", "dataset", "direction", "ns/op", "MB/s");
+    for (const auto &dataset : CreateDatasets())
+    {
+        const dncdbg::WSTRING utf16 = dncdbg::to_utf16(dataset.utf8);
+        const double mb = static_cast<double>(dataset.utf8.size()) / (1024.0 * 1024.0);
+
+        const double toUtf16 = Measure(duration, [&]() { sink = sink + dncdbg::to_utf16(dataset.utf8).size(); });
+        std::printf("%-16s %-10s %12.1f %12.1f\n", dataset.name, "to_utf16", toUtf16, mb / (toUtf16 / 1e9));
+
+        const double toUtf8 = Measure(duration, [&]() { sink = sink + dncdbg::to_utf8(utf16.c_str()).size(); });
+        std::printf("%-16s %-10s %12.1f %12.1f\n", dataset.name, "to_utf8", toUtf8, mb / (toUtf8 / 1e9));
+    }
+
+    return sink == 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -14,12 +14,99 @@
 #include "debugger/steppers/steppers.h"
 #include "debugger/threads.h"
 #include "protocol/dapio.h"
+#include "utils/allocationprofile.h"
 #include "utils/hresult.h"
+#include "utils/metrics.h"
+#include "utils/startupprofile.h"
 #include <algorithm>
+#include <chrono>
 
 namespace dncdbg
 {
 
+namespace
+{
+
+enum class StopStage : uint8_t
+{
+    Queue,
+    Decision,
+    Stopped,
+    StackTrace
+};
+
+void RecordStopLatency(CallbackQueueCall call, StopStage stage, std::chrono::steady_clock::duration duration)
+{
+    Metrics::Histogram first = Metrics::Histogram::Count;
+    switch (call)
+    {
+    case CallbackQueueCall::Breakpoint:
+        first = Metrics::Histogram::BreakpointQueueUs;
+        break;
+    case CallbackQueueCall::StepComplete:
+        first = Metrics::Histogram::StepCompleteQueueUs;
+        break;
+    case CallbackQueueCall::Break:
+        first = Metrics::Histogram::BreakQueueUs;
+        break;
+    case CallbackQueueCall::Exception:
+        first = Metrics::Histogram::ExceptionQueueUs;
+        break;
+    default:
+        return;
+    }
+
+    // Stages of each callback type are in StopStage order.
+    Metrics::RecordTime(static_cast<Metrics::Histogram>(static_cast<size_t>(first) + static_cast<size_t>(stage)), duration);
+}
+
+// Same names as ManagedCallback methods, so allocation profile has one entry for callback and its queued processing.
+const char *GetCallbackName(CallbackQueueCall call)
+{
+    switch (call)
+    {
+    case CallbackQueueCall::Breakpoint:
+        return "Breakpoint";
+    case CallbackQueueCall::StepComplete:
+        return "StepComplete";
+    case CallbackQueueCall::Break:
+        return "Break";
+    case CallbackQueueCall::Exception:
+        return "Exception";
+    case CallbackQueueCall::CreateProcess:
+        return "CreateProcess";
+    default:
+        return "FinishWorker";
+    }
+}
+
+} // unnamed namespace
+
+// Caller must hold m_callbacksMutex.
+void CallbacksQueue::EmitStoppedEvent(const StoppedEvent &event)
+{
+    m_currentStop.Decision = Clock::now();
+    m_debugger.FlushOutput();
+    DAPIO::EmitStoppedEvent(event);
+    m_currentStop.Stopped = Clock::now();
+
+    const std::scoped_lock<std::mutex> lock(m_stackTraceStopMutex);
+    m_stackTraceStop = m_currentStop;
+    m_stackTracePending = true;
+}
+
+void CallbacksQueue::NotifyStackTraceResponse()
+{
+    const std::scoped_lock<std::mutex> lock(m_stackTraceStopMutex);
+    if (!m_stackTracePending)
+    {
+        return;
+    }
+
+    m_stackTracePending = false;
+    RecordStopLatency(m_stackTraceStop.Call, StopStage::StackTrace, Clock::now() - m_stackTraceStop.Stopped);
+}
+
 bool CallbacksQueue::CallbacksWorkerBreakpoint(ICorDebugAppDomain *pAppDomain, ICorDebugThread *pThread, ICorDebugBreakpoint *pBreakpoint)
 {
     if (S_IGNORE == m_debugger.m_uniqueSteppers->ManagedCallbackBreakpoint(pAppDomain, pThread))
@@ -45,7 +132,7 @@ bool CallbacksQueue::CallbacksWorkerBreakpoint(ICorDebugAppDomain *pAppDomain, I
 
     const ThreadId threadId(getThreadId(pThread));
     const StoppedEvent event(atEntry ? StoppedEventReason::Entry : StoppedEventReason::Breakpoint, std::move(hitBreakpointIds), threadId);
-    DAPIO::EmitStoppedEvent(event);
+    EmitStoppedEvent(event);
     return true;
 }
 
@@ -62,7 +149,7 @@ bool CallbacksQueue::CallbacksWorkerStepComplete(ICorDebugThread *pThread, CorDe
     const StoppedEvent event(StoppedEventReason::Step, threadId);
 
     m_debugger.SetLastStoppedThread(pThread);
-    DAPIO::EmitStoppedEvent(event);
+    EmitStoppedEvent(event);
     return true;
 }
 
@@ -82,7 +169,7 @@ bool CallbacksQueue::CallbacksWorkerBreak(ICorDebugAppDomain *pAppDomain, ICorDe
     const ThreadId threadId(getThreadId(pThread));
 
     const StoppedEvent event(StoppedEventReason::Pause, threadId);
-    DAPIO::EmitStoppedEvent(event);
+    EmitStoppedEvent(event);
     return true;
 }
 
@@ -102,7 +189,7 @@ bool CallbacksQueue::CallbacksWorkerException(ICorDebugAppDomain *pAppDomain, IC
     const ThreadId threadId(getThreadId(pThread));
     const StoppedEvent event(StoppedEventReason::Exception, threadId);
     m_debugger.SetLastStoppedThread(pThread);
-    DAPIO::EmitStoppedEvent(event);
+    EmitStoppedEvent(event);
     return true;
 }
 
@@ -126,6 +213,8 @@ void CallbacksQueue::CallbacksWorker()
         }
 
         auto &c = m_callbacksQueue.front();
+        m_currentStop = StopTiming{c.Call, c.ArrivalTime, Clock::now(), {}, {}};
+        const AllocationProfile::Scope allocationScope(AllocationProfile::Kind::Callback, GetCallbackName(c.Call));
 
         switch (c.Call)
         {
@@ -150,6 +239,23 @@ void CallbacksQueue::CallbacksWorker()
             return;
         }
 
+        Metrics::Add(Metrics::Counter::CallbacksProcessed);
+        RecordStopLatency(c.Call, StopStage::Queue, m_currentStop.Dequeue - m_currentStop.Arrival);
+
+        if (m_stopEventInProcess)
+        {
+            Metrics::Add(Metrics::Counter::StopEvents);
+            RecordStopLatency(c.Call, StopStage::Decision, m_currentStop.Decision - m_currentStop.Dequeue);
+            RecordStopLatency(c.Call, StopStage::Stopped, m_currentStop.Stopped - m_currentStop.Arrival);
+        }
+        else
+        {
+            const Clock::time_point now = Clock::now();
+            RecordStopLatency(c.Call, StopStage::Decision, now - m_currentStop.Dequeue);
+            // Debuggee was suspended from callback arrival till now (stop events are not counted, since this is user's pause).
+            StartupProfile::AddCallbackTime(now - m_currentStop.Arrival);
+        }
+
         ToRelease<ICorDebugAppDomain> trAppDomain(c.trAppDomain.Detach());
         m_callbacksQueue.pop_front();
 
@@ -172,6 +278,8 @@ bool CallbacksQueue::HasQueuedCallbacks(ICorDebugProcess *pProcess)
 
 HRESULT CallbacksQueue::AddCallbackToQueue(ICorDebugAppDomain *pAppDomain, const std::function<void()> &callback)
 {
+    const Clock::time_point arrivalTime = Clock::now();
+
     if (m_debugger.m_sharedEvalWaiter->IsEvalRunning())
     {
         pAppDomain->Continue(0);
@@ -180,6 +288,7 @@ HRESULT CallbacksQueue::AddCallbackToQueue(ICorDebugAppDomain *pAppDomain, const
 
     const std::unique_lock<std::mutex> lock(m_callbacksMutex);
 
+    m_arrivalTime = arrivalTime;
     callback();
     assert(!m_callbacksQueue.empty());
 
@@ -275,6 +384,10 @@ HRESULT CallbacksQueue::Continue(ICorDebugProcess *pProcess)
 
     assert(m_stopEventInProcess);
     m_stopEventInProcess = false;
+    {
+        const std::scoped_lock<std::mutex> stackTraceStopLock(m_stackTraceStopMutex);
+        m_stackTracePending = false;
+    }
 
     if (m_callbacksQueue.empty())
     {
@@ -318,6 +431,7 @@ HRESULT CallbacksQueue::Pause(ICorDebugProcess *pProcess, ThreadId lastStoppedTh
     {
         // DAP event must provide thread only (VSCode IDE counts on this), even if this thread doesn't have user code.
         m_debugger.SetLastStoppedThreadId(lastStoppedThread);
+        m_debugger.FlushOutput();
         DAPIO::EmitStoppedEvent(StoppedEvent(StoppedEventReason::Pause, lastStoppedThread));
         return S_OK;
     }
@@ -357,6 +471,8 @@ void CallbacksQueue::EmplaceBack(CallbackQueueCall Call, ICorDebugAppDomain *pAp
                                  ExceptionCallbackType EventType)
 {
     m_callbacksQueue.emplace_back(Call, pAppDomain, pThread, pBreakpoint, Reason, EventType);
+    m_callbacksQueue.back().ArrivalTime = m_arrivalTime;
+    Metrics::Add(Metrics::Counter::CallbacksQueued);
 }
 
 } // namespace dncdbg
@@ -15,6 +15,7 @@
 #include "types/types.h"
 #include "types/protocol.h"
 #include "utils/torelease.h"
+#include <chrono>
 #include <condition_variable>
 #include <functional>
 #include <list>
@@ -76,8 +77,13 @@ class CallbacksQueue
     void EmplaceBack(CallbackQueueCall Call, ICorDebugAppDomain *pAppDomain, ICorDebugThread *pThread,
                      ICorDebugBreakpoint *pBreakpoint, CorDebugStepReason Reason, ExceptionCallbackType EventType);
 
+    // Called from ManagedDebugger, when stack trace request for stopped process is done.
+    void NotifyStackTraceResponse();
+
   private:
 
+    using Clock = std::chrono::steady_clock;
+
     ManagedDebugger &m_debugger;
 
     // Note: we have one entry type for both (managed and interop) callbacks (stop events),
@@ -93,6 +99,7 @@ class CallbacksQueue
         CorDebugStepReason Reason = CorDebugStepReason::STEP_NORMAL; // Initial value in order to suppress static analyzer warnings.
         ExceptionCallbackType EventType = ExceptionCallbackType::FIRST_CHANCE; // Initial value in order to suppress static analyzer warnings.
         std::string ExcModule;
+        Clock::time_point ArrivalTime;
 
         CallbackQueueEntry(CallbackQueueCall call,
                            ICorDebugAppDomain *pAppDomain,
@@ -113,6 +120,22 @@ class CallbacksQueue
 
     };
 
+    // Stop latency stages timestamps (see Metrics::Histogram for stages).
+    struct StopTiming
+    {
+        CallbackQueueCall Call = CallbackQueueCall::FinishWorker;
+        Clock::time_point Arrival;
+        Clock::time_point Dequeue;
+        Clock::time_point Decision;
+        Clock::time_point Stopped;
+    };
+    Clock::time_point m_arrivalTime; // Callback that is added into queue now (see AddCallbackToQueue()), protected by m_callbacksMutex.
+    StopTiming m_currentStop;        // Callback that is processed by CallbacksWorker now, protected by m_callbacksMutex.
+    // Stop event that waits for first stack trace response.
+    std::mutex m_stackTraceStopMutex;
+    StopTiming m_stackTraceStop;
+    bool m_stackTracePending{false};
+
     std::mutex m_callbacksMutex;
     std::condition_variable m_callbacksCV;
     std::list<CallbackQueueEntry> m_callbacksQueue; // Make sure this one initialized before m_callbacksWorker.
@@ -120,6 +143,7 @@ class CallbacksQueue
     std::thread m_callbacksWorker;
 
     void CallbacksWorker();
+    void EmitStoppedEvent(const StoppedEvent &event);
     bool CallbacksWorkerBreakpoint(ICorDebugAppDomain *pAppDomain, ICorDebugThread *pThread, ICorDebugBreakpoint *pBreakpoint);
     bool CallbacksWorkerStepComplete(ICorDebugThread *pThread, CorDebugStepReason reason);
     bool CallbacksWorkerBreak(ICorDebugAppDomain *pAppDomain, ICorDebugThread *pThread);
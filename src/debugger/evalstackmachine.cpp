@@ -12,6 +12,7 @@
 #include "expressionparser/helpers.h"
 #include "expressionparser/parser.h"
 #include "metadata/typeprinter.h"
+#include "utils/cancellation.h"
 #include "utils/hresult.h"
 #include "utils/logger.h"
 #include "utils/utf.h"
@@ -1573,6 +1574,12 @@ HRESULT EvalStackMachine::Run(ICorDebugThread *pThread, FrameLevel frameLevel, c
 
     for (const auto &executionStep : stackProgram)
     {
+        if (CancellationToken::IsCurrentCanceled())
+        {
+            Status = COR_E_OPERATIONCANCELED;
+            break;
+        }
+
         auto findStep = CommandImplementation.find(executionStep.kind);
         if (findStep == CommandImplementation.end())
         {
@@ -1232,7 +1232,8 @@ HRESULT Evaluator::GetStaticField(ICorDebugThread *pThread, FrameLevel frameLeve
             {
                 // Read m_dwFlags from MethodTableAuxiliaryData (at offset 0).
                 DWORD auxFlags = 0;
-                if (SUCCEEDED(trProcess->ReadMemory(auxDataAddr, sizeof(DWORD), reinterpret_cast<BYTE*>(&auxFlags), &bytesRead)))
+                if (SUCCEEDED(trProcess->ReadMemory(auxDataAddr, sizeof(DWORD), reinterpret_cast<BYTE*>(&auxFlags), &bytesRead)) &&
+                    bytesRead == sizeof(DWORD))
                 {
                     isClassInitialized = (auxFlags & enum_flag_Initialized) != 0;
                 }
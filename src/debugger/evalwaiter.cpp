@@ -4,8 +4,10 @@
 // See the LICENSE file in the project root for more information.
 
 #include "debugger/evalwaiter.h"
+#include "utils/cancellation.h"
 #include "utils/hresult.h"
 #include "utils/logger.h"
+#include "utils/metrics.h"
 #include "utils/utf.h"
 
 namespace dncdbg
@@ -118,6 +120,12 @@ HRESULT EvalWaiter::WaitEvalResult(ICorDebugThread *pThread, ICorDebugValue **pp
     // Important! Evaluation should be proceed only for 1 thread.
     const std::scoped_lock<std::mutex> lock(m_waitEvalResultMutex);
 
+    // Protocol command was canceled (timed out), don't start new evaluation.
+    if (CancellationToken::IsCurrentCanceled())
+    {
+        return COR_E_OPERATIONCANCELED;
+    }
+
     // During evaluation could be implicitly executing user code, that could provoke callback calls like - breakpoints, exceptions, etc.
     // Make sure, that all managed callbacks ignore standard logic during evaluation and don't pause/interrupt managed code execution.
 
@@ -248,7 +256,12 @@ HRESULT EvalWaiter::WaitEvalResult(ICorDebugThread *pThread, ICorDebugValue **pp
 
     m_evalCanceled = false;
     m_evalCrossThreadDependency = false;
-    HRESULT ret = WaitResult();
+    Metrics::Add(Metrics::Counter::FuncEvals);
+    HRESULT ret = S_OK;
+    {
+        const Metrics::ScopedTimer evalTimer(Metrics::Histogram::FuncEvalTimeUs);
+        ret = WaitResult();
+    }
 
     SetEnableCustomNotification(trProcess, FALSE);
 
@@ -269,6 +282,15 @@ HRESULT EvalWaiter::WaitEvalResult(ICorDebugThread *pThread, ICorDebugValue **pp
         ret = (ret == E_UNEXPECTED) ? E_UNEXPECTED : COR_E_TIMEOUT;
     }
 
+    if (ret == COR_E_TIMEOUT)
+    {
+        Metrics::Add(Metrics::Counter::FuncEvalsTimedOut);
+    }
+    else if (FAILED(ret))
+    {
+        Metrics::Add(Metrics::Counter::FuncEvalsFailed);
+    }
+
     ChangeThreadsState(THREAD_RUN);
     return ret;
 }
@@ -8,6 +8,7 @@
 #include "debuginfo/debuginfo.h"
 #include "metadata/modules.h"
 #include "metadata/typeprinter.h"
+#include "utils/cancellation.h"
 #include "utils/hresult.h"
 #include "utils/torelease.h"
 #include <algorithm>
@@ -194,7 +195,7 @@ const char *GetInternalTypeName(CorDebugInternalFrameType frameType)
 }
 
 HRESULT GetFrameLocation(ICorDebugFrame *pFrame, ThreadId threadId, FrameLevel level,
-                         DebugInfo *pDebugInfo, StackFrame &stackFrame)
+                         DebugInfo *pDebugInfo, Modules *pModules, StackFrame &stackFrame)
 {
     HRESULT Status = S_OK;
 
@@ -225,7 +226,13 @@ HRESULT GetFrameLocation(ICorDebugFrame *pFrame, ThreadId threadId, FrameLevel l
         stackFrame.endColumn = sp.endColumn;
     }
 
-    IfFailRet(Modules::GetModuleMvid(trModule, stackFrame.moduleId));
+    // Use module ID from registry, MVID calculation need metadata access for each frame.
+    CORDB_ADDRESS modAddress = 0;
+    if (FAILED(trModule->GetBaseAddress(&modAddress)) ||
+        FAILED(pModules->GetModuleId(modAddress, stackFrame.moduleId)))
+    {
+        IfFailRet(Modules::GetModuleMvid(trModule, stackFrame.moduleId));
+    }
 
     return S_OK;
 }
@@ -362,6 +369,12 @@ HRESULT WalkFrames(ICorDebugThread *pThread, DebugInfo *pDebugInfo, const WalkFr
             break;
         }
 
+        // Protocol command (stack trace request) was canceled.
+        if (CancellationToken::IsCurrentCanceled())
+        {
+            return COR_E_OPERATIONCANCELED;
+        }
+
         ToRelease<ICorDebugFrame> trFrame;
         if (FAILED(Status = trStackWalk->GetFrame(&trFrame)))
         {
@@ -628,7 +641,7 @@ HRESULT GetFrameAt(ICorDebugThread *pThread, FrameLevel level, DebugInfo *pDebug
 }
 
 HRESULT GetStackFrames(ICorDebugThread *pThread, ThreadId threadId, FrameLevel startFrame, unsigned maxFrames,
-                       DebugInfo *pDebugInfo, bool justMyCode, std::vector<StackFrame> &stackFrames)
+                       DebugInfo *pDebugInfo, Modules *pModules, bool justMyCode, std::vector<StackFrame> &stackFrames)
 {
     // CoreCLR native frame, could be part of transition to at least one user's native frame.
     static const std::string FrameCLRNativeText = "[CLR Native Frame]";
@@ -674,7 +687,7 @@ HRESULT GetStackFrames(ICorDebugThread *pThread, ThreadId threadId, FrameLevel s
 
     // Store all ICorDebugStackWalk frames output before calling ICorDebug API, since it could corrupt internal states.
     // For example, on macOS arm64 since .NET 9.0, ICorDebugFunction2::GetJMCStatus call breaks ICorDebugStackWalk.
-    WalkFrames(pThread, pDebugInfo,
+    const HRESULT walkStatus = WalkFrames(pThread, pDebugInfo,
         [&](FrameType frameType, ICorDebugFrame *pFrame, const PDB::SequencePoint *sequencePoint,
             const std::string *methodName, const std::string *sourceFilePath) -> HRESULT
         {
@@ -706,6 +719,10 @@ HRESULT GetStackFrames(ICorDebugThread *pThread, ThreadId threadId, FrameLevel s
 
             return S_OK; // Continue walk.
         });
+    if (walkStatus == COR_E_OPERATIONCANCELED)
+    {
+        return walkStatus;
+    }
 
     int currentFrame = -1;
     bool prevFrameExternal = false;
@@ -773,7 +790,7 @@ HRESULT GetStackFrames(ICorDebugThread *pThread, ThreadId threadId, FrameLevel s
         case FrameType::CLRManaged:
         {
             StackFrame stackFrame;
-            GetFrameLocation(frame.trFrame, threadId, FrameLevel{currentFrame}, pDebugInfo, stackFrame);
+            GetFrameLocation(frame.trFrame, threadId, FrameLevel{currentFrame}, pDebugInfo, pModules, stackFrame);
             stackFrames.push_back(stackFrame);
             break;
         }
@@ -800,4 +817,80 @@ HRESULT GetStackFrames(ICorDebugThread *pThread, ThreadId threadId, FrameLevel s
     return S_OK;
 }
 
+HRESULT GetFirstSourceLocation(ICorDebugThread *pThread, DebugInfo *pDebugInfo, bool justMyCode,
+                               Source &source, int &line, int &column)
+{
+    struct IntWalkFrame
+    {
+        FrameType frameType;
+        ToRelease<ICorDebugFrame> trFrame;
+        PDB::SequencePoint sequencePoint;
+        std::string sourceFilePath;
+
+        IntWalkFrame(FrameType frameType_, ICorDebugFrame *pFrame_)
+            : frameType(frameType_),
+              trFrame(pFrame_)
+        {
+        }
+    };
+
+    std::list<IntWalkFrame> walkFrames;
+    // Source location is searched in top frames only, usually this is logging related code and caller's frame.
+    static constexpr size_t walkFramesLimit = 32;
+
+    // Store ICorDebugStackWalk frames output before calling ICorDebug API, since it could corrupt internal states.
+    WalkFrames(pThread, pDebugInfo,
+        [&](FrameType frameType, ICorDebugFrame *pFrame, const PDB::SequencePoint *sequencePoint,
+            const std::string *, const std::string *sourceFilePath) -> HRESULT
+        {
+            if (frameType == FrameType::CLRManaged)
+            {
+                pFrame->AddRef();
+                walkFrames.emplace_back(frameType, pFrame);
+            }
+            else if (frameType == FrameType::CLRManagedExceptionUser)
+            {
+                walkFrames.emplace_back(frameType, nullptr);
+                walkFrames.back().sequencePoint = *sequencePoint;
+                walkFrames.back().sourceFilePath = *sourceFilePath;
+            }
+
+            return walkFrames.size() >= walkFramesLimit ? S_CAN_EXIT : S_OK;
+        });
+
+    for (auto &frame : walkFrames)
+    {
+        if (frame.frameType == FrameType::CLRManaged)
+        {
+            if (justMyCode)
+            {
+                ToRelease<ICorDebugFunction> trFunction;
+                ToRelease<ICorDebugFunction2> trFunction2;
+                BOOL JMCStatus = FALSE;
+                if (FAILED(frame.trFrame->GetFunction(&trFunction)) ||
+                    FAILED(trFunction->QueryInterface(IID_ICorDebugFunction2, reinterpret_cast<void **>(&trFunction2))) ||
+                    FAILED(trFunction2->GetJMCStatus(&JMCStatus)) ||
+                    JMCStatus == FALSE)
+                {
+                    continue;
+                }
+            }
+
+            PDB::GlobalFileIndex globalFileIndex;
+            if (FAILED(pDebugInfo->GetSequencePointByFrame(frame.trFrame, frame.sequencePoint, &globalFileIndex)) ||
+                FAILED(pDebugInfo->GetSourceFile(globalFileIndex, frame.sourceFilePath)))
+            {
+                continue;
+            }
+        }
+
+        source = Source(frame.sourceFilePath);
+        line = frame.sequencePoint.startLine;
+        column = frame.sequencePoint.startColumn;
+        return S_OK;
+    }
+
+    return E_FAIL;
+}
+
 } // namespace dncdbg
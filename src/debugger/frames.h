@@ -19,10 +19,14 @@ namespace dncdbg
 {
 
 class DebugInfo;
+class Modules;
 
 HRESULT GetFrameAt(ICorDebugThread *pThread, FrameLevel level, DebugInfo *pDebugInfo, bool justMyCode, ICorDebugFrame **ppFrame);
 HRESULT GetStackFrames(ICorDebugThread *pThread, ThreadId threadId, FrameLevel startFrame, unsigned maxFrames,
-                       DebugInfo *pDebugInfo, bool justMyCode, std::vector<StackFrame> &stackFrames);
+                       DebugInfo *pDebugInfo, Modules *pModules, bool justMyCode, std::vector<StackFrame> &stackFrames);
+// Find source location of first stack frame with source data (code with PDB/user code), without full stack trace creation.
+HRESULT GetFirstSourceLocation(ICorDebugThread *pThread, DebugInfo *pDebugInfo, bool justMyCode,
+                               Source &source, int &line, int &column);
 
 } // namespace dncdbg
 
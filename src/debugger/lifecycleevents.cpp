@@ -0,0 +1,152 @@
+// Copyright (c) 2026 Mikhail Kurinnoi
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "debugger/lifecycleevents.h"
+#include "protocol/dapio.h"
+#include "utils/logger.h"
+#include <unordered_map>
+
+namespace dncdbg
+{
+
+LifecycleEvents::LifecycleEvents()
+    : m_worker(m_mutex,
+               [this](Clock::time_point now, Clock::time_point &deadline) { return IsReady(now, deadline); },
+               [this](bool /*flush*/) { Deliver(); })
+{
+}
+
+LifecycleEvents::~LifecycleEvents()
+{
+    m_worker.Stop();
+}
+
+void LifecycleEvents::PushThreadEvent(ThreadEventReason reason, ThreadId threadId)
+{
+    Entry entry;
+    entry.threadReason = reason;
+    entry.threadId = threadId;
+
+    const std::scoped_lock<std::mutex> lock(m_mutex);
+    Store(std::move(entry));
+}
+
+void LifecycleEvents::PushModuleEvent(ModuleEventReason reason, const Module &module)
+{
+    Entry entry;
+    entry.isModule = true;
+    entry.moduleReason = reason;
+    entry.module = module;
+
+    const std::scoped_lock<std::mutex> lock(m_mutex);
+    Store(std::move(entry));
+}
+
+// Caller must hold m_mutex.
+void LifecycleEvents::Store(Entry &&entry)
+{
+    m_worker.Start();
+
+    if (m_entries.empty())
+    {
+        m_firstEntryTime = Clock::now();
+        m_worker.Notify();
+    }
+    m_entries.emplace_back(std::move(entry));
+    if (m_entries.size() == MaxBatchSize)
+    {
+        m_worker.Notify();
+    }
+}
+
+void LifecycleEvents::Flush()
+{
+    m_worker.Flush();
+}
+
+// Caller must hold m_mutex.
+bool LifecycleEvents::IsReady(Clock::time_point now, Clock::time_point &deadline) const
+{
+    if (m_entries.empty())
+    {
+        return false;
+    }
+
+    if (m_entries.size() < MaxBatchSize && now < m_firstEntryTime + BatchInterval)
+    {
+        deadline = m_firstEntryTime + BatchInterval;
+        return false;
+    }
+
+    return true;
+}
+
+// Called by m_worker with delivery lock held.
+void LifecycleEvents::Deliver()
+{
+    std::vector<Entry> entries;
+    {
+        const std::scoped_lock<std::mutex> lock(m_mutex);
+        entries.swap(m_entries);
+    }
+
+    if (entries.empty())
+    {
+        return;
+    }
+
+    // Find threads that started and exited in this burst. Note, stored events are delivered before any
+    // stopped event, so such thread was never shown as stopped.
+    std::unordered_map<int, size_t> startedIndex;
+    std::vector<bool> skip(entries.size(), false);
+    size_t skipped = 0;
+    for (size_t i = 0; i < entries.size(); ++i)
+    {
+        const Entry &entry = entries[i];
+        if (entry.isModule)
+        {
+            continue;
+        }
+
+        if (entry.threadReason == ThreadEventReason::Started)
+        {
+            startedIndex[static_cast<int>(entry.threadId)] = i;
+            continue;
+        }
+
+        auto find = startedIndex.find(static_cast<int>(entry.threadId));
+        if (find != startedIndex.end())
+        {
+            skip[find->second] = true;
+            skip[i] = true;
+            skipped += 2;
+            startedIndex.erase(find);
+        }
+    }
+
+    for (size_t i = 0; i < entries.size(); ++i)
+    {
+        if (skip[i])
+        {
+            continue;
+        }
+
+        const Entry &entry = entries[i];
+        if (entry.isModule)
+        {
+            DAPIO::EmitModuleEvent(ModuleEvent(entry.moduleReason, entry.module));
+        }
+        else
+        {
+            DAPIO::EmitThreadEvent(ThreadEvent(entry.threadReason, entry.threadId));
+        }
+    }
+
+    if (skipped != 0)
+    {
+        LOGD(log << "Skipped " << skipped << " events of short-lived threads");
+    }
+}
+
+} // namespace dncdbg
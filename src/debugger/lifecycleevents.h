@@ -0,0 +1,73 @@
+// Copyright (c) 2026 Mikhail Kurinnoi
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#ifndef DEBUGGER_LIFECYCLEEVENTS_H
+#define DEBUGGER_LIFECYCLEEVENTS_H
+
+#include "types/protocol.h"
+#include "utils/batchworker.h"
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace dncdbg
+{
+
+// LifecycleEvents delivers thread and module events.
+//
+// Managed callbacks (CreateThread, ExitThread, LoadModule, UnloadModule) only store event and continue
+// debuggee, events are emitted by worker thread in bursts: at `BatchInterval` after first stored event
+// or as soon as `MaxBatchSize` events stored. Started and exited events of short-lived thread, that
+// were stored in the same burst, are dropped both (IDE never saw this thread).
+class LifecycleEvents
+{
+  public:
+
+    static constexpr std::chrono::milliseconds BatchInterval{10};
+    static constexpr size_t MaxBatchSize = 256;
+
+    LifecycleEvents();
+    LifecycleEvents(LifecycleEvents &&) = delete;
+    LifecycleEvents(const LifecycleEvents &) = delete;
+    LifecycleEvents &operator=(LifecycleEvents &&) = delete;
+    LifecycleEvents &operator=(const LifecycleEvents &) = delete;
+    // Stop worker thread and deliver all stored events.
+    ~LifecycleEvents();
+
+    // Store event for delivery. Worker thread is started at first call.
+    void PushThreadEvent(ThreadEventReason reason, ThreadId threadId);
+    void PushModuleEvent(ModuleEventReason reason, const Module &module);
+
+    // Deliver all stored events now, must be called before events that refer threads or modules
+    // (stopped, exited) and before threads list provided to protocol.
+    void Flush();
+
+  private:
+
+    using Clock = BatchWorker::Clock;
+
+    struct Entry
+    {
+        bool isModule{false};
+        ThreadEventReason threadReason{ThreadEventReason::Started};
+        ThreadId threadId;
+        ModuleEventReason moduleReason{ModuleEventReason::New};
+        Module module;
+    };
+
+    std::mutex m_mutex;
+    std::vector<Entry> m_entries;
+    Clock::time_point m_firstEntryTime;
+    BatchWorker m_worker;
+
+    // Caller must hold m_mutex.
+    void Store(Entry &&entry);
+    bool IsReady(Clock::time_point now, Clock::time_point &deadline) const;
+    void Deliver();
+};
+
+} // namespace dncdbg
+
+#endif // DEBUGGER_LIFECYCLEEVENTS_H
@@ -0,0 +1,176 @@
+// Copyright (c) 2026 Mikhail Kurinnoi
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "debugger/logmessages.h"
+#include "protocol/dapio.h"
+#include "utils/allocationprofile.h"
+#include <string>
+
+namespace dncdbg
+{
+
+namespace
+{
+
+// Consecutive messages are not combined into output event bigger than this size.
+constexpr size_t maxCombinedOutputSize = 64 * 1024;
+
+} // unnamed namespace
+
+LogMessages::LogMessages()
+    : m_worker(m_mutex,
+               [this](Clock::time_point now, Clock::time_point &deadline) { return IsReady(now, deadline); },
+               [this](bool /*flush*/) { Deliver(); })
+{
+}
+
+LogMessages::~LogMessages()
+{
+    // Note, BatchWorker::Stop() don't close rate window, report suppressed messages first.
+    {
+        const std::scoped_lock<std::mutex> lock(m_mutex);
+        CloseRateWindow(Clock::now(), true);
+    }
+
+    m_worker.Stop();
+}
+
+void LogMessages::SetMaxMessagesPerSecond(uint32_t maxMessages)
+{
+    const std::scoped_lock<std::mutex> lock(m_mutex);
+    m_maxMessagesPerSecond = maxMessages;
+}
+
+bool LogMessages::Admit()
+{
+    const std::scoped_lock<std::mutex> lock(m_mutex);
+
+    CloseRateWindow(Clock::now(), false);
+
+    if (m_maxMessagesPerSecond == 0 || m_windowMessages < m_maxMessagesPerSecond)
+    {
+        ++m_windowMessages;
+        return true;
+    }
+
+    if (m_suppressed == 0)
+    {
+        m_worker.Notify();
+    }
+    ++m_suppressed;
+    return false;
+}
+
+void LogMessages::Push(const WCHAR *message, Source &&source, int line, int column)
+{
+    const std::scoped_lock<std::mutex> lock(m_mutex);
+
+    m_worker.Start();
+
+    const bool wasEmpty = m_entries.empty();
+    m_entries.push_back({WSTRING(message), std::move(source), line, column, 0});
+    if (wasEmpty)
+    {
+        m_worker.Notify();
+    }
+}
+
+void LogMessages::Flush()
+{
+    {
+        const std::scoped_lock<std::mutex> lock(m_mutex);
+        CloseRateWindow(Clock::now(), true);
+    }
+
+    m_worker.Flush();
+}
+
+// Caller must hold m_mutex.
+void LogMessages::CloseRateWindow(Clock::time_point now, bool force)
+{
+    const bool windowExpired = now - m_windowStart >= RateWindow;
+    if (!windowExpired && !force)
+    {
+        return;
+    }
+
+    if (m_suppressed != 0)
+    {
+        m_entries.push_back({{}, Source(), 0, 0, m_suppressed});
+        m_suppressed = 0;
+    }
+
+    if (windowExpired)
+    {
+        m_windowStart = now;
+        m_windowMessages = 0;
+    }
+}
+
+// Caller must hold m_mutex.
+bool LogMessages::IsReady(Clock::time_point now, Clock::time_point &deadline)
+{
+    CloseRateWindow(now, false);
+
+    if (!m_entries.empty())
+    {
+        return true;
+    }
+
+    if (m_suppressed != 0)
+    {
+        // Summary must be delivered at rate window end, even if no new messages.
+        deadline = m_windowStart + RateWindow;
+    }
+    return false;
+}
+
+// Called by m_worker with delivery lock held.
+void LogMessages::Deliver()
+{
+    // Messages conversion and output events are part of LogMessage callback processing.
+    const AllocationProfile::Scope allocationScope(AllocationProfile::Kind::Callback, "LogMessage");
+
+    std::vector<Entry> entries;
+    {
+        const std::scoped_lock<std::mutex> lock(m_mutex);
+        entries.swap(m_entries);
+    }
+
+    for (size_t i = 0; i < entries.size(); ++i)
+    {
+        const Entry &entry = entries.at(i);
+        if (entry.suppressed != 0)
+        {
+            DAPIO::EmitOutputEvent(OutputEvent(OutputCategory::Console,
+                std::to_string(entry.suppressed) + " Debugger.Log() messages were suppressed, messages per second limit reached.\n"));
+            continue;
+        }
+
+        OutputEvent event(OutputCategory::StdOut, to_utf8(entry.message.c_str()) + '\n');
+        event.source = entry.source;
+        event.line = entry.line;
+        event.column = entry.column;
+
+        // Combine consecutive messages from the same source location.
+        while (i + 1 < entries.size() && event.output.size() < maxCombinedOutputSize)
+        {
+            const Entry &next = entries.at(i + 1);
+            if (next.suppressed != 0 ||
+                next.source.path != entry.source.path ||
+                next.line != entry.line ||
+                next.column != entry.column)
+            {
+                break;
+            }
+            event.output += to_utf8(next.message.c_str());
+            event.output += '\n';
+            ++i;
+        }
+
+        DAPIO::EmitOutputEvent(event);
+    }
+}
+
+} // namespace dncdbg
@@ -0,0 +1,85 @@
+// Copyright (c) 2026 Mikhail Kurinnoi
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#ifndef DEBUGGER_LOGMESSAGES_H
+#define DEBUGGER_LOGMESSAGES_H
+
+#include "types/protocol.h"
+#include "utils/batchworker.h"
+#include "utils/utf.h"
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace dncdbg
+{
+
+// LogMessages delivers debuggee `Debugger.Log()` messages as output events.
+//
+// ManagedCallback::LogMessage() only stores message with its source location and continues debuggee,
+// UTF-8 conversion and output events emission are done by worker thread. Consecutive messages with the
+// same source location are combined into one output event.
+// Amount of messages per second is limited (see SetMaxMessagesPerSecond()), suppressed messages are
+// not stored at all and reported by one summary output event per second.
+class LogMessages
+{
+  public:
+
+    static constexpr uint32_t DefaultMaxMessagesPerSecond = 1000;
+
+    LogMessages();
+    LogMessages(LogMessages &&) = delete;
+    LogMessages(const LogMessages &) = delete;
+    LogMessages &operator=(LogMessages &&) = delete;
+    LogMessages &operator=(const LogMessages &) = delete;
+    // Stop worker thread and deliver all stored messages.
+    ~LogMessages();
+
+    // Zero means no limit.
+    void SetMaxMessagesPerSecond(uint32_t maxMessages);
+
+    // Check rate limit for new message. Returns `false` in case message must be suppressed,
+    // so caller could skip source location search.
+    bool Admit();
+
+    // Store admitted message for delivery. Worker thread is started at first call.
+    void Push(const WCHAR *message, Source &&source, int line, int column);
+
+    // Deliver all stored messages (and suppressed messages summary) now.
+    void Flush();
+
+  private:
+
+    using Clock = BatchWorker::Clock;
+    static constexpr auto RateWindow = std::chrono::seconds(1);
+
+    struct Entry
+    {
+        WSTRING message;
+        Source source;
+        int line{0};
+        int column{0};
+        uint64_t suppressed{0}; // Not zero for suppressed messages summary entry.
+    };
+
+    std::mutex m_mutex;
+    std::vector<Entry> m_entries;
+
+    uint32_t m_maxMessagesPerSecond{DefaultMaxMessagesPerSecond};
+    Clock::time_point m_windowStart;
+    uint32_t m_windowMessages{0};
+    uint64_t m_suppressed{0};
+
+    BatchWorker m_worker;
+
+    // Caller must hold m_mutex.
+    void CloseRateWindow(Clock::time_point now, bool force);
+    bool IsReady(Clock::time_point now, Clock::time_point &deadline);
+    void Deliver();
+};
+
+} // namespace dncdbg
+
+#endif // DEBUGGER_LOGMESSAGES_H
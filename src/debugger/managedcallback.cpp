@@ -13,12 +13,15 @@
 #include "debugger/callbacksqueue.h"
 #include "debugger/evalstackmachine.h" // NOLINT(misc-include-cleaner)
 #include "debugger/evalwaiter.h" // NOLINT(misc-include-cleaner)
+#include "debugger/frames.h"
 #include "debugger/threads.h"
 #include "debuginfo/debuginfo.h" // NOLINT(misc-include-cleaner)
 #include "metadata/modules.h" // NOLINT(misc-include-cleaner)
 #include "protocol/dapio.h"
+#include "utils/allocationprofile.h"
 #include "utils/logger.h"
 #include "utils/kqueue.h" // NOLINT(misc-include-cleaner)
+#include "utils/startupprofile.h"
 #include "utils/waitpid.h" // NOLINT(misc-include-cleaner)
 #include "utils/utf.h"
 
@@ -109,6 +112,7 @@ ULONG STDMETHODCALLTYPE ManagedCallback::Release()
 HRESULT STDMETHODCALLTYPE ManagedCallback::Breakpoint(ICorDebugAppDomain *pAppDomain, ICorDebugThread *pThread,
                                                       ICorDebugBreakpoint *pBreakpoint)
 {
+    const AllocationProfile::Scope allocationScope(AllocationProfile::Kind::Callback, "Breakpoint");
     return m_sharedCallbacksQueue->AddCallbackToQueue(pAppDomain, [&]() {
         pAppDomain->AddRef();
         pThread->AddRef();
@@ -121,6 +125,7 @@ HRESULT STDMETHODCALLTYPE ManagedCallback::Breakpoint(ICorDebugAppDomain *pAppDo
 HRESULT STDMETHODCALLTYPE ManagedCallback::StepComplete(ICorDebugAppDomain *pAppDomain, ICorDebugThread *pThread,
                                                         ICorDebugStepper */*pStepper*/, CorDebugStepReason reason)
 {
+    const AllocationProfile::Scope allocationScope(AllocationProfile::Kind::Callback, "StepComplete");
     return m_sharedCallbacksQueue->AddCallbackToQueue(pAppDomain, [&]() {
         pAppDomain->AddRef();
         pThread->AddRef();
@@ -131,6 +136,7 @@ HRESULT STDMETHODCALLTYPE ManagedCallback::StepComplete(ICorDebugAppDomain *pApp
 
 HRESULT STDMETHODCALLTYPE ManagedCallback::Break(ICorDebugAppDomain *pAppDomain, ICorDebugThread *pThread)
 {
+    const AllocationProfile::Scope allocationScope(AllocationProfile::Kind::Callback, "Break");
     return m_sharedCallbacksQueue->AddCallbackToQueue(pAppDomain, [&]() {
         pAppDomain->AddRef();
         pThread->AddRef();
@@ -141,18 +147,21 @@ HRESULT STDMETHODCALLTYPE ManagedCallback::Break(ICorDebugAppDomain *pAppDomain,
 
 HRESULT STDMETHODCALLTYPE ManagedCallback::Exception(ICorDebugAppDomain *pAppDomain, ICorDebugThread */*pThread*/, BOOL /*unhandled*/)
 {
+    const StartupProfile::CallbackTimer callbackTimer;
     // Obsolete callback
     return m_sharedCallbacksQueue->ContinueAppDomain(pAppDomain);
 }
 
 HRESULT STDMETHODCALLTYPE ManagedCallback::EvalComplete(ICorDebugAppDomain */*pAppDomain*/, ICorDebugThread *pThread, ICorDebugEval *pEval)
 {
+    const AllocationProfile::Scope allocationScope(AllocationProfile::Kind::Callback, "EvalComplete");
     m_debugger.m_sharedEvalWaiter->NotifyEvalComplete(pThread, pEval);
     return S_OK; // Eval-related routine - no callbacks queue related code here.
 }
 
 HRESULT STDMETHODCALLTYPE ManagedCallback::EvalException(ICorDebugAppDomain */*pAppDomain*/, ICorDebugThread *pThread, ICorDebugEval *pEval)
 {
+    const AllocationProfile::Scope allocationScope(AllocationProfile::Kind::Callback, "EvalException");
     m_debugger.m_sharedEvalWaiter->NotifyEvalComplete(pThread, pEval);
     return S_OK; // Eval-related routine - no callbacks queue related code here.
 }
@@ -167,6 +176,7 @@ HRESULT STDMETHODCALLTYPE ManagedCallback::CreateProcess(ICorDebugProcess *pProc
     // In case of `attach`, NotifyProcessCreated() call will notify debugger that debuggee process attached and debugger
     // should stop debuggee process by direct `Pause()` call. From another side, callback queue has a bunch of asynchronous
     // added entries and, for example, `CreateThread()` could be called after this callback and break our debugger logic.
+    const StartupProfile::Clock::time_point start = StartupProfile::Now();
     ToRelease<ICorDebugAppDomainEnum> trAppDomainEnum;
     ToRelease<ICorDebugAppDomain> trAppDomain;
     ULONG domainsFetched = 0;
@@ -182,11 +192,14 @@ HRESULT STDMETHODCALLTYPE ManagedCallback::CreateProcess(ICorDebugProcess *pProc
         }
     }
 
+    // Note, queued callback time is accounted by callbacks queue from arrival, account here only direct continue.
+    StartupProfile::AddCallbackTime(StartupProfile::Now() - start);
     return m_sharedCallbacksQueue->ContinueProcess(pProcess);
 }
 
 HRESULT STDMETHODCALLTYPE ManagedCallback::ExitProcess([[maybe_unused]] ICorDebugProcess *pProcess)
 {
+    const AllocationProfile::Scope allocationScope(AllocationProfile::Kind::Callback, "ExitProcess");
     if (m_debugger.m_sharedEvalWaiter->IsEvalRunning())
     {
         LOGW(log << "The target process exited while evaluating the function.");
@@ -215,6 +228,7 @@ HRESULT STDMETHODCALLTYPE ManagedCallback::ExitProcess([[maybe_unused]] ICorDebu
     }
 #endif
 
+    m_debugger.FlushOutput();
     DAPIO::EmitExitedEvent(ExitedEvent(exitCode));
     m_debugger.NotifyProcessExited();
     DAPIO::EmitTerminatedEvent();
@@ -223,6 +237,8 @@ HRESULT STDMETHODCALLTYPE ManagedCallback::ExitProcess([[maybe_unused]] ICorDebu
 
 HRESULT STDMETHODCALLTYPE ManagedCallback::CreateThread(ICorDebugAppDomain *pAppDomain, ICorDebugThread *pThread)
 {
+    const StartupProfile::CallbackTimer callbackTimer;
+    const AllocationProfile::Scope allocationScope(AllocationProfile::Kind::Callback, "CreateThread");
     if (m_debugger.m_sharedEvalWaiter->IsEvalRunning())
     {
         LOGW(log << "Thread was created by user code during evaluation with implicit user code execution.");
@@ -231,12 +247,14 @@ HRESULT STDMETHODCALLTYPE ManagedCallback::CreateThread(ICorDebugAppDomain *pApp
     const ThreadId threadId(getThreadId(pThread));
     m_debugger.m_sharedThreads->Add(m_debugger.m_sharedEvaluator, pThread, threadId, m_debugger.m_startMethod == StartMethod::Attach);
 
-    DAPIO::EmitThreadEvent(ThreadEvent(ThreadEventReason::Started, threadId));
+    m_debugger.m_lifecycleEvents.PushThreadEvent(ThreadEventReason::Started, threadId);
     return m_sharedCallbacksQueue->ContinueAppDomain(pAppDomain);
 }
 
 HRESULT STDMETHODCALLTYPE ManagedCallback::ExitThread(ICorDebugAppDomain *pAppDomain, ICorDebugThread *pThread)
 {
+    const StartupProfile::CallbackTimer callbackTimer;
+    const AllocationProfile::Scope allocationScope(AllocationProfile::Kind::Callback, "ExitThread");
     const ThreadId threadId(getThreadId(pThread));
     m_debugger.m_sharedThreads->Remove(threadId);
 
@@ -248,20 +266,33 @@ HRESULT STDMETHODCALLTYPE ManagedCallback::ExitThread(ICorDebugAppDomain *pAppDo
 
     m_debugger.m_sharedBreakpoints->ManagedCallbackExitThread(pThread);
 
-    DAPIO::EmitThreadEvent(ThreadEvent(ThreadEventReason::Exited, threadId));
+    m_debugger.m_lifecycleEvents.PushThreadEvent(ThreadEventReason::Exited, threadId);
     return m_sharedCallbacksQueue->ContinueAppDomain(pAppDomain);
 }
 
 HRESULT STDMETHODCALLTYPE ManagedCallback::LoadModule(ICorDebugAppDomain *pAppDomain, ICorDebugModule *pModule)
 {
-    Module &module = m_debugger.m_sharedModules->GetNewModuleRef();
-    m_debugger.m_sharedDebugInfo->TryLoadModuleSymbols(pModule, module);
-    // Note, LoadModuleMetadata() must be called after debug info (symbols) load.
-    Modules::LoadModuleMetadata(pModule, module, m_debugger.IsJustMyCode(), m_debugger.IsSuppressJITOptimizations());
-    DAPIO::EmitModuleEvent(ModuleEvent(ModuleEventReason::New, module));
+    const StartupProfile::CallbackTimer callbackTimer;
+    const AllocationProfile::Scope allocationScope(AllocationProfile::Kind::Callback, "LoadModule");
+    StartupProfile::ModuleScope profileScope;
+
+    Module module;
+    {
+        const StartupProfile::PhaseTimer phaseTimer(StartupProfile::Phase::PDBIndexing);
+        m_debugger.m_sharedDebugInfo->TryLoadModuleSymbols(pModule, module);
+    }
+    {
+        const StartupProfile::PhaseTimer phaseTimer(StartupProfile::Phase::Metadata);
+        // Note, LoadModuleMetadata() must be called after debug info (symbols) load.
+        Modules::LoadModuleMetadata(pModule, module, m_debugger.IsJustMyCode(), m_debugger.IsSuppressJITOptimizations());
+    }
+    profileScope.SetName(module.name);
+    m_debugger.m_sharedModules->AddModule(pModule, module);
+    m_debugger.m_lifecycleEvents.PushModuleEvent(ModuleEventReason::New, module);
 
     if (module.symbolStatus == SymbolStatus::Loaded)
     {
+        const StartupProfile::PhaseTimer phaseTimer(StartupProfile::Phase::BreakpointBinding);
 #ifdef DEBUG_INTERNAL_TESTS
         const size_t bpCountBeforeLoad = m_debugger.m_sharedBreakpoints->GetBreakpointsCount();
 #endif // DEBUG_INTERNAL_TESTS
@@ -282,20 +313,25 @@ HRESULT STDMETHODCALLTYPE ManagedCallback::LoadModule(ICorDebugAppDomain *pAppDo
         m_debugger.m_sharedEvalStackMachine->FindPredefinedTypes(pModule);
     }
 
-    m_debugger.m_sharedEvaluator->ManagedCallbackLoadModule(pModule);
+    {
+        const StartupProfile::PhaseTimer phaseTimer(StartupProfile::Phase::ExtensionMethods);
+        m_debugger.m_sharedEvaluator->ManagedCallbackLoadModule(pModule);
+    }
 
     return m_sharedCallbacksQueue->ContinueAppDomain(pAppDomain);
 }
 
 HRESULT STDMETHODCALLTYPE ManagedCallback::UnloadModule(ICorDebugAppDomain *pAppDomain, ICorDebugModule *pModule)
 {
+    const StartupProfile::CallbackTimer callbackTimer;
+    const AllocationProfile::Scope allocationScope(AllocationProfile::Kind::Callback, "UnloadModule");
     m_debugger.m_sharedBreakpoints->ManagedCallbackUnloadModule(pModule);
     m_debugger.m_sharedEvaluator->ManagedCallbackUnloadModule(pModule);
 
     Module removedModule;
     if (SUCCEEDED(m_debugger.m_sharedModules->RemoveModule(pModule, removedModule)))
     {
-        DAPIO::EmitModuleEvent(ModuleEvent(ModuleEventReason::Removed, removedModule));
+        m_debugger.m_lifecycleEvents.PushModuleEvent(ModuleEventReason::Removed, removedModule);
     }
 
     m_debugger.m_sharedDebugInfo->UnloadModuleSymbols(pModule);
@@ -305,16 +341,20 @@ HRESULT STDMETHODCALLTYPE ManagedCallback::UnloadModule(ICorDebugAppDomain *pApp
 
 HRESULT STDMETHODCALLTYPE ManagedCallback::LoadClass(ICorDebugAppDomain *pAppDomain, ICorDebugClass */*pClass*/)
 {
+    const StartupProfile::CallbackTimer callbackTimer;
+    const AllocationProfile::Scope allocationScope(AllocationProfile::Kind::Callback, "LoadClass");
     return m_sharedCallbacksQueue->ContinueAppDomain(pAppDomain);
 }
 
 HRESULT STDMETHODCALLTYPE ManagedCallback::UnloadClass(ICorDebugAppDomain *pAppDomain, ICorDebugClass */*pClass*/)
 {
+    const StartupProfile::CallbackTimer callbackTimer;
     return m_sharedCallbacksQueue->ContinueAppDomain(pAppDomain);
 }
 
 HRESULT STDMETHODCALLTYPE ManagedCallback::DebuggerError(ICorDebugProcess *pProcess, HRESULT /*errorHR*/, DWORD /*errorCode*/)
 {
+    const StartupProfile::CallbackTimer callbackTimer;
     return m_sharedCallbacksQueue->ContinueProcess(pProcess);
 }
 
@@ -327,65 +367,64 @@ HRESULT STDMETHODCALLTYPE ManagedCallback::LogMessage(ICorDebugAppDomain *pAppDo
         return S_OK;
     }
 
-    OutputEvent event(OutputCategory::StdOut, to_utf8(pMessage) + '\n');
-
-    DWORD threadId = 0;
-    pThread->GetID(&threadId);
-    std::vector<StackFrame> stackFrames;
-    if ((threadId != 0U) &&
-        SUCCEEDED(m_debugger.GetStackTrace(ThreadId(threadId), FrameLevel(0), 0, stackFrames)))
+    const StartupProfile::CallbackTimer callbackTimer;
+    const AllocationProfile::Scope allocationScope(AllocationProfile::Kind::Callback, "LogMessage");
+    // Note, message is only stored here, conversion and output event emission are done by LogMessages worker thread.
+    if (m_debugger.m_logMessages.Admit())
     {
-        // Find first frame with source file data (code with PDB/user code).
-        auto it = std::find_if(stackFrames.begin(), stackFrames.end(),
-                               [](const StackFrame &stackFrame)
-                               {
-                                   return !stackFrame.source.IsNull();
-                               });
-        if (it != stackFrames.end())
-        {
-            event.source = it->source;
-            event.line = it->line;
-            event.column = it->column;
-        }
+        Source source;
+        int line = 0;
+        int column = 0;
+        GetFirstSourceLocation(pThread, m_debugger.m_sharedDebugInfo.get(), m_debugger.IsJustMyCode(), source, line, column);
+        m_debugger.m_logMessages.Push(pMessage, std::move(source), line, column);
     }
 
-    DAPIO::EmitOutputEvent(event);
     return m_sharedCallbacksQueue->ContinueAppDomain(pAppDomain);
 }
 
 HRESULT STDMETHODCALLTYPE ManagedCallback::LogSwitch(ICorDebugAppDomain *pAppDomain, ICorDebugThread */*pThread*/, LONG /*lLevel*/,
                                                      ULONG /*ulReason*/, WCHAR */*pLogSwitchName*/, WCHAR */*pParentName*/)
 {
+    const StartupProfile::CallbackTimer callbackTimer;
     return m_sharedCallbacksQueue->ContinueAppDomain(pAppDomain);
 }
 
 HRESULT STDMETHODCALLTYPE ManagedCallback::CreateAppDomain(ICorDebugProcess *pProcess, ICorDebugAppDomain */*pAppDomain*/)
 {
+    const StartupProfile::CallbackTimer callbackTimer;
+    const AllocationProfile::Scope allocationScope(AllocationProfile::Kind::Callback, "CreateAppDomain");
     return m_sharedCallbacksQueue->ContinueProcess(pProcess);
 }
 
 HRESULT STDMETHODCALLTYPE ManagedCallback::ExitAppDomain(ICorDebugProcess *pProcess, ICorDebugAppDomain */*pAppDomain*/)
 {
+    const StartupProfile::CallbackTimer callbackTimer;
     return m_sharedCallbacksQueue->ContinueProcess(pProcess);
 }
 
 HRESULT STDMETHODCALLTYPE ManagedCallback::LoadAssembly(ICorDebugAppDomain *pAppDomain, ICorDebugAssembly */*pAssembly*/)
 {
+    const StartupProfile::CallbackTimer callbackTimer;
+    const AllocationProfile::Scope allocationScope(AllocationProfile::Kind::Callback, "LoadAssembly");
     return m_sharedCallbacksQueue->ContinueAppDomain(pAppDomain);
 }
 
 HRESULT STDMETHODCALLTYPE ManagedCallback::UnloadAssembly(ICorDebugAppDomain *pAppDomain, ICorDebugAssembly */*pAssembly*/)
 {
+    const StartupProfile::CallbackTimer callbackTimer;
     return m_sharedCallbacksQueue->ContinueAppDomain(pAppDomain);
 }
 
 HRESULT STDMETHODCALLTYPE ManagedCallback::ControlCTrap(ICorDebugProcess *pProcess)
 {
+    const StartupProfile::CallbackTimer callbackTimer;
     return m_sharedCallbacksQueue->ContinueProcess(pProcess);
 }
 
 HRESULT STDMETHODCALLTYPE ManagedCallback::NameChange(ICorDebugAppDomain *pAppDomain, ICorDebugThread *pThread)
 {
+    const StartupProfile::CallbackTimer callbackTimer;
+    const AllocationProfile::Scope allocationScope(AllocationProfile::Kind::Callback, "NameChange");
     m_debugger.m_sharedThreads->ChangeName(m_debugger.m_sharedEvaluator, pThread);
     return m_sharedCallbacksQueue->ContinueAppDomain(pAppDomain);
 }
@@ -393,18 +432,21 @@ HRESULT STDMETHODCALLTYPE ManagedCallback::NameChange(ICorDebugAppDomain *pAppDo
 HRESULT STDMETHODCALLTYPE ManagedCallback::UpdateModuleSymbols(ICorDebugAppDomain *pAppDomain, ICorDebugModule */*pModule*/,
                                                                IStream */*pSymbolStream*/)
 {
+    const StartupProfile::CallbackTimer callbackTimer;
     return m_sharedCallbacksQueue->ContinueAppDomain(pAppDomain);
 }
 
 HRESULT STDMETHODCALLTYPE ManagedCallback::EditAndContinueRemap(ICorDebugAppDomain *pAppDomain, ICorDebugThread */*pThread*/,
                                                                 ICorDebugFunction */*pFunction*/, BOOL /*fAccurate*/)
 {
+    const StartupProfile::CallbackTimer callbackTimer;
     return m_sharedCallbacksQueue->ContinueAppDomain(pAppDomain);
 }
 
 HRESULT STDMETHODCALLTYPE ManagedCallback::BreakpointSetError(ICorDebugAppDomain *pAppDomain, ICorDebugThread */*pThread*/,
                                                               ICorDebugBreakpoint */*pBreakpoint*/, DWORD /*dwError*/)
 {
+    const StartupProfile::CallbackTimer callbackTimer;
     return m_sharedCallbacksQueue->ContinueAppDomain(pAppDomain);
 }
 
@@ -414,22 +456,26 @@ HRESULT STDMETHODCALLTYPE ManagedCallback::FunctionRemapOpportunity(ICorDebugApp
                                                                     ICorDebugFunction */*pOldFunction*/,
                                                                     ICorDebugFunction */*pNewFunction*/, uint32_t /*oldILOffset*/)
 {
+    const StartupProfile::CallbackTimer callbackTimer;
     return m_sharedCallbacksQueue->ContinueAppDomain(pAppDomain);
 }
 
 HRESULT STDMETHODCALLTYPE ManagedCallback::CreateConnection(ICorDebugProcess *pProcess, CONNID /*dwConnectionId*/,
                                                             WCHAR */*pConnName*/)
 {
+    const StartupProfile::CallbackTimer callbackTimer;
     return m_sharedCallbacksQueue->ContinueProcess(pProcess);
 }
 
 HRESULT STDMETHODCALLTYPE ManagedCallback::ChangeConnection(ICorDebugProcess *pProcess, CONNID /*dwConnectionId*/)
 {
+    const StartupProfile::CallbackTimer callbackTimer;
     return m_sharedCallbacksQueue->ContinueProcess(pProcess);
 }
 
 HRESULT STDMETHODCALLTYPE ManagedCallback::DestroyConnection(ICorDebugProcess *pProcess, CONNID /*dwConnectionId*/)
 {
+    const StartupProfile::CallbackTimer callbackTimer;
     return m_sharedCallbacksQueue->ContinueProcess(pProcess);
 }
 
@@ -437,6 +483,7 @@ HRESULT STDMETHODCALLTYPE ManagedCallback::Exception(ICorDebugAppDomain *pAppDom
                                                      ICorDebugFrame *pFrame, uint32_t /*nOffset*/,
                                                      CorDebugExceptionCallbackType dwEventType, DWORD /*dwFlags*/)
 {
+    const AllocationProfile::Scope allocationScope(AllocationProfile::Kind::Callback, "Exception");
     return m_sharedCallbacksQueue->AddCallbackToQueue(pAppDomain, [&]() {
         // pFrame could be neutered in case of evaluation during break, do all stuff with pFrame in callback itself.
         ExceptionCallbackType eventType = ExceptionCallbackType::UNKNOWN;
@@ -469,18 +516,22 @@ HRESULT STDMETHODCALLTYPE ManagedCallback::ExceptionUnwind(ICorDebugAppDomain *p
                                                            CorDebugExceptionUnwindCallbackType /*dwEventType*/,
                                                            DWORD /*dwFlags*/)
 {
+    const StartupProfile::CallbackTimer callbackTimer;
+    const AllocationProfile::Scope allocationScope(AllocationProfile::Kind::Callback, "ExceptionUnwind");
     return m_sharedCallbacksQueue->ContinueAppDomain(pAppDomain);
 }
 
 HRESULT STDMETHODCALLTYPE ManagedCallback::FunctionRemapComplete(ICorDebugAppDomain *pAppDomain,
                                                                  ICorDebugThread */*pThread*/, ICorDebugFunction */*pFunction*/)
 {
+    const StartupProfile::CallbackTimer callbackTimer;
     return m_sharedCallbacksQueue->ContinueAppDomain(pAppDomain);
 }
 
 HRESULT STDMETHODCALLTYPE ManagedCallback::MDANotification(ICorDebugController */*pController*/, ICorDebugThread *pThread,
                                                            ICorDebugMDA */*pMDA*/)
 {
+    const StartupProfile::CallbackTimer callbackTimer;
     ToRelease<ICorDebugProcess> trProcess;
     pThread->GetProcess(&trProcess);
     return m_sharedCallbacksQueue->ContinueProcess(trProcess);
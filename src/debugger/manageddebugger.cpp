@@ -28,7 +28,10 @@
 #include "utils/waitpid.h" // NOLINT(misc-include-cleaner)
 #include "utils/logger.h"
 #include "utils/platform.h"
+#include "utils/print.h"
+#include "utils/startupprofile.h"
 #include "utils/utf.h"
+#include <algorithm>
 #include <array>
 #include <chrono>
 #include <map>
@@ -52,6 +55,12 @@ namespace
 {
 
 constexpr auto startupWaitTimeout = std::chrono::milliseconds(5000);
+// Debuggee output delivery is paused while IDE don't read protocol messages (see OutputCoalescer).
+constexpr size_t outputBusyThreshold = 4 * 1024 * 1024;
+// `readMemory` request reads debuggee memory by chunks, in case chunk can't be read - page by page.
+constexpr size_t readMemoryChunkSize = 64 * 1024;
+constexpr size_t readMemoryPageSize = 4096;
+constexpr uint64_t readMemoryMaxSize = 16 * 1024 * 1024;
 
 HRESULT GetSystemEnvironmentAsMap(std::map<std::string, std::string> &outMap)
 {
@@ -306,6 +315,21 @@ ManagedDebugger::ManagedDebugger()
       m_sharedBreakpoints(new Breakpoints(m_sharedDebugInfo, m_sharedEvaluator, m_sharedEvalStackMachine)),
       m_sharedCallbacksQueue(nullptr),
       m_uniqueManagedCallback(nullptr),
+      m_outputCoalescer(
+            [](IORedirect::StreamType type, std::string &&text)
+            {
+                DAPIO::EmitOutputEvent(OutputEvent(type == IORedirect::StreamType::Stderr ? OutputCategory::StdErr : OutputCategory::StdOut, std::move(text)));
+            },
+            [](IORedirect::StreamType type, size_t droppedBytes)
+            {
+                DAPIO::EmitOutputEvent(OutputEvent(OutputCategory::Console,
+                    std::to_string(droppedBytes) + " bytes of debuggee " + (type == IORedirect::StreamType::Stderr ? "stderr" : "stdout") +
+                    " output were dropped, output backlog limit reached.\n"));
+            },
+            []()
+            {
+                return DAPIO::GetPendingOutputSize() > outputBusyThreshold;
+            }),
       m_ioredirect([this](IORedirect::StreamType type, gsl::span<char> text)
             {
                 InputCallback(type, text);
@@ -316,6 +340,7 @@ ManagedDebugger::ManagedDebugger()
 
 ManagedDebugger::~ManagedDebugger()
 {
+    StartupProfile::Stop();
     m_sharedEvalStackMachine->ResetEval();
 }
 
@@ -330,6 +355,12 @@ HRESULT ManagedDebugger::ConfigurationDone()
 {
     FrameId::invalidate();
 
+    // Note, debuggee is started (or attached) by this request, all modules are loaded after this point.
+    StartupProfile::Start(m_startupReportDelay, [](const std::string &report)
+    {
+        DAPIO::EmitOutputEvent({OutputCategory::Console, report});
+    });
+
     switch (m_startMethod)
     {
     case StartMethod::Launch:
@@ -363,6 +394,8 @@ HRESULT ManagedDebugger::Launch(const std::string &fileExec, const std::vector<s
 
 HRESULT ManagedDebugger::Disconnect(DisconnectAction action)
 {
+    StartupProfile::Stop();
+
     bool terminate = false;
     switch (action)
     {
@@ -502,6 +535,8 @@ HRESULT ManagedDebugger::Pause(ThreadId lastStoppedThread)
 
 HRESULT ManagedDebugger::GetThreads(std::vector<Thread> &threads)
 {
+    // Make sure IDE know all threads from list (have thread started events) before response.
+    m_lifecycleEvents.Flush();
     return m_sharedThreads->GetThreads(threads);
 }
 
@@ -866,11 +901,10 @@ HRESULT ManagedDebugger::GetStackTrace(ThreadId threadId, FrameLevel startFrame,
     IfFailRet(CheckDebugProcess());
 
     ToRelease<ICorDebugThread> trThread;
-    if (SUCCEEDED(Status = m_trProcess->GetThread(static_cast<int>(threadId), &trThread)))
-    {
-        return GetStackFrames(trThread, threadId, startFrame, maxFrames, m_sharedDebugInfo.get(), IsJustMyCode(), stackFrames);
-    }
+    IfFailRet(m_trProcess->GetThread(static_cast<int>(threadId), &trThread));
+    IfFailRet(GetStackFrames(trThread, threadId, startFrame, maxFrames, m_sharedDebugInfo.get(), m_sharedModules.get(), IsJustMyCode(), stackFrames));
 
+    m_sharedCallbacksQueue->NotifyStackTraceResponse();
     return Status;
 }
 
@@ -942,18 +976,36 @@ void ManagedDebugger::SetStepFiltering(bool enable)
     m_uniqueSteppers->SetStepFiltering(enable);
 }
 
+void ManagedDebugger::SetMemoryReferences(bool enable)
+{
+    m_sharedVariables->SetMemoryReferences(enable);
+}
+
 void ManagedDebugger::SetEvalFlags(uint32_t evalFlags)
 {
     m_sharedEvalHelpers->SetEvalFlags(evalFlags);
     m_sharedEvaluator->SetEvalFlags(evalFlags);
 }
 
+void ManagedDebugger::SetOutputOptions(size_t readBufferSize, const OutputCoalescer::Options &options)
+{
+    m_ioredirect.SetReadBufferSize(readBufferSize);
+    m_outputCoalescer.SetOptions(options);
+}
+
 void ManagedDebugger::InputCallback(IORedirect::StreamType type, gsl::span<char> text)
 {
-    DAPIO::EmitOutputEvent(OutputEvent(type == IORedirect::StreamType::Stderr ? OutputCategory::StdErr : OutputCategory::StdOut, {text.data(), text.size()}));
+    m_outputCoalescer.Append(type, text);
     m_remoteConsoleServer.SendData(text);
 }
 
+void ManagedDebugger::FlushOutput()
+{
+    m_lifecycleEvents.Flush();
+    m_outputCoalescer.Flush();
+    m_logMessages.Flush();
+}
+
 void ManagedDebugger::WriteStdin(gsl::span<const char> text)
 {
     m_ioredirect.WriteStdin(text);
@@ -968,9 +1020,68 @@ bool ManagedDebugger::InitializeRemoteConsoleServer(int port)
         });
 }
 
+HRESULT ManagedDebugger::ReadMemory(uint64_t address, uint64_t count, std::string &data, size_t &unreadableBytes)
+{
+    const ReadLock r_lock(m_debugProcessRWLock);
+    HRESULT Status = S_OK;
+    IfFailRet(CheckDebugProcess());
+
+    // Note, protocol allow return less bytes than requested.
+    const size_t size = static_cast<size_t>(std::min(count, readMemoryMaxSize));
+    std::vector<uint8_t> buffer(size);
+
+    size_t readSize = 0;
+    while (readSize < size)
+    {
+        const CORDB_ADDRESS chunkAddress = address + readSize;
+        // Align chunk end to page boundary, so next chunks read whole pages.
+        size_t chunkSize = readMemoryChunkSize - static_cast<size_t>(chunkAddress % readMemoryPageSize);
+        chunkSize = std::min(chunkSize, size - readSize);
+        SIZE_T read = 0;
+        if (SUCCEEDED(m_trProcess->ReadMemory(chunkAddress, static_cast<DWORD>(chunkSize), buffer.data() + readSize, &read)) &&
+            read == chunkSize)
+        {
+            readSize += chunkSize;
+            continue;
+        }
+
+        // Find first unreadable page in chunk.
+        const size_t chunkEnd = readSize + chunkSize;
+        while (readSize < chunkEnd)
+        {
+            const CORDB_ADDRESS pageAddress = address + readSize;
+            const size_t pageSize = std::min(readMemoryPageSize - static_cast<size_t>(pageAddress % readMemoryPageSize), chunkEnd - readSize);
+            read = 0;
+            if (FAILED(m_trProcess->ReadMemory(pageAddress, static_cast<DWORD>(pageSize), buffer.data() + readSize, &read)) ||
+                read != pageSize)
+            {
+                break;
+            }
+            readSize += pageSize;
+        }
+        break;
+    }
+
+    unreadableBytes = size - readSize;
+    data.clear();
+    AppendBase64(buffer.data(), readSize, data);
+
+    return S_OK;
+}
+
 void ManagedDebugger::GetModules(int startModule, int moduleCount, std::vector<Module> &modules, size_t &totalModules)
 {
     m_sharedModules->GetModules(startModule, moduleCount, modules, totalModules);
 }
 
+void ManagedDebugger::SetSymbolsIndexesBudget(size_t budget)
+{
+    m_sharedDebugInfo->SetSymbolsIndexesBudget(budget);
+}
+
+void ManagedDebugger::GetSymbolsMemory(std::vector<ModuleSymbolsMemory> &modules)
+{
+    m_sharedDebugInfo->GetSymbolsMemory(modules);
+}
+
 } // namespace dncdbg
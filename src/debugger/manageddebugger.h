@@ -12,14 +12,18 @@
 #include <specstrings_undef.h>
 #endif
 
+#include "debugger/lifecycleevents.h"
+#include "debugger/logmessages.h"
 #include "types/types.h"
 #include "types/protocol.h"
 #include "utils/ioredirect.h"
 #include "utils/dbgshim.h"
+#include "utils/outputcoalescer.h"
 #include "utils/remote_console.h"
 #include "utils/rwlock.h"
 #include "utils/torelease.h"
 #include <gsl/span>
+#include <chrono>
 #include <condition_variable>
 #include <map>
 #include <vector>
@@ -39,6 +43,7 @@ class CallbacksQueue;
 class Breakpoints;
 class DebugInfo;
 class Modules;
+struct ModuleSymbolsMemory;
 
 enum class ProcessAttachedState : uint8_t
 {
@@ -74,6 +79,7 @@ class ManagedDebugger
         return m_stepFiltering;
     }
     void SetStepFiltering(bool enable);
+    void SetMemoryReferences(bool enable);
     void SetEvalFlags(uint32_t evalFlags);
 
     [[nodiscard]] bool IsSuppressJITOptimizations() const
@@ -84,6 +90,16 @@ class ManagedDebugger
     {
         m_suppressJITOptimizations = enable;
     }
+    void SetOutputOptions(size_t readBufferSize, const OutputCoalescer::Options &options);
+    void SetMaxLogMessagesPerSecond(uint32_t maxMessages)
+    {
+        m_logMessages.SetMaxMessagesPerSecond(maxMessages);
+    }
+    // Write startup profile report after `configurationDone` with delay, zero delay disables report.
+    void SetStartupReportDelay(std::chrono::seconds delay)
+    {
+        m_startupReportDelay = delay;
+    }
 
     HRESULT Initialize();
     HRESULT Attach(DWORD pid);
@@ -116,6 +132,11 @@ class ManagedDebugger
     HRESULT SetExpression(FrameId frameId, const std::string &expression, const std::string &value, std::string &output);
     HRESULT GetExceptionInfo(ThreadId threadId, ExceptionInfo &exceptionInfo);
     void GetModules(int startModule, int moduleCount, std::vector<Module> &modules, size_t &totalModules);
+    // Derived symbols indexes memory budget in bytes, zero - no limit (see DebugInfo::SetSymbolsIndexesBudget()).
+    void SetSymbolsIndexesBudget(size_t budget);
+    void GetSymbolsMemory(std::vector<ModuleSymbolsMemory> &modules);
+    // Read debuggee memory, `data` is base64 encoded, `unreadableBytes` is number of bytes at the end that can't be read.
+    HRESULT ReadMemory(uint64_t address, uint64_t count, std::string &data, size_t &unreadableBytes);
 
     void WriteStdin(gsl::span<const char> text);
     bool InitializeRemoteConsoleServer(int port);
@@ -166,10 +187,14 @@ class ManagedDebugger
     bool m_justMyCode{true};
     bool m_stepFiltering{true};
     bool m_suppressJITOptimizations{false};
+    std::chrono::seconds m_startupReportDelay{0};
 
     void *m_unregisterToken{nullptr};
     DWORD m_processId{0};
     dbgshim_t m_dbgshim;
+    LifecycleEvents m_lifecycleEvents;
+    LogMessages m_logMessages;
+    OutputCoalescer m_outputCoalescer; // Note, must be destroyed after m_ioredirect.
     IORedirect m_ioredirect;
     RemoteConsoleServer m_remoteConsoleServer;
 
@@ -177,6 +202,8 @@ class ManagedDebugger
     bool HaveDebugProcess();
 
     void InputCallback(IORedirect::StreamType type, gsl::span<char> text);
+    // Deliver collected thread/module events, debuggee output and log messages, must be called before stop and exit events emission.
+    void FlushOutput();
 
     void Cleanup();
     void DisableAllBreakpointsAndSteppers();
@@ -400,70 +400,6 @@ HRESULT PrintArrayValue(ICorDebugValue *pValue, std::string &output)
     return S_OK;
 }
 
-void EscapeString(std::string &s, char q = '\"')
-{
-    for (std::size_t i = 0; i < s.size(); ++i)
-    {
-        int count = 0;
-        const char c = s.at(i);
-        switch (c)
-        {
-        case '\'':
-        case '\"':
-            count = c != q ? 0 : 1;
-            s.insert(i, count, '\\');
-            break;
-        case '\\':
-            count = 1;
-            s.insert(i, count, '\\');
-            break;
-        case '\0':
-            count = 1;
-            s.insert(i, count, '\\');
-            s.at(i + count) = '0';
-            break;
-        case '\a':
-            count = 1;
-            s.insert(i, count, '\\');
-            s.at(i + count) = 'a';
-            break;
-        case '\b':
-            count = 1;
-            s.insert(i, count, '\\');
-            s.at(i + count) = 'b';
-            break;
-        case '\f':
-            count = 1;
-            s.insert(i, count, '\\');
-            s.at(i + count) = 'f';
-            break;
-        case '\n':
-            count = 1;
-            s.insert(i, count, '\\');
-            s.at(i + count) = 'n';
-            break;
-        case '\r':
-            count = 1;
-            s.insert(i, count, '\\');
-            s.at(i + count) = 'r';
-            break;
-        case '\t':
-            count = 1;
-            s.insert(i, count, '\\');
-            s.at(i + count) = 't';
-            break;
-        case '\v':
-            count = 1;
-            s.insert(i, count, '\\');
-            s.at(i + count) = 'v';
-            break;
-        default:
-            break;
-        }
-        i += count;
-    }
-}
-
 } // unnamed namespace
 
 HRESULT PrintStringValue(ICorDebugValue *pValue, std::string &output)
@@ -590,11 +526,11 @@ HRESULT PrintValue(ICorDebugThread *pThread, Evaluator *pEvaluator, ICorDebugVal
             }
 
             // Same behavior as MS vsdbg and MSVS C# debugger have - add character escaping in strings.
-            EscapeString(raw_str, '"');
-
-            std::ostringstream ss;
-            ss << '\"' << raw_str << '\"';
-            output = ss.str();
+            output.clear();
+            output.reserve(raw_str.size() + 2);
+            output.push_back('\"');
+            output += EscapeString(raw_str, '"');
+            output.push_back('\"');
             return S_OK;
         }
 
@@ -733,8 +669,7 @@ HRESULT PrintValue(ICorDebugThread *pThread, Evaluator *pEvaluator, ICorDebugVal
                 return S_OK;
             }
             // Same behavior as MS vsdbg and MSVS C# debugger have - add character escaping for chars.
-            EscapeString(printableVal, '\'');
-            ss << static_cast<unsigned int>(wstr.at(0)) << " '" << printableVal << "'";
+            ss << static_cast<unsigned int>(wstr.at(0)) << " '" << EscapeString(printableVal, '\'') << "'";
             break;
         }
 
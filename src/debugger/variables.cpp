@@ -10,7 +10,10 @@
 #include "debugger/valueprint.h"
 #include "types/types.h"
 #include "metadata/typeprinter.h"
+#include "utils/cancellation.h"
 #include "utils/hresult.h"
+#include "utils/metrics.h"
+#include "utils/print.h"
 #include <unordered_set>
 #include <vector>
 
@@ -128,6 +131,11 @@ HRESULT FetchFieldsAndProperties(Evaluator *pEvaluator, ICorDebugValue *pInputVa
                 return S_OK;
             }
 
+            if (CancellationToken::IsCurrentCanceled())
+            {
+                return COR_E_OPERATIONCANCELED;
+            }
+
             // Note, in this case error is not fatal, but if protocol side need cancel command execution, stop walk and return error to caller.
             ToRelease<ICorDebugValue> trResultValue;
             if (getValue(&trResultValue, nullptr, false) == COR_E_OPERATIONCANCELED)
@@ -148,6 +156,60 @@ HRESULT FetchFieldsAndProperties(Evaluator *pEvaluator, ICorDebugValue *pInputVa
     return S_OK;
 }
 
+// Memory reference for `readMemory` request: pointer target, array elements or string object.
+void SetMemoryReference(ICorDebugValue *pValue, Variable &variable)
+{
+    CorElementType corType = ELEMENT_TYPE_END;
+    if (pValue == nullptr || FAILED(pValue->GetType(&corType)))
+    {
+        return;
+    }
+
+    CORDB_ADDRESS address = 0;
+    if (corType == ELEMENT_TYPE_PTR)
+    {
+        ToRelease<ICorDebugReferenceValue> trReferenceValue;
+        if (FAILED(pValue->QueryInterface(IID_ICorDebugReferenceValue, reinterpret_cast<void **>(&trReferenceValue))) ||
+            FAILED(trReferenceValue->GetValue(&address)))
+        {
+            return;
+        }
+    }
+    else if (corType == ELEMENT_TYPE_SZARRAY || corType == ELEMENT_TYPE_ARRAY)
+    {
+        ToRelease<ICorDebugValue> trValue;
+        BOOL isNull = FALSE;
+        ToRelease<ICorDebugArrayValue> trArrayValue;
+        uint32_t elementsCount = 0;
+        ToRelease<ICorDebugValue> trElementValue;
+        if (FAILED(DereferenceAndUnboxValue(pValue, &trValue, &isNull)) || isNull == TRUE ||
+            FAILED(trValue->QueryInterface(IID_ICorDebugArrayValue, reinterpret_cast<void **>(&trArrayValue))) ||
+            FAILED(trArrayValue->GetCount(&elementsCount)) || elementsCount == 0 ||
+            FAILED(trArrayValue->GetElementAtPosition(0, &trElementValue)) ||
+            FAILED(trElementValue->GetAddress(&address)))
+        {
+            return;
+        }
+    }
+    else if (corType == ELEMENT_TYPE_STRING)
+    {
+        ToRelease<ICorDebugValue> trValue;
+        BOOL isNull = FALSE;
+        ToRelease<ICorDebugHeapValue> trHeapValue;
+        if (FAILED(DereferenceAndUnboxValue(pValue, &trValue, &isNull)) || isNull == TRUE ||
+            FAILED(trValue->QueryInterface(IID_ICorDebugHeapValue, reinterpret_cast<void **>(&trHeapValue))) ||
+            FAILED(trHeapValue->GetAddress(&address)))
+        {
+            return;
+        }
+    }
+
+    if (address != 0)
+    {
+        variable.memoryReference = PrintAddress(address);
+    }
+}
+
 void FixupInheritedFieldNames(std::vector<VariableMember> &members)
 {
     std::unordered_set<std::string> names;
@@ -167,6 +229,8 @@ void FixupInheritedFieldNames(std::vector<VariableMember> &members)
 HRESULT Variables::GetVariables(ICorDebugProcess *pProcess, uint32_t variablesReference, VariablesFilter filter,
                                 int start, int count, std::vector<Variable> &variables)
 {
+    Metrics::Add(Metrics::Counter::VariablesRequests);
+    const Metrics::ScopedTimer requestTimer(Metrics::Histogram::VariablesRequestTimeUs);
     const std::scoped_lock<std::recursive_mutex> lock(m_referencesMutex);
 
     auto it = m_references.find(variablesReference);
@@ -206,6 +270,12 @@ HRESULT Variables::GetVariables(ICorDebugProcess *pProcess, uint32_t variablesRe
 HRESULT Variables::AddVariableReference(ICorDebugThread *pThread, Variable &variable, FrameId frameId,
                                         ICorDebugValue *pValue, ValueKind valueKind)
 {
+    // Note, pseudo-variables (like "Static members") refer the same value as parent variable.
+    if (m_memoryReferences && valueKind == ValueKind::Variable)
+    {
+        SetMemoryReference(pValue, variable);
+    }
+
     const std::scoped_lock<std::recursive_mutex> lock(m_referencesMutex);
 
     if (m_references.size() == std::numeric_limits<uint32_t>::max())
@@ -228,6 +298,7 @@ HRESULT Variables::AddVariableReference(ICorDebugThread *pThread, Variable &vari
     pValue->AddRef();
     VariableReference variableReference(variable, frameId, pValue, valueKind);
     m_references.emplace(variable.variablesReference, std::move(variableReference));
+    Metrics::Add(Metrics::Counter::VariableReferences);
 
     return S_OK;
 }
@@ -274,6 +345,10 @@ HRESULT Variables::GetStackVariables(FrameId frameId, ICorDebugThread *pThread,
             {
                 return S_CAN_EXIT; // Fast exit from loop.
             }
+            if (CancellationToken::IsCurrentCanceled())
+            {
+                return COR_E_OPERATIONCANCELED;
+            }
 
             Variable var;
             var.name = name;
@@ -350,6 +425,7 @@ HRESULT Variables::GetScopes(ICorDebugProcess *pProcess, FrameId frameId, std::v
         variablesReference = static_cast<uint32_t>(m_references.size()) + 1;
         VariableReference scopeReference(variablesReference, frameId, namedVariables);
         m_references.emplace(variablesReference, std::move(scopeReference));
+        Metrics::Add(Metrics::Counter::VariableReferences);
     }
 
     scopes.emplace_back(variablesReference, "Locals", namedVariables);
@@ -381,6 +457,11 @@ HRESULT Variables::GetChildren(const VariableReference &ref, ICorDebugThread *pT
 
     for (auto &it : members)
     {
+        if (CancellationToken::IsCurrentCanceled())
+        {
+            return COR_E_OPERATIONCANCELED;
+        }
+
         Variable var;
         var.name = it.name;
         const bool isIndex = !it.name.empty() && it.name.at(0) == '[';
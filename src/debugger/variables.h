@@ -55,6 +55,12 @@ class Variables
 
     HRESULT GetExceptionVariable(FrameId frameId, ICorDebugThread *pThread, Variable &variable);
 
+    // Provide `memoryReference` for arrays, strings and pointers (client must support memory references).
+    void SetMemoryReferences(bool enable)
+    {
+        m_memoryReferences = enable;
+    }
+
     void Cleanup()
     {
         m_referencesMutex.lock();
@@ -118,6 +124,8 @@ class Variables
     std::shared_ptr<Evaluator> m_sharedEvaluator;
     std::shared_ptr<EvalStackMachine> m_sharedEvalStackMachine;
 
+    bool m_memoryReferences{false};
+
     std::recursive_mutex m_referencesMutex;
     std::unordered_map<uint32_t, VariableReference> m_references;
 
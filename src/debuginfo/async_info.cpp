@@ -7,38 +7,74 @@
 #include "debuginfo/debuginfo.h"
 #include "debuginfo/pdbreader.h"
 #include "utils/hresult.h"
+#include "utils/metrics.h"
 
 namespace dncdbg
 {
 
 // Caller must hold m_asyncMethodSteppingInfoMutex.
-HRESULT AsyncInfo::GetAsyncMethodSteppingInfo(CORDB_ADDRESS modAddress, mdMethodDef methodToken)
+const AsyncInfo::AsyncMethodInfo *AsyncInfo::GetAsyncMethodSteppingInfo(CORDB_ADDRESS modAddress, mdMethodDef methodToken)
 {
     // Note, for normal methods, `PDBReader::GetAsyncMethodSteppingInfo()` will return error code.
     // Error during async info search (debug info not available or method token belongs to a normal method) is proper
     // behavior and debugger logic also counts on this.
 
-    if (asyncMethodSteppingInfo.modAddress == modAddress && asyncMethodSteppingInfo.methodToken == methodToken)
+    auto find = m_asyncMethodsIndex.find(MethodKey{modAddress, methodToken});
+
+    AsyncMethodInfo info;
+    const HRESULT result = m_sharedDebugInfo->GetPDBInfo(modAddress,
+        [&](const PDBInfo &pdbInfo) -> HRESULT
+        {
+            const uint32_t rid = RidFromToken(methodToken);
+            if (rid >= pdbInfo.m_asyncMethods.size() || !pdbInfo.m_asyncMethods[rid])
+            {
+                return E_FAIL;
+            }
+
+            if (find != m_asyncMethodsIndex.end() && find->second->loadId == pdbInfo.m_loadId)
+            {
+                return S_FALSE; // Already cached.
+            }
+
+            HRESULT Status = S_OK;
+            info.loadId = pdbInfo.m_loadId;
+            IfFailRet(PDBReader::GetAsyncMethodSteppingInfo(pdbInfo.m_pdbHandle, methodToken, info.awaits));
+            return PDBReader::GetLastIlOffset(pdbInfo.m_pdbHandle, methodToken, info.lastIlOffset);
+        });
+
+    if (FAILED(result))
     {
-        return asyncMethodSteppingInfo.retCode;
+        return nullptr;
     }
 
-    if (!asyncMethodSteppingInfo.awaits.empty())
+    if (result == S_FALSE)
     {
-        asyncMethodSteppingInfo.awaits.clear();
+        Metrics::Add(Metrics::Counter::AsyncInfoHits);
+        m_asyncMethods.splice(m_asyncMethods.begin(), m_asyncMethods, find->second);
+        return &m_asyncMethods.front();
     }
 
-    asyncMethodSteppingInfo.modAddress = modAddress;
-    asyncMethodSteppingInfo.methodToken = methodToken;
-    asyncMethodSteppingInfo.retCode = m_sharedDebugInfo->GetPDBInfo(modAddress,
-        [&](const PDBInfo &pdbInfo) -> HRESULT
-        {
-            HRESULT Status = S_OK;
-            IfFailRet(PDBReader::GetAsyncMethodSteppingInfo(pdbInfo.m_pdbHandle, methodToken, asyncMethodSteppingInfo.awaits));
-            return PDBReader::GetLastIlOffset(pdbInfo.m_pdbHandle, methodToken, asyncMethodSteppingInfo.lastIlOffset);
-        });
+    // Stored info is outdated (module was unloaded and other module or the same one loaded again at the same address).
+    if (find != m_asyncMethodsIndex.end())
+    {
+        m_asyncMethods.erase(find->second);
+        m_asyncMethodsIndex.erase(find);
+    }
+
+    Metrics::Add(Metrics::Counter::AsyncInfoMisses);
+    info.modAddress = modAddress;
+    info.methodToken = methodToken;
+    m_asyncMethods.emplace_front(std::move(info));
+    m_asyncMethodsIndex.emplace(MethodKey{modAddress, methodToken}, m_asyncMethods.begin());
+
+    if (m_asyncMethods.size() > MaxCachedMethods)
+    {
+        const AsyncMethodInfo &last = m_asyncMethods.back();
+        m_asyncMethodsIndex.erase(MethodKey{last.modAddress, last.methodToken});
+        m_asyncMethods.pop_back();
+    }
 
-    return asyncMethodSteppingInfo.retCode;
+    return &m_asyncMethods.front();
 }
 
 // Check if method have await block. In this way we detect async method with awaits.
@@ -48,7 +84,7 @@ bool AsyncInfo::IsMethodHaveAwait(CORDB_ADDRESS modAddress, mdMethodDef methodTo
 {
     const std::scoped_lock<std::mutex> lock(m_asyncMethodSteppingInfoMutex);
 
-    return SUCCEEDED(GetAsyncMethodSteppingInfo(modAddress, methodToken));
+    return GetAsyncMethodSteppingInfo(modAddress, methodToken) != nullptr;
 }
 
 // Find await block after IL offset in particular async method and return await info, if present.
@@ -61,12 +97,13 @@ bool AsyncInfo::FindNextAwaitInfo(CORDB_ADDRESS modAddress, mdMethodDef methodTo
 {
     const std::scoped_lock<std::mutex> lock(m_asyncMethodSteppingInfoMutex);
 
-    if (FAILED(GetAsyncMethodSteppingInfo(modAddress, methodToken)))
+    const AsyncMethodInfo *asyncMethodInfo = GetAsyncMethodSteppingInfo(modAddress, methodToken);
+    if (asyncMethodInfo == nullptr)
     {
         return false;
     }
 
-    for (auto &await : asyncMethodSteppingInfo.awaits)
+    for (const auto &await : asyncMethodInfo->awaits)
     {
         if (ipOffset <= await.yieldOffset)
         {
@@ -93,12 +130,13 @@ bool AsyncInfo::FindLastIlOffsetAwaitInfo(CORDB_ADDRESS modAddress, mdMethodDef
 {
     const std::scoped_lock<std::mutex> lock(m_asyncMethodSteppingInfoMutex);
 
-    if (FAILED(GetAsyncMethodSteppingInfo(modAddress, methodToken)))
+    const AsyncMethodInfo *asyncMethodInfo = GetAsyncMethodSteppingInfo(modAddress, methodToken);
+    if (asyncMethodInfo == nullptr)
     {
         return false;
     }
 
-    lastIlOffset = asyncMethodSteppingInfo.lastIlOffset;
+    lastIlOffset = asyncMethodInfo->lastIlOffset;
     return true;
 }
 
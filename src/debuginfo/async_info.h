@@ -13,8 +13,10 @@
 #endif
 
 #include "debuginfo/pdb.h"
+#include <list>
 #include <memory>
 #include <mutex>
+#include <unordered_map>
 #include <vector>
 
 namespace dncdbg
@@ -22,10 +24,14 @@ namespace dncdbg
 
 class DebugInfo;
 
+// Async stepping info (await yield/resume offsets and last user code IL offset) of recently used async methods.
+// Methods without async stepping info are filtered out by PDBInfo::m_asyncMethods bitset, without PDB access.
 class AsyncInfo
 {
   public:
 
+    static constexpr size_t MaxCachedMethods = 64;
+
     explicit AsyncInfo(std::shared_ptr<DebugInfo> &sharedDebugInfo)
         : m_sharedDebugInfo(sharedDebugInfo)
     {
@@ -43,17 +49,42 @@ class AsyncInfo
     {
         CORDB_ADDRESS modAddress{0};
         mdMethodDef methodToken{mdMethodDefNil};
-        HRESULT retCode{S_OK};
+        // Symbols load of module, that was loaded at modAddress, then info was stored (module could be unloaded and
+        // same or other module loaded at the same address), see PDBInfo::m_loadId.
+        uint64_t loadId{0};
 
         std::vector<PDB::AsyncAwaitInfoBlock> awaits;
         // Part of NotifyDebuggerOfWaitCompletion magic, see ManagedDebugger::SetupAsyncStep().
         uint32_t lastIlOffset{0};
     };
 
-    AsyncMethodInfo asyncMethodSteppingInfo;
+    struct MethodKey
+    {
+        CORDB_ADDRESS modAddress;
+        mdMethodDef methodToken;
+
+        bool operator==(const MethodKey &other) const
+        {
+            return modAddress == other.modAddress && methodToken == other.methodToken;
+        }
+    };
+
+    struct MethodKeyHash
+    {
+        std::size_t operator()(const MethodKey &key) const
+        {
+            const std::size_t h1 = std::hash<CORDB_ADDRESS>{}(key.modAddress);
+            const std::size_t h2 = std::hash<uint32_t>{}(key.methodToken);
+            return h1 ^ (h2 << 1);
+        }
+    };
+
     std::mutex m_asyncMethodSteppingInfoMutex;
-    // Note, result stored into asyncMethodSteppingInfo.
-    HRESULT GetAsyncMethodSteppingInfo(CORDB_ADDRESS modAddress, mdMethodDef methodToken);
+    std::list<AsyncMethodInfo> m_asyncMethods; // Most recently used first.
+    std::unordered_map<MethodKey, std::list<AsyncMethodInfo>::iterator, MethodKeyHash> m_asyncMethodsIndex;
+
+    // Caller must hold m_asyncMethodSteppingInfoMutex.
+    const AsyncMethodInfo *GetAsyncMethodSteppingInfo(CORDB_ADDRESS modAddress, mdMethodDef methodToken);
 };
 
 } // namespace dncdbg
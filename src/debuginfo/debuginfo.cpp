@@ -6,14 +6,21 @@
 #include "debuginfo/debuginfo.h"
 #include "debuginfo/debugsources.h"
 #include "debuginfo/pdbreader.h"
+#include "debuginfo/symbolscache.h"
 #include "metadata/modules.h"
 #include "metadata/typeprinter.h"
 #include "protocol/dapio.h"
 #include "utils/filesystem.h"
 #include "utils/hresult.h"
+#include "utils/logger.h"
+#include "utils/metrics.h"
+#include "utils/startupprofile.h"
 #include "utils/utftoupper.h"
 #include <algorithm>
+#include <climits>
 #include <cstring>
+#include <iterator>
+#include <optional>
 #include <vector>
 
 namespace dncdbg
@@ -187,12 +194,9 @@ HRESULT ResolveMethodInModule(ICorDebugModule *pModule, const std::string &funcN
     return ForEachMethod(pModule, functor);
 }
 
-HRESULT LoadPDB(ICorDebugModule *pModule, mdhandle_t &pdbHandle, MemoryBuffer &memBuff, std::string &pdbFilePath, std::vector<uint8_t> &embeddedPDB)
+HRESULT LoadPDB(ICorDebugModule *pModule, const PDB::Identity &pdbId, mdhandle_t &pdbHandle, MemoryBuffer &memBuff,
+                std::string &pdbFilePath, std::vector<uint8_t> &embeddedPDB)
 {
-    HRESULT Status = S_OK;
-    PDB::Identity pdbId;
-    IfFailRet(Modules::GetModulePdbInfo(pModule, pdbId, pdbFilePath, embeddedPDB));
-
     if (!embeddedPDB.empty())
     {
         return md_create_handle(embeddedPDB.data(), static_cast<uint32_t>(embeddedPDB.size()), &pdbHandle) ? S_OK : E_FAIL;
@@ -258,19 +262,225 @@ std::string CanonicalizeFilePath(const std::string &filePath)
     return result;
 }
 
+int64_t GetPDBDataSize(const PDBInfo &pdbInfo)
+{
+    return static_cast<int64_t>(pdbInfo.m_memBuff.Size() + pdbInfo.m_embeddedPDB.size());
+}
+
+// Estimation of unordered container memory: nodes (value, next pointer and cached hash) and buckets array.
+template <class Map>
+size_t GetHashMapSize(const Map &map)
+{
+    return map.size() * (sizeof(typename Map::value_type) + 2 * sizeof(void *)) + map.bucket_count() * sizeof(void *);
+}
+
+size_t GetSourceNamesSize(const PDBInfo &pdbInfo)
+{
+    size_t size = GetHashMapSize(pdbInfo.m_sourceFileNameToIndices);
+    for (const auto &[name, indices] : pdbInfo.m_sourceFileNameToIndices)
+    {
+        size += name.capacity() +
+                static_cast<size_t>(std::distance(indices.begin(), indices.end())) * (sizeof(uint32_t) + sizeof(void *));
+    }
+    return size;
+}
+
+size_t GetIndexesSize(const PDBInfo &pdbInfo)
+{
+    size_t size = GetHashMapSize(pdbInfo.m_sourceMethodRanges) + GetHashMapSize(pdbInfo.m_moveNextToKickoff) +
+                  GetHashMapSize(pdbInfo.m_kickoffToMoveNext) + pdbInfo.m_asyncMethods.capacity() / CHAR_BIT;
+    for (const auto &[sourceFileIndex, methodRanges] : pdbInfo.m_sourceMethodRanges)
+    {
+        size += methodRanges.capacity() * sizeof(PDB::MethodRanges::value_type);
+        for (const auto &nestedLevel : methodRanges)
+        {
+            size += nestedLevel.capacity() * sizeof(PDB::MethodRange);
+        }
+    }
+    return size;
+}
+
+// Load derived indexes, that could be evicted and rebuilt on demand (see DebugInfo::SetSymbolsIndexesBudget()).
+HRESULT LoadPDBIndexes(ICorDebugModule *pModule, PDBInfo &pdbInfo)
+{
+    const HRESULT Status = DebugSources::FillMethodRanges(pModule, pdbInfo.m_pdbHandle, pdbInfo.m_sourceMethodRanges);
+    PDBReader::GetStateMachineMethods(pdbInfo.m_pdbHandle, pdbInfo.m_moveNextToKickoff, pdbInfo.m_kickoffToMoveNext);
+    PDBReader::GetAsyncMethods(pdbInfo.m_pdbHandle, pdbInfo.m_asyncMethods);
+    pdbInfo.m_indexesEvicted = false;
+    return Status;
+}
+
+void EvictPDBIndexes(PDBInfo &pdbInfo)
+{
+    // Note, swap with empty containers, since clear() don't release buckets and capacity.
+    PDB::SourceMethodRanges().swap(pdbInfo.m_sourceMethodRanges);
+    std::unordered_map<uint32_t, uint32_t>().swap(pdbInfo.m_moveNextToKickoff);
+    std::unordered_map<uint32_t, uint32_t>().swap(pdbInfo.m_kickoffToMoveNext);
+    std::vector<bool>().swap(pdbInfo.m_asyncMethods);
+    pdbInfo.m_indexesEvicted = true;
+}
+
 } // unnamed namespace
 
 void DebugInfo::Cleanup()
 {
     const std::scoped_lock<std::mutex> lock(m_debugInfoMutex);
+    for (auto &[modAddress, pdbInfo] : m_debugInfo)
+    {
+        Metrics::Add(Metrics::Counter::SymbolsBytesLoaded, -GetPDBDataSize(pdbInfo));
+        SymbolsCache::Put(std::move(pdbInfo));
+    }
     m_debugInfo.clear();
+    m_modulesState.clear();
+    m_indexesTotalSize = 0;
+}
+
+void DebugInfo::SetSymbolsIndexesBudget(size_t budget)
+{
+    const std::scoped_lock<std::mutex> lock(m_debugInfoMutex);
+    m_symbolsIndexesBudget = budget;
+    EnforceSymbolsIndexesBudget(0);
+}
+
+void DebugInfo::GetSymbolsMemory(std::vector<ModuleSymbolsMemory> &modules)
+{
+    std::vector<std::pair<uint64_t, ModuleSymbolsMemory>> modulesByUse;
+    {
+        const std::scoped_lock<std::mutex> lock(m_debugInfoMutex);
+        for (const auto &[modAddress, pdbInfo] : m_debugInfo)
+        {
+            ModuleSymbolsMemory module;
+            module.modAddress = modAddress;
+            module.symbolFilePath = pdbInfo.m_symbolFilePath;
+            module.pdbDataSize = static_cast<size_t>(GetPDBDataSize(pdbInfo));
+            module.sourceNamesSize = GetSourceNamesSize(pdbInfo);
+            module.indexesEvicted = pdbInfo.m_indexesEvicted;
+            uint64_t lastUse = 0;
+            auto findState = m_modulesState.find(modAddress);
+            if (findState != m_modulesState.end())
+            {
+                module.indexesSize = findState->second.indexesSize + findState->second.userCodeILOffsetsSize;
+                lastUse = findState->second.lastUse;
+            }
+            modulesByUse.emplace_back(lastUse, std::move(module));
+        }
+    }
+
+    std::sort(modulesByUse.begin(), modulesByUse.end(),
+              [](const auto &a, const auto &b) { return a.first > b.first; });
+    modules.clear();
+    modules.reserve(modulesByUse.size());
+    for (auto &entry : modulesByUse)
+    {
+        modules.emplace_back(std::move(entry.second));
+    }
+}
+
+// Caller must hold m_debugInfoMutex.
+void DebugInfo::UseModule(CORDB_ADDRESS modAddress, PDBInfo &pdbInfo)
+{
+    ModuleState &state = m_modulesState[modAddress];
+    state.lastUse = ++m_useCounter;
+    if (!pdbInfo.m_indexesEvicted)
+    {
+        return;
+    }
+
+    Metrics::Add(Metrics::Counter::SymbolsIndexesRebuilt);
+    if (FAILED(LoadPDBIndexes(pdbInfo.m_trModule, pdbInfo)))
+    {
+        LOGW(log << "Could not rebuild source lines related info from PDB file " << pdbInfo.m_symbolFilePath);
+    }
+    state.indexesSize = GetIndexesSize(pdbInfo);
+    m_indexesTotalSize += state.indexesSize;
+    EnforceSymbolsIndexesBudget(modAddress);
+}
+
+// Caller must hold m_debugInfoMutex.
+void DebugInfo::RemoveModuleState(CORDB_ADDRESS modAddress)
+{
+    auto find = m_modulesState.find(modAddress);
+    if (find == m_modulesState.end())
+    {
+        return;
+    }
+
+    m_indexesTotalSize -= find->second.indexesSize + find->second.userCodeILOffsetsSize;
+    m_modulesState.erase(find);
+}
+
+void DebugInfo::SelectIndexesEviction(std::vector<ModuleIndexesUse> &modules, size_t indexesTotalSize, size_t budget,
+                                      std::vector<CORDB_ADDRESS> &evicted)
+{
+    evicted.clear();
+    if (budget == 0 || indexesTotalSize <= budget)
+    {
+        return;
+    }
+
+    const size_t lowWatermark = budget - budget / IndexesBudgetHysteresis;
+    std::sort(modules.begin(), modules.end(),
+              [](const ModuleIndexesUse &a, const ModuleIndexesUse &b) { return a.lastUse < b.lastUse; });
+    for (const ModuleIndexesUse &module : modules)
+    {
+        if (indexesTotalSize <= lowWatermark)
+        {
+            break;
+        }
+
+        evicted.emplace_back(module.modAddress);
+        indexesTotalSize -= module.indexesSize;
+    }
+}
+
+// Caller must hold m_debugInfoMutex.
+void DebugInfo::EnforceSymbolsIndexesBudget(CORDB_ADDRESS usedModAddress)
+{
+    if (m_symbolsIndexesBudget == 0 || m_indexesTotalSize <= m_symbolsIndexesBudget)
+    {
+        return;
+    }
+
+    // Note, indexes of module that is used now are never evicted, caller could hold references to them.
+    std::vector<ModuleIndexesUse> candidates;
+    for (const auto &[modAddress, state] : m_modulesState)
+    {
+        if (modAddress != usedModAddress && (state.indexesSize != 0 || state.userCodeILOffsetsSize != 0))
+        {
+            candidates.push_back({modAddress, state.lastUse, state.indexesSize + state.userCodeILOffsetsSize});
+        }
+    }
+    std::vector<CORDB_ADDRESS> evicted;
+    SelectIndexesEviction(candidates, m_indexesTotalSize, m_symbolsIndexesBudget, evicted);
+
+    for (const CORDB_ADDRESS modAddress : evicted)
+    {
+        ModuleState &state = m_modulesState.at(modAddress);
+        auto find = m_debugInfo.find(modAddress);
+        if (find != m_debugInfo.end() && state.indexesSize != 0)
+        {
+            EvictPDBIndexes(find->second);
+        }
+
+        m_indexesTotalSize -= state.indexesSize + state.userCodeILOffsetsSize;
+        state.indexesSize = 0;
+        state.userCodeILOffsetsSize = 0;
+        UserCodeILOffsets().swap(state.userCodeILOffsets);
+        Metrics::Add(Metrics::Counter::SymbolsIndexesEvicted);
+    }
 }
 
 HRESULT DebugInfo::GetPDBInfo(CORDB_ADDRESS modAddress, const PDBInfoCallback &cb)
 {
     const std::scoped_lock<std::mutex> lock(m_debugInfoMutex);
     auto infoPair = m_debugInfo.find(modAddress);
-    return (infoPair == m_debugInfo.end()) ? E_FAIL : cb(infoPair->second);
+    if (infoPair == m_debugInfo.end())
+    {
+        return E_FAIL;
+    }
+
+    UseModule(modAddress, infoPair->second);
+    return cb(infoPair->second);
 }
 
 HRESULT DebugInfo::ResolveFunctionBreakpointInAny(const std::string &funcname, const ResolveFunctionBreakpointCallback &cb)
@@ -291,6 +501,34 @@ HRESULT DebugInfo::ResolveFunctionBreakpointInModule(ICorDebugModule *pModule, c
     return ResolveMethodInModule(pModule, funcname, cb);
 }
 
+// Caller must hold m_debugInfoMutex.
+HRESULT DebugInfo::GetUserCodeILOffsets(CORDB_ADDRESS modAddress, const PDBInfo &pdbInfo, mdMethodDef methodToken,
+                                        const std::vector<uint32_t> *&ilOffsets)
+{
+    ModuleState &state = m_modulesState[modAddress];
+    auto find = state.userCodeILOffsets.find(methodToken);
+    if (find == state.userCodeILOffsets.end())
+    {
+        Metrics::Add(Metrics::Counter::UserCodeOffsetsMisses);
+        HRESULT Status = S_OK;
+        std::vector<uint32_t> methodILOffsets;
+        IfFailRet(PDBReader::GetUserCodeILOffsets(pdbInfo.m_pdbHandle, methodToken, methodILOffsets));
+        const size_t size = sizeof(UserCodeILOffsets::value_type) + 2 * sizeof(void *) +
+                            methodILOffsets.capacity() * sizeof(uint32_t);
+        find = state.userCodeILOffsets.emplace(methodToken, std::move(methodILOffsets)).first;
+        state.userCodeILOffsetsSize += size;
+        m_indexesTotalSize += size;
+        EnforceSymbolsIndexesBudget(modAddress);
+    }
+    else
+    {
+        Metrics::Add(Metrics::Counter::UserCodeOffsetsHits);
+    }
+
+    ilOffsets = &find->second;
+    return S_OK;
+}
+
 HRESULT DebugInfo::GetStepRangeFromCurrentIP(ICorDebugThread *pThread, COR_DEBUG_STEP_RANGE &range)
 {
     HRESULT Status = S_OK;
@@ -331,7 +569,28 @@ HRESULT DebugInfo::GetStepRangeFromCurrentIP(ICorDebugThread *pThread, COR_DEBUG
     IfFailRet(GetPDBInfo(modAddress,
         [&](const PDBInfo &pdbInfo) -> HRESULT
         {
-            return PDBReader::GetStepRangeFromILOffset(pdbInfo.m_pdbHandle, methodToken, ilOffset, ilStartOffset, ilEndOffset);
+            const std::vector<uint32_t> *ilOffsets = nullptr;
+            IfFailRet(GetUserCodeILOffsets(modAddress, pdbInfo, methodToken, ilOffsets));
+            if (ilOffsets->empty())
+            {
+                return E_FAIL;
+            }
+
+            // Range from sequence point that contains ilOffset to next sequence point. Could be [0, first sequence point]
+            // in case ilOffset is before first sequence point. In case of last sequence point in method, return
+            // [ilOffset, ilOffset] range, end offset calculated by IL code size below.
+            auto next = std::upper_bound(ilOffsets->begin(), ilOffsets->end(), ilOffset);
+            if (next == ilOffsets->end())
+            {
+                ilStartOffset = ilOffsets->back();
+                ilEndOffset = ilStartOffset;
+            }
+            else
+            {
+                ilStartOffset = (next == ilOffsets->begin()) ? 0 : *std::prev(next);
+                ilEndOffset = *next;
+            }
+            return S_OK;
         }));
 
     if (ilStartOffset == ilEndOffset)
@@ -349,10 +608,32 @@ HRESULT DebugInfo::GetStepRangeFromCurrentIP(ICorDebugThread *pThread, COR_DEBUG
 
 void DebugInfo::TryLoadModuleSymbols(ICorDebugModule *pModule, Module &module)
 {
+    PDB::Identity pdbId{};
+    std::vector<uint8_t> embeddedPDB;
+    if (FAILED(Modules::GetModulePdbInfo(pModule, pdbId, module.symbolFilePath, embeddedPDB)))
+    {
+        module.symbolStatus = SymbolStatus::NotFound;
+        return;
+    }
+
+    const Metrics::ScopedTimer loadTimer(Metrics::Histogram::SymbolsLoadTimeUs);
+    std::optional<PDBInfo> cachedPDBInfo = SymbolsCache::Take(pdbId);
+    if (cachedPDBInfo.has_value())
+    {
+        Metrics::Add(Metrics::Counter::SymbolsCacheReused);
+        module.symbolStatus = SymbolStatus::Loaded;
+        module.symbolFilePath = cachedPDBInfo->m_symbolFilePath;
+        AddPDBInfo(pModule, std::move(cachedPDBInfo.value()));
+        return;
+    }
+
     mdhandle_t pdbHandle = nullptr;
     MemoryBuffer memBuff;
-    std::vector<uint8_t> embeddedPDB;
-    const HRESULT Status = LoadPDB(pModule, pdbHandle, memBuff, module.symbolFilePath, embeddedPDB);
+    HRESULT Status = S_OK;
+    {
+        const StartupProfile::PhaseTimer phaseTimer(StartupProfile::Phase::PDBDiscovery);
+        Status = LoadPDB(pModule, pdbId, pdbHandle, memBuff, module.symbolFilePath, embeddedPDB);
+    }
     module.symbolStatus = SUCCEEDED(Status) ? SymbolStatus::Loaded : SymbolStatus::NotFound;
 
     if (module.symbolStatus == SymbolStatus::Loaded)
@@ -364,32 +645,48 @@ void DebugInfo::TryLoadModuleSymbols(ICorDebugModule *pModule, Module &module)
                 "Could not load source file names related info from PDB file.\n"});
         }
 
-        PDB::SourceMethodRanges sourceMethodRanges;
-        if (FAILED(DebugSources::FillMethodRanges(pModule, pdbHandle, sourceMethodRanges)))
+        PDBInfo pdbInfo{pdbHandle, std::move(memBuff), std::move(embeddedPDB), nullptr,
+                        std::move(sourceFileNameToIndicesMap), {}, {}, {}};
+        if (FAILED(LoadPDBIndexes(pModule, pdbInfo)))
         {
             DAPIO::EmitOutputEvent({OutputCategory::StdErr,
                 "Could not load source lines related info from PDB file. Could produce failures during "
                 "breakpoint's source path resolve in future.\n"});
         }
 
-        std::unordered_map<uint32_t, uint32_t> moveNextToKickoff;
-        std::unordered_map<uint32_t, uint32_t> kickoffToMoveNext;
-        PDBReader::GetStateMachineMethods(pdbHandle, moveNextToKickoff, kickoffToMoveNext);
+        pdbInfo.m_pdbId = pdbId;
+        pdbInfo.m_symbolFilePath = module.symbolFilePath;
+        AddPDBInfo(pModule, std::move(pdbInfo));
+    }
+}
+
+void DebugInfo::AddPDBInfo(ICorDebugModule *pModule, PDBInfo &&pdbInfo)
+{
+    CORDB_ADDRESS baseAddress = 0;
+    if (FAILED(pModule->GetBaseAddress(&baseAddress)))
+    {
+        DAPIO::EmitOutputEvent({OutputCategory::StdErr, "Could not find module base address.\n"});
+        return;
+    }
 
-        CORDB_ADDRESS baseAddress = 0;
-        if (SUCCEEDED(pModule->GetBaseAddress(&baseAddress)))
-        {
-            pModule->AddRef();
-            PDBInfo pdbInfo{pdbHandle, std::move(memBuff), std::move(embeddedPDB), pModule,
-                            std::move(sourceFileNameToIndicesMap), std::move(sourceMethodRanges),
-                            std::move(moveNextToKickoff), std::move(kickoffToMoveNext)};
-            const std::scoped_lock<std::mutex> lock(m_debugInfoMutex);
-            m_debugInfo.insert(std::make_pair(baseAddress, std::move(pdbInfo)));
-        }
-        else
-        {
-            DAPIO::EmitOutputEvent({OutputCategory::StdErr, "Could not find module base address.\n"});
-        }
+    pModule->AddRef();
+    pdbInfo.m_trModule = pModule;
+    const int64_t pdbDataSize = GetPDBDataSize(pdbInfo);
+    const std::scoped_lock<std::mutex> lock(m_debugInfoMutex);
+    pdbInfo.m_loadId = ++m_loadCounter;
+    auto insertResult = m_debugInfo.insert(std::make_pair(baseAddress, std::move(pdbInfo)));
+    if (insertResult.second)
+    {
+        Metrics::Add(Metrics::Counter::SymbolsLoaded);
+        Metrics::Add(Metrics::Counter::SymbolsBytesLoaded, pdbDataSize);
+
+        RemoveModuleState(baseAddress);
+        ModuleState &state = m_modulesState[baseAddress];
+        const PDBInfo &insertedPDBInfo = insertResult.first->second;
+        state.indexesSize = insertedPDBInfo.m_indexesEvicted ? 0 : GetIndexesSize(insertedPDBInfo);
+        state.lastUse = ++m_useCounter;
+        m_indexesTotalSize += state.indexesSize;
+        EnforceSymbolsIndexesBudget(baseAddress);
     }
 }
 
@@ -399,7 +696,14 @@ void DebugInfo::UnloadModuleSymbols(ICorDebugModule *pModule)
     if (SUCCEEDED(pModule->GetBaseAddress(&baseAddress)))
     {
         const std::scoped_lock<std::mutex> lock(m_debugInfoMutex);
-        m_debugInfo.erase(baseAddress);
+        auto find = m_debugInfo.find(baseAddress);
+        if (find != m_debugInfo.end())
+        {
+            Metrics::Add(Metrics::Counter::SymbolsBytesLoaded, -GetPDBDataSize(find->second));
+            SymbolsCache::Put(std::move(find->second));
+            m_debugInfo.erase(find);
+        }
+        RemoveModuleState(baseAddress);
     }
 }
 
@@ -448,7 +752,15 @@ HRESULT DebugInfo::GetNextUserCodeILOffset(ICorDebugModule *pModule, mdMethodDef
     return GetPDBInfo(modAddress,
         [&](const PDBInfo &pdbInfo) -> HRESULT
         {
-            return PDBReader::GetNextUserCodeILOffset(pdbInfo.m_pdbHandle, methodToken, ilOffset, ilNextOffset);
+            const std::vector<uint32_t> *ilOffsets = nullptr;
+            IfFailRet(GetUserCodeILOffsets(modAddress, pdbInfo, methodToken, ilOffsets));
+            auto next = std::lower_bound(ilOffsets->begin(), ilOffsets->end(), ilOffset);
+            if (next == ilOffsets->end())
+            {
+                return CORDBG_E_CODE_NOT_AVAILABLE; // No user code found after ilOffset
+            }
+            ilNextOffset = *next;
+            return S_OK;
         });
 }
 
@@ -659,6 +971,8 @@ HRESULT DebugInfo::ResolveBreakpoint(CORDB_ADDRESS modAddress, const std::string
         return E_FAIL;
     }
 
+    // Method ranges could be evicted, make sure they are loaded.
+    UseModule(globalFileIndex.modAddress, m_debugInfo.at(globalFileIndex.modAddress));
     return DebugSources::ResolveBreakpoints(*pPDBInfo, globalFileIndex.sourceFileIndex, sourceLine, resolvedPoints);
 }
 
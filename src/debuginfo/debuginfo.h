@@ -17,8 +17,10 @@
 #include "types/protocol.h"
 #include "utils/torelease.h"
 #include "utils/utf.h"
+#include <cstdint>
 #include <functional>
 #include <mutex>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -27,6 +29,17 @@ namespace dncdbg
 
 using ResolveFunctionBreakpointCallback = std::function<HRESULT(ICorDebugModule *, mdMethodDef &)>;
 
+// Memory held by loaded module symbols (estimation for containers).
+struct ModuleSymbolsMemory
+{
+    CORDB_ADDRESS modAddress = 0;
+    std::string symbolFilePath;
+    size_t pdbDataSize = 0;     // Mapped PDB file or embedded PDB data.
+    size_t sourceNamesSize = 0; // Source file names index, never evicted.
+    size_t indexesSize = 0;     // Evictable derived indexes and IL offsets cache, zero in case evicted.
+    bool indexesEvicted = false;
+};
+
 class DebugInfo
 {
   public:
@@ -49,6 +62,14 @@ class DebugInfo
 
     void Cleanup();
 
+    // Limit memory of derived indexes (method ranges, state machine and async methods, user code IL offsets), least
+    // recently used modules indexes are evicted and rebuilt on demand. Budget don't include PDB data (mapped file or
+    // embedded PDB copy) and source file names index, they are never evicted, since they are required for breakpoints
+    // resolve in any module. Zero budget - no limit.
+    void SetSymbolsIndexesBudget(size_t budget);
+    // Slowest to evict (most recently used) first.
+    void GetSymbolsMemory(std::vector<ModuleSymbolsMemory> &modules);
+
     HRESULT GetFrameNamedLocalVariable(ICorDebugModule *pModule, mdMethodDef methodToken, uint32_t ilOffset,
                                        uint32_t localIndex, WSTRING &localName);
 
@@ -72,10 +93,51 @@ class DebugInfo
     HRESULT GetStateMachineKickoffMethod(ICorDebugModule *pModule, mdMethodDef moveNextMethodToken,
                                          mdMethodDef &kickoffMethodToken);
 
+    // Once budget is exceeded, indexes are evicted until total size fits budget without 1/IndexesBudgetHysteresis
+    // part, so module indexes rebuild don't cause eviction on each use of modules in a row.
+    static constexpr size_t IndexesBudgetHysteresis = 4;
+
+    struct ModuleIndexesUse
+    {
+        CORDB_ADDRESS modAddress;
+        uint64_t lastUse;
+        size_t indexesSize;
+    };
+    // Select modules with indexes that must be evicted (least recently used first), `modules` are reordered.
+    static void SelectIndexesEviction(std::vector<ModuleIndexesUse> &modules, size_t indexesTotalSize, size_t budget,
+                                      std::vector<CORDB_ADDRESS> &evicted);
+
   private:
 
     std::mutex m_debugInfoMutex;
     std::unordered_map<CORDB_ADDRESS, PDBInfo> m_debugInfo;
+    // Sequence points IL offsets of methods, built on first step or user code search in method.
+    using UserCodeILOffsets = std::unordered_map<mdMethodDef, std::vector<uint32_t>>;
+    // Module symbols state that is not stored in PDBInfo.
+    struct ModuleState
+    {
+        UserCodeILOffsets userCodeILOffsets;
+        size_t userCodeILOffsetsSize = 0;
+        size_t indexesSize = 0; // Zero in case PDBInfo indexes are evicted.
+        uint64_t lastUse = 0;
+    };
+    std::unordered_map<CORDB_ADDRESS, ModuleState> m_modulesState;
+    size_t m_symbolsIndexesBudget{0};
+    size_t m_indexesTotalSize{0}; // Sum of all modules indexesSize and userCodeILOffsetsSize.
+    uint64_t m_useCounter{0};
+    uint64_t m_loadCounter{0}; // Last PDBInfo::m_loadId.
+
+    // Caller must hold m_debugInfoMutex.
+    HRESULT GetUserCodeILOffsets(CORDB_ADDRESS modAddress, const PDBInfo &pdbInfo, mdMethodDef methodToken,
+                                 const std::vector<uint32_t> *&ilOffsets);
+    // Caller must hold m_debugInfoMutex.
+    void UseModule(CORDB_ADDRESS modAddress, PDBInfo &pdbInfo);
+    // Caller must hold m_debugInfoMutex.
+    void RemoveModuleState(CORDB_ADDRESS modAddress);
+    // Caller must hold m_debugInfoMutex.
+    void EnforceSymbolsIndexesBudget(CORDB_ADDRESS usedModAddress);
+
+    void AddPDBInfo(ICorDebugModule *pModule, PDBInfo &&pdbInfo);
 };
 
 } // namespace dncdbg
@@ -300,6 +300,14 @@ HRESULT FillMethodRanges(ICorDebugModule *pModule, mdhandle_t pdbHandle, PDB::So
     std::unordered_set<uint32_t> constrTokens;
     IfFailRet(GetModuleConstructors(pModule, constrTokens));
 
+    return FillMethodRanges(constrTokens, pdbHandle, sourceMethodRanges);
+}
+
+HRESULT FillMethodRanges(const std::unordered_set<uint32_t> &constrTokens, mdhandle_t pdbHandle,
+                         PDB::SourceMethodRanges &sourceMethodRanges)
+{
+    HRESULT Status = S_OK;
+
     std::unordered_map<uint32_t, std::vector<PDB::MethodRange>> pdbMethodRanges;
     IfFailRet(PDBReader::GetMethodsRanges(pdbHandle, constrTokens, pdbMethodRanges));
     if (pdbMethodRanges.empty())
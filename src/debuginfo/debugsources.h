@@ -13,6 +13,7 @@
 #endif
 
 #include "debuginfo/pdbreader.h"
+#include <unordered_set>
 #include <vector>
 
 namespace dncdbg::DebugSources
@@ -20,6 +21,9 @@ namespace dncdbg::DebugSources
 
 HRESULT ResolveBreakpoints(const PDBInfo &pdbInfo, uint32_t sourceFileIndex, int sourceLine, std::vector<PDB::ResolvedBreakpoint> &resolvedPoints);
 HRESULT FillMethodRanges(ICorDebugModule *pModule, mdhandle_t pdbHandle, PDB::SourceMethodRanges &sourceMethodRanges);
+// Same as above, but with module constructors (.ctor/.cctor) tokens provided by caller.
+HRESULT FillMethodRanges(const std::unordered_set<uint32_t> &constrTokens, mdhandle_t pdbHandle,
+                         PDB::SourceMethodRanges &sourceMethodRanges);
 
 } // namespace dncdbg::DebugSources
 
@@ -18,6 +18,7 @@
 #include <cstdint>
 #include <dnmd.h>
 #include <forward_list>
+#include <string>
 #include <vector>
 #include <unordered_map>
 
@@ -165,6 +166,14 @@ struct PDBInfo
     PDB::SourceMethodRanges m_sourceMethodRanges;
     std::unordered_map<uint32_t, uint32_t> m_moveNextToKickoff;
     std::unordered_map<uint32_t, uint32_t> m_kickoffToMoveNext;
+    std::vector<bool> m_asyncMethods; // Methods with async stepping information, by method RID.
+    PDB::Identity m_pdbId{}; // Zero in case module don't have CodeView debug directory entry.
+    // Unique for each module symbols load (not zero), set by DebugInfo then symbols are added for loaded module.
+    uint64_t m_loadId = 0;
+    std::string m_symbolFilePath;
+    // Method ranges, state machine and async methods indexes were evicted by symbols indexes budget
+    // (see DebugInfo::SetSymbolsIndexesBudget()) and must be rebuilt before use.
+    bool m_indexesEvicted = false;
 
     PDBInfo() = default;
     PDBInfo(mdhandle_t handle, MemoryBuffer &&memBuff, std::vector<uint8_t> &&embeddedPDB, ICorDebugModule *pModule,
@@ -190,7 +199,12 @@ struct PDBInfo
           m_sourceFileNameToIndices(std::move(other.m_sourceFileNameToIndices)),
           m_sourceMethodRanges(std::move(other.m_sourceMethodRanges)),
           m_moveNextToKickoff(std::move(other.m_moveNextToKickoff)),
-          m_kickoffToMoveNext(std::move(other.m_kickoffToMoveNext))
+          m_kickoffToMoveNext(std::move(other.m_kickoffToMoveNext)),
+          m_asyncMethods(std::move(other.m_asyncMethods)),
+          m_pdbId(other.m_pdbId),
+          m_loadId(other.m_loadId),
+          m_symbolFilePath(std::move(other.m_symbolFilePath)),
+          m_indexesEvicted(other.m_indexesEvicted)
     {
         other.m_pdbHandle = nullptr;
     }
@@ -8,6 +8,7 @@
 #include "utils/utftoupper.h"
 #include <dnmd.h>
 #include <dnmd_pdb.h>
+#include <algorithm>
 #include <cstddef>
 #include <cstring>
 #include <memory>
@@ -106,6 +107,42 @@ struct SeqPointsDeleter
 };
 using SeqPointsPtr = std::unique_ptr<md_sequence_points_t, SeqPointsDeleter>;
 
+// Same as md_get_column_value_as_range(), but range is limited by target table rows. Range count is calculated
+// by dnmd as difference of list column values in current and next rows, in case of malformed PDB (list column
+// values are not ascending) it could be close to UINT32_MAX.
+bool GetColumnValueAsRange(mdhandle_t pdbHandle, mdcursor_t cursor, col_index_t column, mdtable_id_t targetTable,
+                           mdcursor_t &rangeCursor, uint32_t &rangeCount)
+{
+    if (!md_get_column_value_as_range(cursor, column, &rangeCursor, &rangeCount))
+    {
+        return false;
+    }
+
+    if (rangeCount == 0)
+    {
+        return true;
+    }
+
+    mdToken firstToken = mdTokenNil;
+    mdcursor_t tableCursor{};
+    uint32_t tableCount = 0;
+    if (!md_cursor_to_token(rangeCursor, &firstToken) ||
+        !md_create_cursor(pdbHandle, targetTable, &tableCursor, &tableCount))
+    {
+        return false;
+    }
+
+    const uint32_t firstRow = RidFromToken(firstToken);
+    if (firstRow == 0 || firstRow > tableCount)
+    {
+        rangeCount = 0;
+        return true;
+    }
+
+    rangeCount = std::min(rangeCount, tableCount - firstRow + 1);
+    return true;
+}
+
 } // unnamed namespace
 
 HRESULT OpenPDB(const std::string &pdbPath, const PDB::Identity &pdbId, MemoryBuffer &memBuffer, mdhandle_t &pdbHandle)
@@ -484,7 +521,8 @@ HRESULT GetLocalConstants(mdhandle_t pdbHandle, mdMethodDef methodToken, uint32_
         // Get the ConstantList range for this scope
         mdcursor_t constCursor{};
         uint32_t constCount = 0;
-        if (!md_get_column_value_as_range(lscopeCursor, mdtLocalScope_ConstantList, &constCursor, &constCount))
+        if (!GetColumnValueAsRange(pdbHandle, lscopeCursor, mdtLocalScope_ConstantList, mdtid_LocalConstant,
+                                   constCursor, constCount))
         {
             md_cursor_move(&lscopeCursor, 1);
             continue;
@@ -583,7 +621,8 @@ HRESULT GetLocalVariableName(mdhandle_t pdbHandle, mdMethodDef methodToken, uint
         // Get the VariableList range for this scope
         mdcursor_t varCursor{};
         uint32_t varCount = 0;
-        if (!md_get_column_value_as_range(lscopeCursor, mdtLocalScope_VariableList, &varCursor, &varCount))
+        if (!GetColumnValueAsRange(pdbHandle, lscopeCursor, mdtLocalScope_VariableList, mdtid_LocalVariable,
+                                   varCursor, varCount))
         {
             md_cursor_move(&lscopeCursor, 1);
             continue;
@@ -791,6 +830,52 @@ HRESULT GetAsyncMethodSteppingInfo(mdhandle_t pdbHandle, mdMethodDef methodToken
     return awaitInfos.empty() ? E_FAIL : S_OK;
 }
 
+HRESULT GetAsyncMethods(mdhandle_t pdbHandle, std::vector<bool> &asyncMethods)
+{
+    if (pdbHandle == nullptr)
+    {
+        return E_INVALIDARG;
+    }
+
+    asyncMethods.clear();
+
+    mdcursor_t cdiCursor;
+    uint32_t cdiCount = 0;
+    if (!md_create_cursor(pdbHandle, mdtid_CustomDebugInformation, &cdiCursor, &cdiCount))
+    {
+        return E_FAIL;
+    }
+
+    for (uint32_t i = 0; i < cdiCount; ++i)
+    {
+        mdToken cdiMethodToken = mdTokenNil;
+        if (!md_get_column_value_as_token(cdiCursor, mdtCustomDebugInformation_Parent, &cdiMethodToken) ||
+            TypeFromToken(cdiMethodToken) != mdtMethodDef)
+        {
+            md_cursor_move(&cdiCursor, 1);
+            continue;
+        }
+
+        mdguid_t guid;
+        if (!md_get_column_value_as_guid(cdiCursor, mdtCustomDebugInformation_Kind, &guid) ||
+            std::memcmp(&guid, asyncMethodSteppingInformation.data(), sizeof(mdguid_t)) != 0)
+        {
+            md_cursor_move(&cdiCursor, 1);
+            continue;
+        }
+
+        const uint32_t rid = RidFromToken(cdiMethodToken);
+        if (rid >= asyncMethods.size())
+        {
+            asyncMethods.resize(rid + 1, false);
+        }
+        asyncMethods[rid] = true;
+        md_cursor_move(&cdiCursor, 1);
+    }
+
+    return S_OK;
+}
+
 HRESULT GetLastIlOffset(mdhandle_t pdbHandle, mdMethodDef methodToken, uint32_t &lastIlOffset)
 {
     if (pdbHandle == nullptr)
@@ -990,99 +1075,14 @@ HRESULT GetSequencePointByILOffset(mdhandle_t pdbHandle, mdMethodDef methodToken
     return found ? S_OK : E_FAIL;
 }
 
-HRESULT GetNextUserCodeILOffset(mdhandle_t pdbHandle, mdMethodDef methodToken, uint32_t ilOffset, uint32_t &ilNextOffset)
-{
-    if (pdbHandle == nullptr)
-    {
-        return E_INVALIDARG;
-    }
-
-    ilNextOffset = 0;
-
-    // Create cursor to the MethodDebugInformation table
-    mdcursor_t mdiCursor{};
-    uint32_t mdiCount = 0;
-    if (!md_create_cursor(pdbHandle, mdtid_MethodDebugInformation, &mdiCursor, &mdiCount))
-    {
-        return E_FAIL;
-    }
-
-    const uint32_t methodIndex = RidFromToken(methodToken) - 1;
-    if (methodIndex >= mdiCount)
-    {
-        return E_INVALIDARG;
-    }
-
-    // Move cursor for requested method
-    if (methodIndex != 0)
-    {
-        md_cursor_move(&mdiCursor, static_cast<int32_t>(methodIndex));
-    }
-
-    // Get the SequencePoints blob
-    uint8_t const *seqPointsBlob = nullptr;
-    uint32_t blobLen = 0;
-    if (!md_get_column_value_as_blob(mdiCursor, mdtMethodDebugInformation_SequencePoints, &seqPointsBlob, &blobLen))
-    {
-        return E_FAIL;
-    }
-
-    if (seqPointsBlob == nullptr || blobLen == 0)
-    {
-        return CORDBG_E_CODE_NOT_AVAILABLE; // No user code found
-    }
-
-    // First, query the required buffer size
-    size_t bufferLen = 0;
-    md_blob_parse_result_t result = md_parse_sequence_points(mdiCursor, seqPointsBlob, blobLen, nullptr, &bufferLen);
-    if (result != mdbpr_InsufficientBuffer || bufferLen == 0)
-    {
-        return E_FAIL;
-    }
-
-    // Allocate properly aligned buffer and parse sequence points
-    // Use aligned operator new to guarantee correct alignment for md_sequence_points_t
-    // which contains int64_t and mdcursor_t members requiring 8-byte alignment.
-    void *rawBuffer = ::operator new(bufferLen, static_cast<std::align_val_t>(alignof(md_sequence_points_t)));
-    SeqPointsPtr seqPoints(static_cast<md_sequence_points_t *>(rawBuffer));
-    result = md_parse_sequence_points(mdiCursor, seqPointsBlob, blobLen, seqPoints.get(), &bufferLen);
-    if (result != mdbpr_Success)
-    {
-        return E_FAIL;
-    }
-
-    for (uint32_t j = 0; j < seqPoints->record_count; ++j)
-    {
-        const auto &record = seqPoints->records[j];
-
-        if (record.kind != md_sequence_points_t::record_t::mdsp_SequencePointRecord)
-        {
-            continue;
-        }
-
-        const uint32_t recordIlOffset = record.sequence_point.rolling_il_offset; // NOLINT(cppcoreguidelines-pro-type-union-access)
-
-        if (recordIlOffset >= ilOffset)
-        {
-            ilNextOffset = recordIlOffset;
-            return S_OK;
-        }
-    }
-
-    // No user code found after ilOffset
-    return CORDBG_E_CODE_NOT_AVAILABLE;
-}
-
-HRESULT GetStepRangeFromILOffset(mdhandle_t pdbHandle, mdMethodDef methodToken, uint32_t ilOffset,
-                                 uint32_t &ilStartOffset, uint32_t &ilEndOffset)
+HRESULT GetUserCodeILOffsets(mdhandle_t pdbHandle, mdMethodDef methodToken, std::vector<uint32_t> &ilOffsets)
 {
     if (pdbHandle == nullptr)
     {
         return E_INVALIDARG;
     }
 
-    ilStartOffset = 0;
-    ilEndOffset = 0;
+    ilOffsets.clear();
 
     // Create cursor to the MethodDebugInformation table
     mdcursor_t mdiCursor{};
@@ -1114,7 +1114,7 @@ HRESULT GetStepRangeFromILOffset(mdhandle_t pdbHandle, mdMethodDef methodToken,
 
     if (seqPointsBlob == nullptr || blobLen == 0)
     {
-        return E_FAIL;
+        return S_OK; // No user code
     }
 
     // First, query the required buffer size
@@ -1136,7 +1136,8 @@ HRESULT GetStepRangeFromILOffset(mdhandle_t pdbHandle, mdMethodDef methodToken,
         return E_FAIL;
     }
 
-    bool found = false;
+    // Note, hidden sequence points are not user code and not included.
+    ilOffsets.reserve(seqPoints->record_count);
     for (uint32_t j = 0; j < seqPoints->record_count; ++j)
     {
         const auto &record = seqPoints->records[j];
@@ -1146,24 +1147,11 @@ HRESULT GetStepRangeFromILOffset(mdhandle_t pdbHandle, mdMethodDef methodToken,
             continue;
         }
 
-        const uint32_t recordIlOffset = record.sequence_point.rolling_il_offset; // NOLINT(cppcoreguidelines-pro-type-union-access)
-
-        if (recordIlOffset <= ilOffset)
-        {
-            ilStartOffset = recordIlOffset;
-            // If returning [recordIlOffset, recordIlOffset] (last sequence point in method), caller should calculate end offset by IL code size
-            ilEndOffset = recordIlOffset;
-            found = true;
-            continue;
-        }
-
-        // Could return [0, recordIlOffset] range; this is OK
-        ilEndOffset = recordIlOffset;
-        found = true;
-        break;
+        ilOffsets.push_back(record.sequence_point.rolling_il_offset); // NOLINT(cppcoreguidelines-pro-type-union-access)
     }
+    ilOffsets.shrink_to_fit();
 
-    return found ? S_OK : E_FAIL;
+    return S_OK;
 }
 
 HRESULT ResolveBreakpoints(mdhandle_t pdbHandle, const std::vector<mdMethodDef> &methodTokens, mdMethodDef nestedMethodToken,
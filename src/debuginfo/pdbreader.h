@@ -27,12 +27,13 @@ HRESULT GetLocalVariableName(mdhandle_t pdbHandle, mdMethodDef methodToken, uint
 bool IsHoistedLocalInScope(mdhandle_t pdbHandle, mdMethodDef methodToken, uint32_t ilOffset, uint32_t hoistedLocalIndex);
 HRESULT GetAsyncMethodSteppingInfo(mdhandle_t pdbHandle, mdMethodDef methodToken,
                                    std::vector<PDB::AsyncAwaitInfoBlock> &awaitInfos);
+// Bitset of methods (by method RID) that have async method stepping information.
+HRESULT GetAsyncMethods(mdhandle_t pdbHandle, std::vector<bool> &asyncMethods);
 HRESULT GetLastIlOffset(mdhandle_t pdbHandle, mdMethodDef methodToken, uint32_t &lastIlOffset);
 HRESULT GetSequencePointByILOffset(mdhandle_t pdbHandle, mdMethodDef methodToken, uint32_t ilOffset,
                                    PDB::SequencePoint &sequencePoint);
-HRESULT GetNextUserCodeILOffset(mdhandle_t pdbHandle, mdMethodDef methodToken, uint32_t ilOffset, uint32_t &ilNextOffset);
-HRESULT GetStepRangeFromILOffset(mdhandle_t pdbHandle, mdMethodDef methodToken, uint32_t ilOffset,
-                                 uint32_t &ilStartOffset, uint32_t &ilEndOffset);
+// IL offsets of method sequence points (without hidden), in IL offset order. Empty for method without user code.
+HRESULT GetUserCodeILOffsets(mdhandle_t pdbHandle, mdMethodDef methodToken, std::vector<uint32_t> &ilOffsets);
 HRESULT ResolveBreakpoints(mdhandle_t pdbHandle, const std::vector<mdMethodDef> &methodTokens, mdMethodDef nestedMethodToken,
                            uint32_t sourceFileIndex, int32_t sourceLine, std::vector<PDB::ResolvedBreakpoint> &resolvedBreakpoints);
 HRESULT GetStateMachineMethods(mdhandle_t pdbHandle, std::unordered_map<uint32_t, uint32_t> &moveNextToKickoff,
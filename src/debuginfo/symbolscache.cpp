@@ -0,0 +1,119 @@
+// Copyright (c) 2026 Mikhail Kurinnoi
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "debuginfo/symbolscache.h"
+#include "utils/logger.h"
+#include <algorithm>
+#include <list>
+#include <mutex>
+
+namespace dncdbg
+{
+
+namespace
+{
+
+struct CacheState
+{
+    std::mutex mutex;
+    size_t capacity{0};
+    std::list<PDBInfo> entries; // Most recently stored first.
+};
+
+CacheState &GetCacheState()
+{
+    static CacheState cacheState;
+    return cacheState;
+}
+
+// Copy PDB data from file mapping into memory and reopen PDB handle for it.
+bool DetachFromFile(PDBInfo &pdbInfo)
+{
+    if (pdbInfo.m_memBuff.Data() == nullptr)
+    {
+        return true; // Embedded PDB, already in memory.
+    }
+
+    const auto *data = static_cast<const uint8_t *>(pdbInfo.m_memBuff.Data());
+    std::vector<uint8_t> pdbData(data, data + pdbInfo.m_memBuff.Size());
+
+    mdhandle_t pdbHandle = nullptr;
+    if (!md_create_handle(pdbData.data(), static_cast<uint32_t>(pdbData.size()), &pdbHandle))
+    {
+        return false;
+    }
+
+    md_destroy_handle(pdbInfo.m_pdbHandle);
+    pdbInfo.m_pdbHandle = pdbHandle;
+    pdbInfo.m_embeddedPDB = std::move(pdbData);
+    pdbInfo.m_memBuff = MemoryBuffer();
+    return true;
+}
+
+} // unnamed namespace
+
+void SymbolsCache::SetCapacity(size_t capacity)
+{
+    CacheState &state = GetCacheState();
+    const std::scoped_lock<std::mutex> lock(state.mutex);
+    state.capacity = capacity;
+    while (state.entries.size() > state.capacity)
+    {
+        state.entries.pop_back();
+    }
+}
+
+void SymbolsCache::Put(PDBInfo &&pdbInfo)
+{
+    static constexpr PDB::Identity zeroId{};
+    CacheState &state = GetCacheState();
+    {
+        const std::scoped_lock<std::mutex> lock(state.mutex);
+        if (state.capacity == 0 || pdbInfo.m_pdbHandle == nullptr || pdbInfo.m_pdbId == zeroId)
+        {
+            return;
+        }
+    }
+
+    pdbInfo.m_trModule.Free();
+    if (!DetachFromFile(pdbInfo))
+    {
+        LOGW(log << "SymbolsCache: can't reopen PDB data for " << pdbInfo.m_symbolFilePath);
+        return;
+    }
+
+    const std::scoped_lock<std::mutex> lock(state.mutex);
+    // Same PDB could be loaded by several modules at the same time, keep only one copy.
+    auto find = std::find_if(state.entries.begin(), state.entries.end(),
+                             [&](const PDBInfo &entry) { return entry.m_pdbId == pdbInfo.m_pdbId; });
+    if (find != state.entries.end())
+    {
+        state.entries.erase(find);
+    }
+
+    state.entries.emplace_front(std::move(pdbInfo));
+    while (state.entries.size() > state.capacity)
+    {
+        state.entries.pop_back();
+    }
+}
+
+std::optional<PDBInfo> SymbolsCache::Take(const PDB::Identity &pdbId)
+{
+    CacheState &state = GetCacheState();
+    const std::scoped_lock<std::mutex> lock(state.mutex);
+
+    auto find = std::find_if(state.entries.begin(), state.entries.end(),
+                             [&](const PDBInfo &entry) { return entry.m_pdbId == pdbId; });
+    if (find == state.entries.end())
+    {
+        return std::nullopt;
+    }
+
+    std::optional<PDBInfo> result(std::move(*find));
+    state.entries.erase(find);
+    return result;
+}
+
+} // namespace dncdbg
@@ -0,0 +1,39 @@
+// Copyright (c) 2026 Mikhail Kurinnoi
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#ifndef DEBUGINFO_SYMBOLSCACHE_H
+#define DEBUGINFO_SYMBOLSCACHE_H
+
+#include "debuginfo/pdb.h"
+#include <cstddef>
+#include <optional>
+
+namespace dncdbg
+{
+
+// SymbolsCache keeps loaded and parsed symbols of unloaded modules, so the same module build (with
+// the same PDB identity) loaded again don't need PDB read and parse. In server mode this keep symbols
+// warm between debug sessions.
+//
+// Cache is process wide and disabled by default (zero capacity). Stored symbols don't hold PDB file
+// mapping (PDB data is copied into memory), so PDB file could be replaced by rebuild.
+class SymbolsCache
+{
+  public:
+
+    static constexpr size_t DefaultServerCapacity = 256;
+
+    // Maximum number of stored modules symbols, least recently stored symbols are evicted.
+    static void SetCapacity(size_t capacity);
+
+    // Store symbols of unloaded module, module reference is released.
+    static void Put(PDBInfo &&pdbInfo);
+
+    // Take symbols out of cache, caller must set module reference.
+    static std::optional<PDBInfo> Take(const PDB::Identity &pdbId);
+};
+
+} // namespace dncdbg
+
+#endif // DEBUGINFO_SYMBOLSCACHE_H
@@ -4,11 +4,26 @@
 
 #ifdef DEBUG_INTERNAL_TESTS
 
+#include "debuginfo/debuginfo.h"
 #include "debuginfo/sourcefilemap.h"
+#include "utils/allocationprofile.h"
+#include "utils/memorycache.h"
+#include "utils/metrics.h"
+#include "utils/print.h"
+#include "utils/startupprofile.h"
+#include "utils/utf.h"
 #include "utils/utftoupper.h"
 #include <json/json.hpp>
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
 void RunInternalTests() // NOLINT(misc-use-internal-linkage)
 {
@@ -38,6 +53,325 @@ void RunInternalTests() // NOLINT(misc-use-internal-linkage)
         dncdbg::SourceFileMap::GetMap().clear();
     }
 
+    // UTF-8 <-> UTF-16 conversion
+    {
+        // ASCII runs longer than SIMD blocks, mixed with 2, 3 and 4 bytes UTF-8 sequences at block boundaries.
+        const std::string ascii("0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ");
+        const std::string utf8 = ascii + "\xD0\xBF\xD1\x80\xD0\xB8" + ascii.substr(0, 15) + "\xE4\xB8\xAD" + ascii.substr(0, 31) +
+                                 "\xF0\x9F\x98\x80" + ascii + "\xEF\xBF\xBF";
+        const dncdbg::WSTRING utf16 = dncdbg::to_utf16(utf8);
+        assert(utf16.size() == (ascii.size() * 2) + 3 + 15 + 1 + 31 + 2 + 1);
+        assert(utf16.at(ascii.size()) == 0x043F);
+        assert(utf16.at(ascii.size() + 3 + 15) == 0x4E2D);
+        assert(utf16.at(ascii.size() + 3 + 15 + 1 + 31) == 0xD83D);
+        assert(utf16.at(ascii.size() + 3 + 15 + 1 + 31 + 1) == 0xDE00);
+        assert(utf16.back() == 0xFFFF);
+        assert(dncdbg::to_utf8(utf16.c_str()) == utf8);
+        assert(dncdbg::to_utf8(W("")).empty());
+        assert(dncdbg::to_utf16(std::string()).empty());
+        assert(dncdbg::to_utf16(std::string("a\0b", 3)).size() == 3);
+
+#ifdef FEATURE_PAL
+        // Invalid input produce empty string.
+        const char16_t loneHigh[] = {u'a', 0xD83D, u'b', 0};
+        const char16_t loneLow[] = {u'a', 0xDE00, 0};
+        const char16_t highAtEnd[] = {u'a', 0xD83D, 0};
+        const char16_t reversedPair[] = {0xDE00, 0xD83D, 0};
+        assert(dncdbg::to_utf8(loneHigh).empty());
+        assert(dncdbg::to_utf8(loneLow).empty());
+        assert(dncdbg::to_utf8(highAtEnd).empty());
+        assert(dncdbg::to_utf8(reversedPair).empty());
+        assert(dncdbg::to_utf16("a\xC0\x80").empty());         // overlong
+        assert(dncdbg::to_utf16("a\xE0\x80\xAF").empty());     // overlong
+        assert(dncdbg::to_utf16("a\xED\xA0\xBD").empty());     // encoded surrogate
+        assert(dncdbg::to_utf16("a\xF4\x90\x80\x80").empty()); // above U+10FFFF
+        assert(dncdbg::to_utf16("a\xE4\xB8").empty());         // truncated
+        assert(dncdbg::to_utf16("a\x80").empty());              // unexpected continuation
+        assert(dncdbg::to_utf16("a\xFF").empty());
+#endif // FEATURE_PAL
+    }
+
+    // String and char escaping
+    {
+        using dncdbg::EscapeString;
+        assert(EscapeString("", '"').empty());
+        assert(EscapeString("plain text", '"') == "plain text");
+        assert(EscapeString(R"(C:\Dir\"name".txt)", '"') == R"(C:\\Dir\\\"name\".txt)");
+        assert(EscapeString("'single' \"double\"", '\'') == R"(\'single\' "double")");
+        assert(EscapeString(std::string("\0\a\b\f\n\r\t\v", 8), '"') == R"(\0\a\b\f\n\r\t\v)");
+        // Other control characters and non-ASCII characters are not escaped.
+        assert(EscapeString("\x01\x1F\x7F\xD1\x82\xF0\x9F\x98\x80", '"') == "\x01\x1F\x7F\xD1\x82\xF0\x9F\x98\x80");
+        // Special characters at SIMD block boundaries and in tail.
+        std::string text;
+        std::string expected;
+        for (size_t i = 0; i < 100; ++i)
+        {
+            const char c = i % 7 == 0 ? '\n' : (i % 11 == 0 ? '"' : (i % 13 == 0 ? '\\' : static_cast<char>('a' + (i % 26))));
+            text.push_back(c);
+            if (c == '\n')
+            {
+                expected += "\\n";
+            }
+            else if (c == '"' || c == '\\')
+            {
+                expected += '\\';
+                expected += c;
+            }
+            else
+            {
+                expected += c;
+            }
+        }
+        for (size_t offset = 0; offset < 70; ++offset)
+        {
+            const std::string prefix(offset, 'x');
+            assert(EscapeString(prefix + "\\", '"') == prefix + R"(\\)");
+        }
+        assert(EscapeString(text, '"') == expected);
+    }
+
+    // Base64 encoding
+    {
+        auto encode = [](const std::string &text)
+        {
+            std::string result("prefix:");
+            dncdbg::AppendBase64(reinterpret_cast<const uint8_t *>(text.data()), text.size(), result);
+            return result;
+        };
+        assert(encode("") == "prefix:");
+        assert(encode("f") == "prefix:Zg==");
+        assert(encode("fo") == "prefix:Zm8=");
+        assert(encode("foo") == "prefix:Zm9v");
+        assert(encode("foobar") == "prefix:Zm9vYmFy");
+        assert(encode(std::string("\0\xFF\xFE\x80", 4)) == "prefix:AP/+gA==");
+    }
+
+    // MemoryCache
+    {
+        using dncdbg::MemoryCache;
+        constexpr uint64_t memoryStart = 0x10000;
+        constexpr uint64_t unreadablePage = 0x18000;
+        std::vector<uint8_t> memory(0x30000);
+        for (size_t i = 0; i < memory.size(); ++i)
+        {
+            memory[i] = static_cast<uint8_t>(i * 7);
+        }
+        std::vector<std::pair<uint64_t, size_t>> calls;
+        MemoryCache cache([&](uint64_t address, uint8_t *buffer, size_t size)
+            {
+                calls.emplace_back(address, size);
+                if (address < memoryStart || address + size > memoryStart + memory.size() ||
+                    (address < unreadablePage + MemoryCache::PageSize && address + size > unreadablePage))
+                {
+                    return false;
+                }
+                std::copy_n(memory.begin() + static_cast<std::ptrdiff_t>(address - memoryStart), size, buffer);
+                return true;
+            });
+        auto check = [&](uint64_t address, size_t size, size_t expectedRead)
+        {
+            std::vector<uint8_t> buffer(size);
+            assert(cache.Read(address, buffer.data(), size) == expectedRead);
+            assert(std::equal(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(expectedRead),
+                              memory.begin() + static_cast<std::ptrdiff_t>(address - memoryStart)));
+        };
+
+        // Page is fetched once.
+        check(memoryStart + 10, 8, 8);
+        assert(calls.size() == 1 && calls.back() == std::make_pair(memoryStart, MemoryCache::PageSize));
+        check(memoryStart + 100, 1000, 1000);
+        assert(calls.size() == 1);
+
+        // Not cached pages are fetched by one run.
+        check(memoryStart + MemoryCache::PageSize - 4, (2 * MemoryCache::PageSize) + 8, (2 * MemoryCache::PageSize) + 8);
+        assert(calls.size() == 2 && calls.back() == std::make_pair(memoryStart + MemoryCache::PageSize, 3 * MemoryCache::PageSize));
+
+        // Run with unreadable page is checked page by page, read stops at unreadable page.
+        const uint64_t runStart = unreadablePage - (2 * MemoryCache::PageSize);
+        check(runStart + MemoryCache::PageSize - 16, (2 * MemoryCache::PageSize) + 32, MemoryCache::PageSize + 16);
+        assert(calls.size() == 7 && calls.at(2) == std::make_pair(runStart, 4 * MemoryCache::PageSize));
+        for (size_t i = 0; i < 4; ++i)
+        {
+            assert(calls.at(3 + i) == std::make_pair(runStart + (i * MemoryCache::PageSize), MemoryCache::PageSize));
+        }
+        check(unreadablePage - 16, 32, 16);
+        check(unreadablePage + 16, 32, 0);
+        check(unreadablePage + MemoryCache::PageSize, 32, 32);
+        assert(calls.size() == 7);
+
+        // Reads bigger than run bypass cache.
+        constexpr size_t largeSize = (MemoryCache::MaxRunPages + 1) * MemoryCache::PageSize;
+        check(memoryStart + 0x10000, largeSize, largeSize);
+        check(memoryStart + 0x10000, largeSize, largeSize);
+        assert(calls.size() == 9 && calls.back() == std::make_pair(memoryStart + 0x10000, largeSize));
+
+        // Invalidate drops cached pages.
+        std::array<uint8_t, 1> value{};
+        const uint8_t oldValue = memory[10];
+        memory[10] = oldValue + 1;
+        assert(cache.Read(memoryStart + 10, value.data(), 1) == 1 && value[0] == oldValue);
+        assert(calls.size() == 9);
+        cache.Invalidate();
+        assert(cache.Read(memoryStart + 10, value.data(), 1) == 1 && value[0] == memory[10]);
+        assert(calls.size() == 10);
+    }
+
+    // DebugInfo symbols indexes eviction
+    {
+        using dncdbg::DebugInfo;
+        std::vector<CORDB_ADDRESS> evicted;
+        std::vector<DebugInfo::ModuleIndexesUse> modules{{0x1000, 1, 40}, {0x2000, 3, 30}, {0x3000, 2, 50}};
+        // No limit or budget is not exceeded.
+        DebugInfo::SelectIndexesEviction(modules, 120, 0, evicted);
+        assert(evicted.empty());
+        DebugInfo::SelectIndexesEviction(modules, 120, 120, evicted);
+        assert(evicted.empty());
+        // Least recently used first, until total size fits budget with hysteresis (75 of 100).
+        DebugInfo::SelectIndexesEviction(modules, 120, 100, evicted);
+        assert((evicted == std::vector<CORDB_ADDRESS>{0x1000, 0x3000}));
+        // Module with rebuilt indexes become most recently used, single eviction is enough to fit budget.
+        modules = {{0x1000, 4, 40}, {0x2000, 3, 30}};
+        DebugInfo::SelectIndexesEviction(modules, 105, 100, evicted);
+        assert((evicted == std::vector<CORDB_ADDRESS>{0x2000}));
+        // Not enough candidates (module in use is not a candidate).
+        modules = {{0x2000, 3, 30}};
+        DebugInfo::SelectIndexesEviction(modules, 200, 100, evicted);
+        assert((evicted == std::vector<CORDB_ADDRESS>{0x2000}));
+    }
+
+    // Metrics
+    {
+        using dncdbg::Metrics;
+        Metrics::Snapshot snapshot;
+        Metrics::GetSnapshot(snapshot, true);
+
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < 4; ++i)
+        {
+            threads.emplace_back([]()
+                {
+                    for (uint64_t value = 0; value < 100; ++value)
+                    {
+                        Metrics::Add(Metrics::Counter::FuncEvals);
+                        Metrics::Record(Metrics::Histogram::FuncEvalTimeUs, value);
+                    }
+                });
+        }
+        for (auto &thread : threads)
+        {
+            thread.join();
+        }
+        Metrics::Add(Metrics::Counter::SymbolsBytesLoaded, 10);
+
+        Metrics::GetSnapshot(snapshot, true);
+        const Metrics::HistogramSnapshot &histogram = snapshot.histograms[static_cast<size_t>(Metrics::Histogram::FuncEvalTimeUs)];
+        assert(snapshot.counters[static_cast<size_t>(Metrics::Counter::FuncEvals)] == 400);
+        assert(histogram.count == 400 && histogram.sum == 4 * 4950 && histogram.max == 99);
+        assert(histogram.buckets[0] == 4 && histogram.buckets[1] == 4 && histogram.buckets[7] == 4 * 36);
+        assert(histogram.Percentile(0) == 0);
+        assert(histogram.Percentile(50) == 63);
+        assert(histogram.Percentile(100) == 99);
+
+        // Level counter is kept after reset, other metrics are zero.
+        Metrics::GetSnapshot(snapshot);
+        assert(snapshot.counters[static_cast<size_t>(Metrics::Counter::FuncEvals)] == 0);
+        assert(snapshot.counters[static_cast<size_t>(Metrics::Counter::SymbolsBytesLoaded)] == 10);
+        Metrics::Add(Metrics::Counter::SymbolsBytesLoaded, -10);
+    }
+
+    // StartupProfile
+    {
+        using dncdbg::StartupProfile;
+        // Fake clock, advanced by test only, so all durations are exact.
+        static StartupProfile::Clock::time_point fakeNow;
+        StartupProfile::SetNowFunction([]() { return fakeNow; });
+        auto Advance = [](int ms) { fakeNow += std::chrono::milliseconds(ms); };
+
+        StartupProfile::Start(std::chrono::seconds(0), nullptr);
+        {
+            const StartupProfile::PhaseTimer noScopeTimer(StartupProfile::Phase::JMC);
+            Advance(1);
+        }
+        for (const char *name : {"a.dll", "b.dll"})
+        {
+            StartupProfile::ModuleScope scope;
+            scope.SetName(name);
+            Advance(1);
+            {
+                const StartupProfile::PhaseTimer indexingTimer(StartupProfile::Phase::PDBIndexing);
+                Advance(3);
+                {
+                    const StartupProfile::PhaseTimer discoveryTimer(StartupProfile::Phase::PDBDiscovery);
+                    Advance(name[0] == 'a' ? 2 : 20);
+                }
+                Advance(1);
+            }
+            Advance(1);
+        }
+        {
+            const StartupProfile::CallbackTimer callbackTimer;
+            Advance(5);
+        }
+
+        StartupProfile::Report report;
+        StartupProfile::GetReport(report, 1);
+        const auto discovery = static_cast<size_t>(StartupProfile::Phase::PDBDiscovery);
+        const auto indexing = static_cast<size_t>(StartupProfile::Phase::PDBIndexing);
+        assert(report.elapsed == std::chrono::milliseconds(40));
+        assert(report.modulesCount == 2 && report.modules.size() == 1 && report.modules[0].name == "b.dll");
+        assert(report.modules[0].total == std::chrono::milliseconds(26));
+        assert(report.modules[0].phases[discovery] == std::chrono::milliseconds(20));
+        // Nested phase time is excluded from outer phase.
+        assert(report.modules[0].phases[indexing] == std::chrono::milliseconds(4));
+        assert(report.phases[discovery] == std::chrono::milliseconds(22) && report.phases[indexing] == std::chrono::milliseconds(8));
+        assert(report.phases[static_cast<size_t>(StartupProfile::Phase::JMC)].count() == 0);
+        assert(report.modulesTotal == std::chrono::milliseconds(34) && report.callbacksSuspended == std::chrono::milliseconds(5));
+
+        StartupProfile::SetNowFunction(nullptr);
+        StartupProfile::Start(std::chrono::seconds(0), nullptr);
+    }
+
+    // AllocationProfile
+    {
+        using dncdbg::AllocationProfile;
+        AllocationProfile::Report report;
+        AllocationProfile::GetReport(report, true);
+        {
+            const AllocationProfile::Scope scope(AllocationProfile::Kind::Request, "internalTests");
+            std::vector<char> outer(1000);
+            {
+                const AllocationProfile::Scope nestedScope(AllocationProfile::Kind::Callback, "InternalTests");
+                const std::vector<char> nested(100);
+                outer.at(0) = nested.at(0);
+            }
+        }
+
+        AllocationProfile::GetReport(report, true);
+        assert(report.enabled == AllocationProfile::IsEnabled());
+        if (report.enabled)
+        {
+            // Nested scope allocations are not accounted to outer scope.
+            uint64_t requestBytes = 0;
+            uint64_t callbackBytes = 0;
+            for (const AllocationProfile::TagStats &stats : report.tags)
+            {
+                if (stats.name == "internalTests" && stats.kind == AllocationProfile::Kind::Request)
+                {
+                    requestBytes = stats.bytes;
+                }
+                else if (stats.name == "InternalTests" && stats.kind == AllocationProfile::Kind::Callback)
+                {
+                    callbackBytes = stats.bytes;
+                }
+            }
+            assert(requestBytes >= 1000 && requestBytes < 1100 && callbackBytes >= 100 && callbackBytes < 1000);
+        }
+        else
+        {
+            assert(report.allocations == 0 && report.tags.empty());
+        }
+    }
+
     // Test UTF-8 to uppercase
     {
         const std::string testString = dncdbg::to_uppercase("привет, hello, auf wiedersehen, grüße, καλημέρα");
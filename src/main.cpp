@@ -6,9 +6,15 @@
 #include "buildinfo.h"
 #include "protocol/dap.h"
 #include "protocol/dapio.h"
+#include "debuginfo/symbolscache.h"
+#include "utils/allocationprofile.h"
+#include "utils/dapserver.h"
 #include "utils/logger.h"
+#include "utils/metrics.h"
 
 #include <algorithm>
+#include <charconv>
+#include <chrono>
 #include <clocale>
 #include <cstdlib>
 #include <iostream>
@@ -47,6 +53,13 @@ void print_help()
               << "                                         2 or WARNING\n"
               << "                                         3 or ERROR\n"
               << "                                         by default, set to INFO.\n"
+              << "--metricsInterval=<seconds>              Write runtime metrics to debugger log periodically.\n"
+              << "--server=<port>                          Run as server, accept protocol connections on local TCP port\n"
+              << "                                         (loopback interface only) and serve successive debug sessions,\n"
+              << "                                         module symbols are cached between sessions.\n"
+#ifndef _WIN32
+              << "--server=unix:<path>                     Same as above, but listen on Unix domain socket.\n"
+#endif
               << "--version                                Displays the current version.\n";
 }
 
@@ -81,6 +94,40 @@ void print_version()
     std::cout << "DNCDbg version " << BuildInfo::version << "\n";
 }
 
+// Serve debug sessions one by one, until listener error.
+int RunServer(const std::string &serverAddress)
+{
+    dncdbg::DAPServer server;
+    if (!server.Listen(serverAddress))
+    {
+        std::cerr << "Error: Can't listen on " << serverAddress << "\n";
+        return EXIT_FAILURE;
+    }
+
+    // Symbols of modules, loaded by previous sessions, are reused in case module is the same.
+    dncdbg::SymbolsCache::SetCapacity(dncdbg::SymbolsCache::DefaultServerCapacity);
+
+    while (server.Accept())
+    {
+        if (!dncdbg::DAPIO::OpenOutputSocket(server.GetClientSocket()))
+        {
+            continue;
+        }
+        dncdbg::DAPIO::StartOutputWriter();
+
+        {
+            dncdbg::DAP protocol;
+            protocol.CommandLoop(server.GetInput());
+        }
+
+        dncdbg::DAPIO::StopOutputWriter();
+        dncdbg::DAPIO::CloseOutputSocket();
+        LOGI(log << "Debug session finished");
+    }
+
+    return EXIT_FAILURE;
+}
+
 } // unnamed namespace
 
 int
@@ -107,6 +154,8 @@ int
     std::cin.tie(nullptr);
 
     std::string protocolLogFilePath;
+    std::string serverAddress;
+    std::chrono::seconds metricsInterval{0};
     try
     {
 #ifdef DEBUG_INTERNAL_TESTS
@@ -142,6 +191,20 @@ int
             }},
             {"--loglevel=", [&](const std::string &arg) {
                 dncdbg::Logger::SetLogLevel(arg.substr(strlen("--loglevel=")).c_str());
+            }},
+            {"--metricsInterval=", [&](const std::string &arg) {
+                const std::string value = arg.substr(strlen("--metricsInterval="));
+                unsigned seconds = 0;
+                const auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), seconds);
+                if (ec != std::errc() || ptr != value.data() + value.size())
+                {
+                    std::cerr << "Error: Invalid value " << arg << "\n";
+                    exit(EXIT_FAILURE);
+                }
+                metricsInterval = std::chrono::seconds(seconds);
+            }},
+            {"--server=", [&](const std::string &arg) {
+                serverAddress = arg.substr(strlen("--server="));
             }}
         };
 
@@ -197,8 +260,24 @@ int
         dncdbg::DAPIO::SetupProtocolLogging(protocolLogFilePath);
     }
 
+    dncdbg::Metrics::StartLogDump(metricsInterval);
+
+    if (!serverAddress.empty())
+    {
+        const int result = RunServer(serverAddress);
+        dncdbg::Metrics::StopLogDump();
+        dncdbg::AllocationProfile::LogReport();
+        return result;
+    }
+
+    dncdbg::DAPIO::StartOutputWriter();
+
     dncdbg::DAP protocol;
 
-    protocol.CommandLoop();
+    protocol.CommandLoop(std::cin);
+
+    dncdbg::DAPIO::StopOutputWriter();
+    dncdbg::Metrics::StopLogDump();
+    dncdbg::AllocationProfile::LogReport();
     return EXIT_SUCCESS;
 }
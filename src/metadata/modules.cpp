@@ -8,11 +8,12 @@
 #include "protocol/dapio.h"
 #include "utils/filesystem.h"
 #include "utils/hresult.h"
+#include "utils/memorycache.h"
 #include "utils/print.h"
+#include "utils/startupprofile.h"
 #include "utils/torelease.h"
 #include "utils/utf.h"
 #include <cassert>
-#include <iomanip>
 #include <sstream>
 
 #define MINIZ_NO_STDIO
@@ -139,11 +140,15 @@ HRESULT Modules::GetModulePdbInfo(ICorDebugModule *pModule, PDB::Identity &pdbId
     ToRelease<ICorDebugProcess> trProcess;
     IfFailRet(pModule->GetProcess(&trProcess));
 
+    // PE headers and debug directory are read by small parts, that usually belong to few first pages of image.
+    MemoryCache memoryCache([&](uint64_t addr, uint8_t *buffer, size_t size)
+        {
+            SIZE_T bytesRead = 0;
+            return SUCCEEDED(trProcess->ReadMemory(addr, static_cast<DWORD>(size), buffer, &bytesRead)) && bytesRead == size;
+        });
     auto readProcessMemory = [&](CORDB_ADDRESS addr, void *buffer, uint32_t size) -> HRESULT
     {
-        SIZE_T bytesRead = 0;
-        IfFailRet(trProcess->ReadMemory(addr, size, static_cast<uint8_t *>(buffer), &bytesRead));
-        return (bytesRead == size) ? S_OK : E_FAIL;
+        return (memoryCache.Read(addr, static_cast<uint8_t *>(buffer), size) == size) ? S_OK : E_FAIL;
     };
 
     // Read and validate DOS header
@@ -462,6 +467,7 @@ void Modules::LoadModuleMetadata(ICorDebugModule *pModule, Module &module, bool
                 // than step into the code. The .NET debugger considers all other code to be user code.
                 if (needJMC)
                 {
+                    const StartupProfile::PhaseTimer phaseTimer(StartupProfile::Phase::JMC);
                     DisableJMCByAttributes(pModule);
                 }
             }
@@ -503,12 +509,7 @@ void Modules::LoadModuleMetadata(ICorDebugModule *pModule, Module &module, bool
     if (SUCCEEDED(pModule->GetBaseAddress(&moduleBaseAddress)) &&
         SUCCEEDED(pModule->GetSize(&moduleSize)))
     {
-        static constexpr int32_t addrSize = 16; // CORDB_ADDRESS is ULONG64 for all arches.
-        std::ostringstream ss;
-        ss << "0x" << std::hex << std::setfill('0')
-           << std::setw(addrSize) << moduleBaseAddress << "-0x"
-           << std::setw(addrSize) << moduleBaseAddress + moduleSize;
-        module.addressRange = ss.str();
+        module.addressRange = PrintAddress(moduleBaseAddress) + "-" + PrintAddress(moduleBaseAddress + moduleSize);
     }
     else
     {
@@ -516,63 +517,159 @@ void Modules::LoadModuleMetadata(ICorDebugModule *pModule, Module &module, bool
     }
 }
 
-Module &Modules::GetNewModuleRef()
+// Caller must hold m_moduleMutex.
+void Modules::AddToIndexes(size_t index)
+{
+    const ModuleEntry &entry = m_modules[index];
+    m_mvidIndex.emplace(entry.module.id, index);
+    if (entry.baseAddress == 0)
+    {
+        return;
+    }
+
+    m_baseAddressIndex[entry.baseAddress] = index;
+    if (entry.size != 0)
+    {
+        m_addressRangeIndex[entry.baseAddress] = index;
+    }
+}
+
+// Caller must hold m_moduleMutex.
+void Modules::RebuildIndexes()
+{
+    m_baseAddressIndex.clear();
+    m_mvidIndex.clear();
+    m_addressRangeIndex.clear();
+    for (size_t i = 0; i < m_modules.size(); ++i)
+    {
+        AddToIndexes(i);
+    }
+}
+
+// Caller must hold m_moduleMutex.
+bool Modules::FindModuleIndex(CORDB_ADDRESS address, size_t &index)
 {
+    auto findBase = m_baseAddressIndex.find(address);
+    if (findBase != m_baseAddressIndex.end())
+    {
+        index = findBase->second;
+        return true;
+    }
+
+    // Find last module that start at or before address.
+    auto findRange = m_addressRangeIndex.upper_bound(address);
+    if (findRange == m_addressRangeIndex.begin())
+    {
+        return false;
+    }
+    --findRange;
+
+    const ModuleEntry &entry = m_modules[findRange->second];
+    if (address - entry.baseAddress >= entry.size)
+    {
+        return false;
+    }
+
+    index = findRange->second;
+    return true;
+}
+
+void Modules::AddModule(ICorDebugModule *pModule, const Module &module)
+{
+    ModuleEntry entry;
+    entry.module = module;
+    if (FAILED(pModule->GetBaseAddress(&entry.baseAddress)) ||
+        FAILED(pModule->GetSize(&entry.size)))
+    {
+        entry.baseAddress = 0;
+        entry.size = 0;
+    }
+
     const std::scoped_lock<std::mutex> lock(m_moduleMutex);
 
-    m_moduleList.emplace_back();
-    return m_moduleList.back();
+    m_modules.emplace_back(std::move(entry));
+    AddToIndexes(m_modules.size() - 1);
 }
 
 HRESULT Modules::RemoveModule(ICorDebugModule *pModule, Module &removedModule)
 {
     HRESULT Status = S_OK;
+    CORDB_ADDRESS baseAddress = 0;
     std::string id;
-    IfFailRet(GetModuleMvid(pModule, id));
+    if (FAILED(pModule->GetBaseAddress(&baseAddress)) || baseAddress == 0)
+    {
+        baseAddress = 0;
+        IfFailRet(GetModuleMvid(pModule, id));
+    }
 
     const std::scoped_lock<std::mutex> lock(m_moduleMutex);
 
-    for (auto it = m_moduleList.begin(); it != m_moduleList.end();)
+    size_t index = 0;
+    if (baseAddress != 0)
     {
-        if (it->id == id)
+        auto find = m_baseAddressIndex.find(baseAddress);
+        if (find == m_baseAddressIndex.end())
         {
-            removedModule = *it;
-            m_moduleList.erase(it);
-            return S_OK;
+            return E_INVALIDARG;
         }
-        else
+        index = find->second;
+    }
+    else
+    {
+        auto find = m_mvidIndex.find(id);
+        if (find == m_mvidIndex.end())
         {
-            ++it;
+            return E_INVALIDARG;
         }
+        index = find->second;
     }
 
-    return E_INVALIDARG;
+    removedModule = std::move(m_modules[index].module);
+    m_modules.erase(m_modules.begin() + static_cast<std::ptrdiff_t>(index));
+    // Note, unload is rare (collectible load contexts), so indexes are rebuilt instead of shifted.
+    RebuildIndexes();
+
+    return S_OK;
 }
 
 void Modules::GetModules(int startModule, int moduleCount, std::vector<Module> &modules, size_t &totalModules)
 {
     const std::scoped_lock<std::mutex> lock(m_moduleMutex);
 
-    totalModules = m_moduleList.size();
+    totalModules = m_modules.size();
 
-    assert(m_moduleList.size() <= static_cast<size_t>(std::numeric_limits<int>::max()));
-    if (startModule >= static_cast<int>(m_moduleList.size()))
+    assert(m_modules.size() <= static_cast<size_t>(std::numeric_limits<int>::max()));
+    if (startModule < 0 || startModule >= static_cast<int>(m_modules.size()))
     {
         return;
     }
 
-    auto startIt = std::next(m_moduleList.begin(), startModule);
-    auto endIt = m_moduleList.end();
-    if (moduleCount != 0 &&
-        startModule + moduleCount < static_cast<int>(m_moduleList.size()))
+    size_t endModule = m_modules.size();
+    if (moduleCount > 0 &&
+        startModule + moduleCount < static_cast<int>(m_modules.size()))
+    {
+        endModule = static_cast<size_t>(startModule + moduleCount);
+    }
+
+    modules.reserve(modules.size() + endModule - static_cast<size_t>(startModule));
+    for (size_t i = static_cast<size_t>(startModule); i < endModule; ++i)
     {
-        endIt = std::next(startIt, moduleCount);
+        modules.emplace_back(m_modules[i].module);
     }
+}
 
-    for (auto it = startIt; it != endIt; it = std::next(it))
+HRESULT Modules::GetModuleId(CORDB_ADDRESS address, std::string &id)
+{
+    const std::scoped_lock<std::mutex> lock(m_moduleMutex);
+
+    size_t index = 0;
+    if (!FindModuleIndex(address, index))
     {
-        modules.emplace_back(*it);
+        return E_FAIL;
     }
+
+    id = m_modules[index].module.id;
+    return S_OK;
 }
 
 HRESULT Modules::ForEachModule(ICorDebugThread *pThread, const std::function<HRESULT(ICorDebugModule *pModule)> &cb)
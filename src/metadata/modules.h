@@ -16,14 +16,20 @@
 #include "types/protocol.h"
 #include <array>
 #include <functional>
-#include <list>
+#include <map>
 #include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace dncdbg
 {
 
+// Registry of loaded modules.
+//
+// Modules are stored contiguously in load order (`modules` request paging is O(page size)) with indexes
+// by module base address, by MVID (same module could be loaded into several load contexts) and by
+// address range (any address inside module image to module). Indexes are rebuilt at module unload.
 class Modules
 {
   public:
@@ -33,17 +39,34 @@ class Modules
     static std::string GetModuleFilePath(ICorDebugModule *pModule);
     static void LoadModuleMetadata(ICorDebugModule *pModule, Module &module, bool needJMC, bool suppressJITOptimizations);
 
-    Module &GetNewModuleRef();
+    void AddModule(ICorDebugModule *pModule, const Module &module);
     HRESULT RemoveModule(ICorDebugModule *pModule, Module &removedModule);
     void GetModules(int startModule, int moduleCount, std::vector<Module> &modules, size_t &totalModules);
+    // Find module ID (MVID) by module base address or any address inside module image.
+    HRESULT GetModuleId(CORDB_ADDRESS address, std::string &id);
 
     static HRESULT ForEachModule(ICorDebugThread *pThread, const std::function<HRESULT(ICorDebugModule *pModule)> &cb);
     static HRESULT GetModuleWithName(ICorDebugThread *pThread, const std::string &name, ICorDebugModule **ppModule);
 
   private:
 
+    struct ModuleEntry
+    {
+        Module module;
+        CORDB_ADDRESS baseAddress{0};
+        uint32_t size{0};
+    };
+
     std::mutex m_moduleMutex;
-    std::list<Module> m_moduleList;
+    std::vector<ModuleEntry> m_modules;
+    std::unordered_map<CORDB_ADDRESS, size_t> m_baseAddressIndex;
+    std::unordered_multimap<std::string, size_t> m_mvidIndex;
+    std::map<CORDB_ADDRESS, size_t> m_addressRangeIndex; // Module image start address to module index.
+
+    // Caller must hold m_moduleMutex.
+    void AddToIndexes(size_t index);
+    void RebuildIndexes();
+    bool FindModuleIndex(CORDB_ADDRESS address, size_t &index);
 };
 
 } // namespace dncdbg
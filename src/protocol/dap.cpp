@@ -6,17 +6,29 @@
 #include "protocol/dap.h"
 #include "protocol/dapio.h"
 #include "debugger/manageddebugger.h"
+#include "debuginfo/debuginfo.h"
 #include "debuginfo/sourcefilemap.h"
+#include "utils/allocationprofile.h"
+#include "utils/cancellation.h"
 #include "utils/hresult.h"
 #include "utils/logger.h"
+#include "utils/metrics.h"
+#include "utils/print.h"
+#include "utils/startupprofile.h"
 #include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdlib>
 #include <exception>
 #include <future>
 #include <iterator>
 #include <iomanip>
-#include <iostream>
+#include <istream>
+#include <limits>
 #include <map>
 #include <sstream>
+#include <string_view>
+#include <system_error>
 #include <thread>
 #include <unordered_map>
 #include <unordered_set>
@@ -192,22 +204,135 @@ json FormJsonForExceptionDetails(const ExceptionDetails &details)
     return result;
 }
 
+// Metrics response body, for example:
+// {"elapsed": 1500, "counters": {"funcEvals": 3, ...},
+//  "histograms": {"funcEvalTimeUs": {"count": 3, "sum": 4200, "p50": 1023, ..., "buckets": [[2047, 1], ...]}, ...}}
+// Bucket is pair of upper bound and number of values, empty buckets are omitted.
+json MetricsToJson(const Metrics::Snapshot &snapshot)
+{
+    json counters = json::object();
+    for (size_t i = 0; i < snapshot.counters.size(); ++i)
+    {
+        counters.emplace(Metrics::GetName(static_cast<Metrics::Counter>(i)), snapshot.counters[i]);
+    }
+
+    json histograms = json::object();
+    for (size_t i = 0; i < snapshot.histograms.size(); ++i)
+    {
+        const Metrics::HistogramSnapshot &histogram = snapshot.histograms[i];
+        json buckets = json::array();
+        for (size_t j = 0; j < histogram.buckets.size(); ++j)
+        {
+            if (histogram.buckets[j] != 0)
+            {
+                const uint64_t upperBound = j < histogram.buckets.size() - 1 ? (uint64_t{1} << j) - 1
+                                                                              : std::numeric_limits<uint64_t>::max();
+                buckets.push_back(json::array({upperBound, histogram.buckets[j]}));
+            }
+        }
+
+        histograms.emplace(Metrics::GetName(static_cast<Metrics::Histogram>(i)),
+                           json{{"count", histogram.count},
+                                {"sum", histogram.sum},
+                                {"p50", histogram.Percentile(50)},
+                                {"p90", histogram.Percentile(90)},
+                                {"p99", histogram.Percentile(99)},
+                                {"max", histogram.max},
+                                {"buckets", std::move(buckets)}});
+    }
+
+    return json{{"elapsed", snapshot.elapsed.count()},
+                {"counters", std::move(counters)},
+                {"histograms", std::move(histograms)}};
+}
+
+json PhaseTimesToJson(const StartupProfile::PhaseTimes &phases)
+{
+    json result = json::object();
+    for (size_t i = 0; i < phases.size(); ++i)
+    {
+        result.emplace(StartupProfile::GetName(static_cast<StartupProfile::Phase>(i)), phases[i].count());
+    }
+    return result;
+}
+
+json StartupProfileToJson(const StartupProfile::Report &report)
+{
+    json modules = json::array();
+    for (const StartupProfile::ModuleTimes &moduleTimes : report.modules)
+    {
+        modules.push_back(json{{"name", moduleTimes.name},
+                               {"totalUs", moduleTimes.total.count()},
+                               {"phasesUs", PhaseTimesToJson(moduleTimes.phases)}});
+    }
+
+    return json{{"elapsed", report.elapsed.count()},
+                {"callbacksSuspendedUs", report.callbacksSuspended.count()},
+                {"modulesTotalUs", report.modulesTotal.count()},
+                {"modulesCount", report.modulesCount},
+                {"phasesUs", PhaseTimesToJson(report.phases)},
+                {"modules", std::move(modules)}};
+}
+
+json AllocationProfileToJson(const AllocationProfile::Report &report)
+{
+    json requests = json::array();
+    json callbacks = json::array();
+    for (const AllocationProfile::TagStats &stats : report.tags)
+    {
+        if (stats.kind == AllocationProfile::Kind::Request)
+        {
+            requests.push_back(json{{"command", stats.name}, {"allocations", stats.allocations}, {"bytes", stats.bytes}});
+        }
+        else
+        {
+            callbacks.push_back(json{{"callback", stats.name}, {"allocations", stats.allocations}, {"bytes", stats.bytes}});
+        }
+    }
+
+    return json{{"enabled", report.enabled},
+                {"elapsed", report.elapsed.count()},
+                {"allocations", report.allocations},
+                {"bytes", report.bytes},
+                {"untaggedAllocations", report.untaggedAllocations},
+                {"untaggedBytes", report.untaggedBytes},
+                {"requests", std::move(requests)},
+                {"callbacks", std::move(callbacks)}};
+}
+
+// Memory reference is hexadecimal address with optional "0x" prefix (see PrintAddress()),
+// sign, whitespaces and values out of 64-bit range are not allowed.
+bool ParseMemoryReference(std::string_view memoryReference, uint64_t &address)
+{
+    if (memoryReference.size() > 2 && memoryReference[0] == '0' && (memoryReference[1] == 'x' || memoryReference[1] == 'X'))
+    {
+        memoryReference.remove_prefix(2);
+    }
+
+    const char *end = memoryReference.data() + memoryReference.size();
+    static constexpr int base = 16;
+    auto result = std::from_chars(memoryReference.data(), end, address, base);
+    return !memoryReference.empty() && result.ec == std::errc() && result.ptr == end;
+}
+
 } // unnamed namespace
 
-HRESULT DAP::HandleCommand(const std::string &command, const nlohmann::json &arguments, nlohmann::json &responseBody)
+// Note, handlers capture `this`, so table must be created for each DAP object (DAP can't be copied or moved).
+void DAP::InitCommands()
 {
-    using CommandCallback = std::function<HRESULT(const json &arguments, json &responseBody)>;
-    static std::unordered_map<std::string, CommandCallback> commands{
-        {"initialize", [&](const json &/*arguments*/, json &responseBody)
+    m_commandsOwner = this;
+    m_commands = {
+        {"initialize", [this](const json &arguments, json &responseBody)
             {
                 m_sharedDebugger->Initialize();
                 // clientID, clientName, adapterID - not in use now
+                m_sharedDebugger->SetMemoryReferences(arguments.value("supportsMemoryReferences", false));
 
                 DAPIO::AddCapabilitiesTo(responseBody);
 
                 return S_OK;
             }},
-        {"setExceptionBreakpoints", [&](const json &arguments, json &/*responseBody*/)
+        {"setExceptionBreakpoints", [this](const json &arguments, json &/*responseBody*/)
             {
                 const std::vector<std::string> filters = arguments.value("filters", std::vector<std::string>());
                 std::vector<std::map<std::string, std::string>> filterOptions =
@@ -282,11 +407,11 @@ HRESULT DAP::HandleCommand(const std::string &command, const nlohmann::json &arg
 
                 return S_OK;
             }},
-        {"configurationDone", [&](const json &/*arguments*/, json &/*responseBody*/)
+        {"configurationDone", [this](const json &/*arguments*/, json &/*responseBody*/)
             {
                 return m_sharedDebugger->ConfigurationDone();
             }},
-        {"exceptionInfo", [&](const json &arguments, json &responseBody)
+        {"exceptionInfo", [this](const json &arguments, json &responseBody)
             {
                 HRESULT Status = S_OK;
                 const ThreadId threadId{static_cast<int>(arguments.at("threadId"))};
@@ -299,7 +424,7 @@ HRESULT DAP::HandleCommand(const std::string &command, const nlohmann::json &arg
                 responseBody.emplace("details", FormJsonForExceptionDetails(exceptionInfo.details));
                 return S_OK;
             }},
-        {"setBreakpoints", [&](const json &arguments, json &responseBody)
+        {"setBreakpoints", [this](const json &arguments, json &responseBody)
             {
                 HRESULT Status = S_OK;
 
@@ -320,8 +445,13 @@ HRESULT DAP::HandleCommand(const std::string &command, const nlohmann::json &arg
 
                 return S_OK;
             }},
-        {"launch", [&](const json &arguments, json &/*responseBody*/)
+        {"launch", [this](const json &arguments, json &/*responseBody*/)
             {
+                HRESULT Status = S_OK;
+                IfFailRet(SetCommandTimeouts(arguments));
+                m_sharedDebugger->SetStartupReportDelay(std::chrono::seconds(arguments.value("startupReportDelay", 0U)));
+                m_sharedDebugger->SetSymbolsIndexesBudget(arguments.value("symbolsIndexesBudget", static_cast<size_t>(0)));
+
                 auto cwdIt = arguments.find("cwd");
                 const std::string cwd(cwdIt != arguments.end() ? cwdIt.value().get<std::string>() : std::string{});
 
@@ -433,6 +563,19 @@ HRESULT DAP::HandleCommand(const std::string &command, const nlohmann::json &arg
                 }
                 m_sharedDebugger->SetEvalFlags(evalFlags);
 
+                if (arguments.contains("outputOptions"))
+                {
+                    const json &outputOptions = arguments.at("outputOptions");
+                    OutputCoalescer::Options options;
+                    const size_t readBufferSize = outputOptions.value("readBufferSize", IORedirect::DefaultReadBufferSize);
+                    options.flushInterval = std::chrono::milliseconds(outputOptions.value("flushInterval", options.flushInterval.count()));
+                    options.maxOutputSize = outputOptions.value("maxOutputSize", options.maxOutputSize);
+                    options.maxBacklogSize = outputOptions.value("maxBacklogSize", options.maxBacklogSize);
+                    m_sharedDebugger->SetOutputOptions(readBufferSize, options);
+                    m_sharedDebugger->SetMaxLogMessagesPerSecond(
+                        outputOptions.value("maxLogMessagesPerSecond", LogMessages::DefaultMaxMessagesPerSecond));
+                }
+
                 const bool stopAtEntry = arguments.value("stopAtEntry", false);
                 const std::string program = arguments.at("program").get<std::string>();
                 std::vector<std::string> args = arguments.value("args", std::vector<std::string>());
@@ -450,7 +593,7 @@ HRESULT DAP::HandleCommand(const std::string &command, const nlohmann::json &arg
                     return m_sharedDebugger->Launch(program, args, env, cwd, stopAtEntry);
                 }
             }},
-        {"threads", [&](const json &/*arguments*/, json &responseBody)
+        {"threads", [this](const json &/*arguments*/, json &responseBody)
             {
                 HRESULT Status = S_OK;
                 std::vector<Thread> threads;
@@ -460,7 +603,7 @@ HRESULT DAP::HandleCommand(const std::string &command, const nlohmann::json &arg
 
                 return S_OK;
             }},
-        {"disconnect", [&](const json &arguments, json &/*responseBody*/)
+        {"disconnect", [this](const json &arguments, json &/*responseBody*/)
             {
                 auto terminateArgIter = arguments.find("terminateDebuggee");
                 DisconnectAction action = DisconnectAction::Default;
@@ -478,12 +621,12 @@ HRESULT DAP::HandleCommand(const std::string &command, const nlohmann::json &arg
 
                 return S_OK;
             }},
-        {"terminate", [&](const json &/*arguments*/, json &/*responseBody*/)
+        {"terminate", [this](const json &/*arguments*/, json &/*responseBody*/)
             {
                 m_sharedDebugger->Disconnect(DisconnectAction::Terminate);
                 return S_OK;
             }},
-        {"stackTrace", [&](const json &arguments, json &responseBody)
+        {"stackTrace", [this](const json &arguments, json &responseBody)
             {
                 HRESULT Status = S_OK;
 
@@ -498,7 +641,7 @@ HRESULT DAP::HandleCommand(const std::string &command, const nlohmann::json &arg
 
                 return S_OK;
             }},
-        {"continue", [&](const json &arguments, json &responseBody)
+        {"continue", [this](const json &arguments, json &responseBody)
             {
                 responseBody.emplace("allThreadsContinued", true);
 
@@ -506,28 +649,28 @@ HRESULT DAP::HandleCommand(const std::string &command, const nlohmann::json &arg
                 responseBody.emplace("threadId", static_cast<int>(threadId));
                 return m_sharedDebugger->Continue(threadId);
             }},
-        {"pause", [&](const json &arguments, json &responseBody)
+        {"pause", [this](const json &arguments, json &responseBody)
             {
                 const ThreadId threadId{static_cast<int>(arguments.at("threadId"))};
                 responseBody.emplace("threadId", static_cast<int>(threadId));
                 return m_sharedDebugger->Pause(threadId);
             }},
-        {"next", [&](const json &arguments, json &/*responseBody*/)
+        {"next", [this](const json &arguments, json &/*responseBody*/)
             {
                 return m_sharedDebugger->StepCommand(ThreadId{static_cast<int>(arguments.at("threadId"))},
                                                      StepType::STEP_OVER);
             }},
-        {"stepIn", [&](const json &arguments, json &/*responseBody*/)
+        {"stepIn", [this](const json &arguments, json &/*responseBody*/)
             {
                 return m_sharedDebugger->StepCommand(ThreadId{static_cast<int>(arguments.at("threadId"))},
                                                      StepType::STEP_IN);
             }},
-        {"stepOut", [&](const json &arguments, json &/*responseBody*/)
+        {"stepOut", [this](const json &arguments, json &/*responseBody*/)
             {
                 return m_sharedDebugger->StepCommand(ThreadId{static_cast<int>(arguments.at("threadId"))},
                                                      StepType::STEP_OUT);
             }},
-        {"scopes", [&](const json &arguments, json &responseBody)
+        {"scopes", [this](const json &arguments, json &responseBody)
             {
                 HRESULT Status = S_OK;
                 std::vector<Scope> scopes;
@@ -538,7 +681,7 @@ HRESULT DAP::HandleCommand(const std::string &command, const nlohmann::json &arg
 
                 return S_OK;
             }},
-        {"variables", [&](const json &arguments, json &responseBody)
+        {"variables", [this](const json &arguments, json &responseBody)
             {
                 HRESULT Status = S_OK;
                 const std::string filterName = arguments.value("filter", "");
@@ -561,7 +704,7 @@ HRESULT DAP::HandleCommand(const std::string &command, const nlohmann::json &arg
 
                 return S_OK;
             }},
-        {"evaluate", [&](const json &arguments, json &responseBody)
+        {"evaluate", [this](const json &arguments, json &responseBody)
             {
                 std::string expression = arguments.at("expression");
                 const FrameId frameId([&]()
@@ -613,9 +756,13 @@ HRESULT DAP::HandleCommand(const std::string &command, const nlohmann::json &arg
                     responseBody.emplace("namedVariables", variable.namedVariables);
                     // indexedVariables
                 }
+                if (!variable.memoryReference.empty())
+                {
+                    responseBody.emplace("memoryReference", variable.memoryReference);
+                }
                 return S_OK;
             }},
-        {"setExpression", [&](const json &arguments, json &responseBody)
+        {"setExpression", [this](const json &arguments, json &responseBody)
             {
                 const std::string expression = arguments.at("expression");
                 const std::string value = arguments.at("value");
@@ -654,8 +801,20 @@ HRESULT DAP::HandleCommand(const std::string &command, const nlohmann::json &arg
                 responseBody.emplace("value", output);
                 return S_OK;
             }},
-        {"attach", [&](const json &arguments, json &/*responseBody*/)
+        {"attach", [this](const json &arguments, json &/*responseBody*/)
             {
+                HRESULT Status = S_OK;
+                IfFailRet(SetCommandTimeouts(arguments));
+                m_sharedDebugger->SetStartupReportDelay(std::chrono::seconds(arguments.value("startupReportDelay", 0U)));
+                m_sharedDebugger->SetSymbolsIndexesBudget(arguments.value("symbolsIndexesBudget", static_cast<size_t>(0)));
+
+                // Note, debuggee output is not redirected on attach, only Debugger.Log() messages options are used.
+                if (arguments.contains("outputOptions"))
+                {
+                    m_sharedDebugger->SetMaxLogMessagesPerSecond(arguments.at("outputOptions").value(
+                        "maxLogMessagesPerSecond", LogMessages::DefaultMaxMessagesPerSecond));
+                }
+
                 const DWORD processId = arguments.value("processId", 0);
                 if (processId == 0)
                 {
@@ -664,7 +823,7 @@ HRESULT DAP::HandleCommand(const std::string &command, const nlohmann::json &arg
 
                 return m_sharedDebugger->Attach(processId);
             }},
-        {"setVariable", [&](const json &arguments, json &responseBody)
+        {"setVariable", [this](const json &arguments, json &responseBody)
             {
                 const std::string name = arguments.at("name");
                 const std::string value = arguments.at("value");
@@ -682,7 +841,7 @@ HRESULT DAP::HandleCommand(const std::string &command, const nlohmann::json &arg
 
                 return S_OK;
             }},
-        {"setFunctionBreakpoints", [&](const json &arguments, json &responseBody)
+        {"setFunctionBreakpoints", [this](const json &arguments, json &responseBody)
             {
                 HRESULT Status = S_OK;
 
@@ -712,7 +871,36 @@ HRESULT DAP::HandleCommand(const std::string &command, const nlohmann::json &arg
 
                 return Status;
             }},
-        {"modules", [&](const json &arguments, json &responseBody)
+        {"readMemory", [this](const json &arguments, json &responseBody)
+            {
+                uint64_t reference = 0;
+                if (!ParseMemoryReference(arguments.at("memoryReference").get<std::string>(), reference))
+                {
+                    return E_INVALIDARG;
+                }
+                const int64_t offset = arguments.value("offset", static_cast<int64_t>(0));
+                const int64_t count = arguments.at("count");
+                if (count < 0)
+                {
+                    return E_INVALIDARG;
+                }
+
+                const uint64_t address = reference + static_cast<uint64_t>(offset);
+                HRESULT Status = S_OK;
+                std::string data;
+                size_t unreadableBytes = 0;
+                IfFailRet(m_sharedDebugger->ReadMemory(address, static_cast<uint64_t>(count), data, unreadableBytes));
+
+                responseBody.emplace("address", PrintAddress(address));
+                if (unreadableBytes > 0)
+                {
+                    responseBody.emplace("unreadableBytes", unreadableBytes);
+                }
+                responseBody.emplace("data", std::move(data));
+
+                return S_OK;
+            }},
+        {"modules", [this](const json &arguments, json &responseBody)
             {
                 size_t totalModules = 0;
                 std::vector<Module> modules;
@@ -722,16 +910,81 @@ HRESULT DAP::HandleCommand(const std::string &command, const nlohmann::json &arg
                 responseBody.emplace("modules", modules);
                 responseBody.emplace("totalModules", totalModules);
 
+                return S_OK;
+            }},
+        {"metrics", [this](const json &arguments, json &responseBody)
+            {
+                // Custom request, "reset": true - start new measurement period after snapshot.
+                Metrics::Snapshot snapshot;
+                Metrics::GetSnapshot(snapshot, arguments.value("reset", false));
+                responseBody = MetricsToJson(snapshot);
+
+                return S_OK;
+            }},
+        {"startupProfile", [this](const json &arguments, json &responseBody)
+            {
+                // Custom request, "maxModules" - slowest modules count in response (all modules by default).
+                StartupProfile::Report report;
+                StartupProfile::GetReport(report, arguments.value("maxModules", std::numeric_limits<size_t>::max()));
+                responseBody = StartupProfileToJson(report);
+
+                return S_OK;
+            }},
+        {"symbolsMemory", [this](const json &/*arguments*/, json &responseBody)
+            {
+                // Custom request, memory held by loaded modules symbols, most recently used modules first.
+                std::vector<ModuleSymbolsMemory> symbolsMemory;
+                m_sharedDebugger->GetSymbolsMemory(symbolsMemory);
+
+                size_t pdbDataSize = 0;
+                size_t sourceNamesSize = 0;
+                size_t indexesSize = 0;
+                json modules = json::array();
+                for (const ModuleSymbolsMemory &module : symbolsMemory)
+                {
+                    pdbDataSize += module.pdbDataSize;
+                    sourceNamesSize += module.sourceNamesSize;
+                    indexesSize += module.indexesSize;
+                    modules.push_back(json{{"address", PrintAddress(module.modAddress)},
+                                           {"symbolFilePath", module.symbolFilePath},
+                                           {"pdbDataSize", module.pdbDataSize},
+                                           {"sourceNamesSize", module.sourceNamesSize},
+                                           {"indexesSize", module.indexesSize},
+                                           {"indexesEvicted", module.indexesEvicted}});
+                }
+
+                responseBody.emplace("pdbDataSize", pdbDataSize);
+                responseBody.emplace("sourceNamesSize", sourceNamesSize);
+                responseBody.emplace("indexesSize", indexesSize);
+                responseBody.emplace("modules", std::move(modules));
+
+                return S_OK;
+            }},
+        {"allocationProfile", [this](const json &arguments, json &responseBody)
+            {
+                // Custom request, "reset": true - start new measurement period after report,
+                // "maxTags" - requests and callbacks with most allocated bytes count in response (all by default).
+                AllocationProfile::Report report;
+                AllocationProfile::GetReport(report, arguments.value("reset", false),
+                                             arguments.value("maxTags", std::numeric_limits<size_t>::max()));
+                responseBody = AllocationProfileToJson(report);
+
                 return S_OK;
             }}};
+}
+
+HRESULT DAP::HandleCommand(const std::string &command, const nlohmann::json &arguments, nlohmann::json &responseBody)
+{
+    // Handlers must not call into another (already destroyed) DAP object, for example, in case of server mode sessions.
+    assert(m_commandsOwner == this);
 
     if (m_sharedDebugger == nullptr)
     {
         return CORDBG_E_DEBUGGING_DISABLED;
     }
 
-    auto command_it = commands.find(command);
-    if (command_it == commands.end())
+    auto command_it = m_commands.find(command);
+    if (command_it == m_commands.end())
     {
         return E_NOTIMPL;
     }
@@ -741,6 +994,7 @@ HRESULT DAP::HandleCommand(const std::string &command, const nlohmann::json &arg
 
 HRESULT DAP::HandleCommandJSON(const std::string &command, const nlohmann::json &arguments, nlohmann::json &responseBody)
 {
+    const AllocationProfile::Scope allocationScope(AllocationProfile::Kind::Request, command);
     try
     {
         return HandleCommand(command, arguments, responseBody);
@@ -781,31 +1035,30 @@ void DAP::CommandsWorker()
             break;
         }
 
+        // Note, command is executed in separate thread, so CommandsWorker() could respond in time even if command
+        // execution hangs. In case of timeout command is canceled (running evaluation is aborted, long operations
+        // stop at next cancellation check), so it don't hold debugger after response was sent.
+        // Note, timeouts could be changed by launch/attach command execution, get it before command started.
+        const std::chrono::milliseconds timeout = GetCommandTimeout(c.command);
+        CancellationToken cancellationToken;
         json responseBody = json::object();
-        std::future<HRESULT> future = std::async(std::launch::async, [&]()
+        std::future<HRESULT> future = std::async(std::launch::async, [&, cancellationToken]()
             {
+                const CancellationScope cancellationScope(cancellationToken);
                 return HandleCommandJSON(c.command, c.arguments, responseBody);
             });
+
         HRESULT Status = S_OK;
-        // Note, CommandsWorker() loop should never hangs, but even in case some command execution is timed out,
-        // this could be not critical issue. Let IDE decide.
-
-        // MSVS debugger use config file, for Visual Studio 2022 Community Edition located at
-        // C:\Program Files\Microsoft Visual Studio\2022\Community\Common7\IDE\Profiles\CSharp.vssettings
-        // Visual Studio has timeout setup for each type of requests, for example:
-        // LocalsTimeout = 1000
-        // LongEvalTimeout = 10000
-        // NormalEvalTimeout = 5000
-        // QuickwatchTimeout = 15000
-        // SetValueTimeout = 10000
-        // ...
-        // we use max default timeout (15000), one timeout for all requests.
-
-        // TODO add timeout configuration feature
-        const std::future_status timeoutStatus = future.wait_for(std::chrono::milliseconds(15000));
-        if (timeoutStatus == std::future_status::timeout)
+        const bool timedOut = timeout.count() != 0 &&
+                              future.wait_for(timeout) == std::future_status::timeout;
+        if (timedOut)
         {
-            responseBody.emplace("message", "Command execution timed out.");
+            LOGW(log << "Command '" << c.command << "' execution timed out (" << timeout.count() << " ms), cancel it");
+            cancellationToken.Cancel();
+            if (m_sharedDebugger != nullptr)
+            {
+                m_sharedDebugger->CancelEvalRunning();
+            }
             Status = COR_E_TIMEOUT;
         }
         else
@@ -813,7 +1066,13 @@ void DAP::CommandsWorker()
             Status = future.get();
         }
 
-        if (SUCCEEDED(Status))
+        if (timedOut)
+        {
+            // Note, `responseBody` still could be changed by command execution thread, don't use it.
+            c.response.emplace("message", "Command execution timed out.");
+            c.response.emplace("success", false);
+        }
+        else if (SUCCEEDED(Status))
         {
             c.response.emplace("success", true);
             c.response.emplace("body", responseBody);
@@ -837,6 +1096,13 @@ void DAP::CommandsWorker()
 
         DAPIO::EmitMessageWithLog(LOG_RESPONSE, c.response);
 
+        if (timedOut)
+        {
+            // Canceled command should finish soon, but next command can't be executed before this one finished.
+            future.wait();
+            LOGI(log << "Canceled command '" << c.command << "' finished");
+        }
+
         // Post command action.
         if (GetSyncCommandExecutionSet().find(c.command) != GetSyncCommandExecutionSet().end())
         {
@@ -860,6 +1126,57 @@ void DAP::CommandsWorker()
     m_exit = true;
 }
 
+HRESULT DAP::SetCommandTimeouts(const json &arguments)
+{
+    // Timeouts in milliseconds, for example:
+    // "commandTimeouts": { "default": 15000, "evaluate": 5000, "variables": 1000 }
+    auto findTimeouts = arguments.find("commandTimeouts");
+    if (findTimeouts == arguments.end())
+    {
+        return S_OK;
+    }
+    if (!findTimeouts->is_object())
+    {
+        LOGE(log << "Wrong 'commandTimeouts' value, object expected");
+        return E_INVALIDARG;
+    }
+
+    std::chrono::milliseconds defaultTimeout = DefaultCommandTimeout;
+    std::unordered_map<std::string, std::chrono::milliseconds> timeouts;
+    for (const auto &entry : findTimeouts->items())
+    {
+        if (!entry.value().is_number_unsigned() ||
+            entry.value().get<uint64_t>() > static_cast<uint64_t>(MaxCommandTimeout.count()))
+        {
+            LOGE(log << "Wrong timeout value for '" << entry.key() << "' command, integer in range [0, "
+                     << MaxCommandTimeout.count() << "] expected");
+            return E_INVALIDARG;
+        }
+
+        const std::chrono::milliseconds timeout(entry.value().get<uint64_t>());
+        if (entry.key() == "default")
+        {
+            defaultTimeout = timeout;
+        }
+        else
+        {
+            timeouts[entry.key()] = timeout;
+        }
+    }
+
+    const std::lock_guard<std::mutex> lock(m_commandTimeoutsMutex);
+    m_defaultCommandTimeout = defaultTimeout;
+    m_commandTimeouts.swap(timeouts);
+    return S_OK;
+}
+
+std::chrono::milliseconds DAP::GetCommandTimeout(const std::string &command)
+{
+    const std::lock_guard<std::mutex> lock(m_commandTimeoutsMutex);
+    auto find = m_commandTimeouts.find(command);
+    return find != m_commandTimeouts.end() ? find->second : m_defaultCommandTimeout;
+}
+
 // Caller must hold m_commandsMutex.
 std::list<DAP::CommandQueueEntry>::iterator DAP::CancelCommand(const std::list<DAP::CommandQueueEntry>::iterator &iter)
 {
@@ -869,8 +1186,10 @@ std::list<DAP::CommandQueueEntry>::iterator DAP::CancelCommand(const std::list<D
     return m_commandsQueue.erase(iter);
 }
 
-void DAP::CommandLoop()
+void DAP::CommandLoop(std::istream &input)
 {
+    // In server mode, source file map could be set up by previous session.
+    SourceFileMap::GetMap().clear();
     CreateManagedDebugger();
     std::thread commandsWorker{&DAP::CommandsWorker, this};
 
@@ -878,7 +1197,7 @@ void DAP::CommandLoop()
 
     while (!m_exit)
     {
-        const std::string requestText = ReadData(std::cin);
+        const std::string requestText = ReadData(input);
         if (requestText.empty())
         {
             // Input read failed for some reason, initiate forced disconnect.
@@ -892,6 +1211,8 @@ void DAP::CommandLoop()
         }
 
         DAPIO::Log(LOG_COMMAND, requestText);
+        Metrics::Add(Metrics::Counter::DAPRequestsRead);
+        Metrics::Add(Metrics::Counter::DAPBytesRead, static_cast<int64_t>(requestText.size()));
 
         struct bad_format : public std::invalid_argument
         {
@@ -10,12 +10,17 @@
 #include "types/protocol.h"
 #include <json/json.hpp>
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <fstream>
+#include <functional>
+#include <istream>
+#include <limits>
 #include <list>
 #include <mutex>
 #include <string>
 #include <string_view>
+#include <unordered_map>
 
 namespace dncdbg
 {
@@ -30,10 +35,17 @@ class DAP
         : m_exit(false),
           m_sharedDebugger(nullptr)
     {
+        InitCommands();
     }
+    DAP(DAP &&) = delete;
+    DAP(const DAP &) = delete;
+    DAP &operator=(DAP &&) = delete;
+    DAP &operator=(const DAP &) = delete;
+    ~DAP() = default;
 
     void CreateManagedDebugger();
-    void CommandLoop();
+    // Read and execute protocol requests from `input` until disconnect or input EOF.
+    void CommandLoop(std::istream &input);
 
     HRESULT HandleCommand(const std::string &command, const nlohmann::json &arguments, nlohmann::json &body);
     HRESULT HandleCommandJSON(const std::string &command, const nlohmann::json &arguments, nlohmann::json &body);
@@ -43,11 +55,29 @@ class DAP
     std::atomic<bool> m_exit;
     std::shared_ptr<ManagedDebugger> m_sharedDebugger;
 
+    using CommandCallback = std::function<HRESULT(const nlohmann::json &arguments, nlohmann::json &body)>;
+    std::unordered_map<std::string, CommandCallback> m_commands;
+    const DAP *m_commandsOwner{nullptr};
+
+    void InitCommands();
+
     std::string m_fileExec;
     std::vector<std::string> m_execArgs;
 
     bool m_internalConsole{false};
 
+    // Visual Studio 2022 use max timeout 15000 for quickwatch, use it as default for all commands.
+    static constexpr std::chrono::milliseconds DefaultCommandTimeout{15000};
+    static constexpr std::chrono::milliseconds MaxCommandTimeout{std::numeric_limits<uint32_t>::max()};
+    // Command execution timeouts, zero timeout means no timeout. Changed by launch/attach command, that executed
+    // in separate thread, so, protected by mutex.
+    std::mutex m_commandTimeoutsMutex;
+    std::chrono::milliseconds m_defaultCommandTimeout{DefaultCommandTimeout};
+    std::unordered_map<std::string, std::chrono::milliseconds> m_commandTimeouts;
+
+    HRESULT SetCommandTimeouts(const nlohmann::json &arguments);
+    std::chrono::milliseconds GetCommandTimeout(const std::string &command);
+
     struct CommandQueueEntry
     {
         std::string command;
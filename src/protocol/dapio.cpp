@@ -4,7 +4,11 @@
 // See the LICENSE file in the project root for more information.
 
 #include "protocol/dapio.h"
-#include <iostream>
+#include "utils/logger.h"
+#include "utils/metrics.h"
+#include <array>
+#include <cassert>
+#include <cstdio>
 
 // for convenience
 using json = nlohmann::json;
@@ -12,8 +16,16 @@ using json = nlohmann::json;
 namespace dncdbg
 {
 
+MPSCQueue<DAPIO::OutputEntry> DAPIO::m_outQueue;
+std::mutex DAPIO::m_writerMutex;
+std::condition_variable DAPIO::m_writerCV;
+std::thread DAPIO::m_writerThread;
+std::atomic<bool> DAPIO::m_writerRunning{false};
+std::atomic<bool> DAPIO::m_writerStop{false};
+std::atomic<size_t> DAPIO::m_pendingSize{0};
 std::mutex DAPIO::m_outMutex;
 uint64_t DAPIO::m_seqCounter = 1;
+bool DAPIO::m_socketOutput = false;
 
 void to_json(json &j, const Source &s)
 {
@@ -96,6 +108,11 @@ void to_json(json &j, const Variable &v)
         j.emplace("namedVariables", v.namedVariables);
         // j.emplace("indexedVariables", v.indexedVariables);
     }
+
+    if (!v.memoryReference.empty())
+    {
+        j.emplace("memoryReference", v.memoryReference);
+    }
 }
 
 void to_json(json &j, const Module &m)
@@ -163,6 +180,7 @@ void DAPIO::AddCapabilitiesTo(json &capabilities)
     capabilities.emplace("supportsHitConditionalBreakpoints", true);
     capabilities.emplace("supportsModulesRequest", true);
     capabilities.emplace("supportsLogPoints", true);
+    capabilities.emplace("supportsReadMemoryRequest", true);
 }
 
 void DAPIO::SetupProtocolLogging(const std::string &path)
@@ -172,6 +190,7 @@ void DAPIO::SetupProtocolLogging(const std::string &path)
         return;
     }
 
+    GetProtocolLogStart() = std::chrono::steady_clock::now();
     GetProtocolLog().open(path);
 }
 
@@ -384,21 +403,218 @@ void DAPIO::EmitCapabilitiesEvent()
 }
 
 // Caller must hold m_outMutex.
-void DAPIO::EmitMessage(nlohmann::json &message, std::string &output)
+void DAPIO::WriteBatch(std::vector<OutputEntry> &batch)
+{
+    // Each message is sent as 3 chunks: header, `seq` field (assigned here, so `seq` order is the same as
+    // messages order in output) and serialized message without its opening brace.
+    std::vector<std::string> headers;
+    std::vector<std::string> seqFields;
+    std::vector<std::string_view> chunks;
+    size_t batchSize = 0;
+    size_t sentSize = 0;
+    headers.reserve(batch.size());
+    seqFields.reserve(batch.size());
+    chunks.reserve(batch.size() * 3);
+
+    for (const auto &entry : batch)
+    {
+        batchSize += entry.text.size();
+        if (!entry.send)
+        {
+            continue;
+        }
+
+        assert(entry.text.size() >= 2 && entry.text.front() == '{');
+        std::string seqField(R"({"seq":)");
+        seqField += std::to_string(m_seqCounter);
+        ++m_seqCounter;
+        if (entry.text.size() > 2) // not empty object
+        {
+            seqField += ',';
+        }
+
+        std::string header(CONTENT_LENGTH);
+        header += std::to_string(seqField.size() + entry.text.size() - 1);
+        header += TWO_CRLF;
+
+        headers.emplace_back(std::move(header));
+        seqFields.emplace_back(std::move(seqField));
+        chunks.emplace_back(headers.back());
+        chunks.emplace_back(seqFields.back());
+        chunks.emplace_back(std::string_view(entry.text).substr(1));
+        sentSize += headers.back().size() + seqFields.back().size() + entry.text.size() - 1;
+    }
+
+    if (!chunks.empty())
+    {
+        if (!GetOutputHandle().IsOpen() && !m_socketOutput)
+        {
+            GetOutputHandle().OpenStdout();
+        }
+        const size_t messages = headers.size();
+        // Note, in server mode output is discarded while no client connected (see CloseOutputSocket()).
+        if (GetOutputHandle().IsOpen() && !GetOutputHandle().WriteAll(chunks))
+        {
+            LOGE(log << "DAPIO: protocol output write failed, " << messages << " messages lost");
+        }
+
+        Metrics::Add(Metrics::Counter::DAPMessagesWritten, static_cast<int64_t>(messages));
+        Metrics::Add(Metrics::Counter::DAPBytesWritten, static_cast<int64_t>(sentSize));
+        Metrics::Add(Metrics::Counter::DAPBatchesWritten);
+        Metrics::Record(Metrics::Histogram::DAPBatchMessages, messages);
+        Metrics::Record(Metrics::Histogram::DAPBatchBytes, sentSize);
+    }
+    m_pendingSize.fetch_sub(batchSize, std::memory_order_relaxed);
+
+    if (!GetProtocolLog().is_open())
+    {
+        return;
+    }
+
+    // Protocol log is flushed once per batch, after messages were sent.
+    size_t seqIndex = 0;
+    std::array<char, 32> timeField{};
+    for (const auto &entry : batch)
+    {
+        const std::chrono::duration<double> time = entry.time - GetProtocolLogStart();
+        std::snprintf(timeField.data(), timeField.size(), "[%.6f] ", time.count());
+        GetProtocolLog() << timeField.data() << entry.prefix;
+        if (entry.send)
+        {
+            GetProtocolLog() << seqFields.at(seqIndex) << std::string_view(entry.text).substr(1);
+            ++seqIndex;
+        }
+        else
+        {
+            GetProtocolLog() << entry.text;
+        }
+        GetProtocolLog() << '\n';
+    }
+    GetProtocolLog().flush();
+}
+
+void DAPIO::WriterWorker()
 {
-    message.emplace("seq", m_seqCounter);
-    ++m_seqCounter;
-    output = message.dump();
-    std::cout << CONTENT_LENGTH << output.size() << TWO_CRLF << output;
-    std::cout.flush();
+    std::vector<OutputEntry> batch;
+
+    while (true)
+    {
+        std::unique_lock<std::mutex> lockWriterMutex(m_writerMutex);
+        m_writerCV.wait(lockWriterMutex, []() { return !m_outQueue.Empty() || m_writerStop.load(); });
+        lockWriterMutex.unlock();
+
+        // All messages queued during previous batch write are coalesced into one write call.
+        const std::scoped_lock<std::mutex> lockOutMutex(m_outMutex);
+        m_outQueue.PopAll(batch);
+        if (batch.empty())
+        {
+            break; // Stop requested and queue drained.
+        }
+
+        WriteBatch(batch);
+        batch.clear();
+    }
 }
 
-void DAPIO::EmitMessageWithLog(std::string_view message_prefix, nlohmann::json &message)
+void DAPIO::StartOutputWriter()
+{
+    if (m_writerRunning.load())
+    {
+        return;
+    }
+
+    {
+        const std::scoped_lock<std::mutex> lock(m_outMutex);
+        if (!GetOutputHandle().IsOpen() && !m_socketOutput)
+        {
+            GetOutputHandle().OpenStdout();
+        }
+    }
+
+    m_writerStop = false;
+    m_writerThread = std::thread(&DAPIO::WriterWorker);
+    m_writerRunning = true;
+}
+
+void DAPIO::StopOutputWriter()
 {
+    if (!m_writerRunning.load())
+    {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lockWriterMutex(m_writerMutex);
+    m_writerStop = true;
+    m_writerCV.notify_one(); // notify_one with lock
+    lockWriterMutex.unlock();
+
+    m_writerThread.join();
+    m_writerRunning = false;
+    // Pairs with fence in PushOutput(), see comment there.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    // Messages could be queued after writer thread exit, but before m_writerRunning changed.
+    const std::scoped_lock<std::mutex> lock(m_outMutex);
+    std::vector<OutputEntry> batch;
+    m_outQueue.PopAll(batch);
+    WriteBatch(batch);
+}
+
+bool DAPIO::OpenOutputSocket(OutputHandle::NativeSocket socket)
+{
+    assert(!m_writerRunning.load());
     const std::scoped_lock<std::mutex> lock(m_outMutex);
-    std::string output;
-    EmitMessage(message, output);
-    LogInternal(message_prefix, output);
+    m_socketOutput = true;
+    m_seqCounter = 1;
+    return GetOutputHandle().OpenSocket(socket);
+}
+
+void DAPIO::CloseOutputSocket()
+{
+    const std::scoped_lock<std::mutex> lock(m_outMutex);
+    assert(m_socketOutput);
+    GetOutputHandle().Close();
+}
+
+void DAPIO::PushOutput(OutputEntry &&entry)
+{
+    entry.time = std::chrono::steady_clock::now();
+    m_pendingSize.fetch_add(entry.text.size(), std::memory_order_relaxed);
+
+    if (!m_writerRunning.load())
+    {
+        const std::scoped_lock<std::mutex> lock(m_outMutex);
+        std::vector<OutputEntry> batch;
+        m_outQueue.PopAll(batch); // Keep order with entries queued before writer thread stop.
+        batch.emplace_back(std::move(entry));
+        WriteBatch(batch);
+        return;
+    }
+
+    if (m_outQueue.Push(std::move(entry)))
+    {
+        // Queue was empty, writer thread could wait for notification.
+        const std::scoped_lock<std::mutex> lock(m_writerMutex);
+        m_writerCV.notify_one(); // notify_one with lock
+    }
+
+    // Writer could be stopped after m_writerRunning check above, but before push, in this case StopOutputWriter()
+    // final drain could miss this entry. With fences, either StopOutputWriter() drain see pushed entry, or we see
+    // m_writerRunning changed and write queue synchronously.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!m_writerRunning.load())
+    {
+        const std::scoped_lock<std::mutex> lock(m_outMutex);
+        std::vector<OutputEntry> batch;
+        m_outQueue.PopAll(batch);
+        WriteBatch(batch);
+    }
+}
+
+void DAPIO::EmitMessageWithLog(std::string_view message_prefix, nlohmann::json &message)
+{
+    // Note, message serialization is done by caller thread, `seq` field is added by writer.
+    PushOutput({message_prefix, message.dump(), true});
 }
 
 void DAPIO::EmitEvent(const std::string &name, const nlohmann::json &body)
@@ -410,21 +626,14 @@ void DAPIO::EmitEvent(const std::string &name, const nlohmann::json &body)
     EmitMessageWithLog(LOG_EVENT, message);
 }
 
-// Caller must hold m_outMutex.
-void DAPIO::LogInternal(std::string_view prefix, const std::string &text)
+void DAPIO::Log(std::string_view prefix, const std::string &text)
 {
     if (!GetProtocolLog().is_open())
     {
         return;
     }
 
-    GetProtocolLog() << prefix << text << std::endl; // NOLINT(performance-avoid-endl)
-}
-
-void DAPIO::Log(std::string_view prefix, const std::string &text)
-{
-    const std::scoped_lock<std::mutex> lock(m_outMutex);
-    LogInternal(prefix, text);
+    PushOutput({prefix, text, false});
 }
 
 } // namespace dncdbg
@@ -8,11 +8,18 @@
 
 #include "types/types.h"
 #include "types/protocol.h"
+#include "utils/mpscqueue.h"
+#include "utils/outputhandle.h"
 #include <json/json.hpp>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <fstream>
 #include <mutex>
 #include <string>
 #include <string_view>
+#include <thread>
+#include <vector>
 
 namespace dncdbg
 {
@@ -37,6 +44,22 @@ class DAPIO
 
     static void SetupProtocolLogging(const std::string &path);
 
+    // Start dedicated writer thread for protocol output. Messages emitted before start
+    // (or after stop) are written synchronously by caller thread.
+    static void StartOutputWriter();
+    // Write all pending messages and stop writer thread.
+    static void StopOutputWriter();
+    // Server mode, switch protocol output to accepted client socket (see DAPServer) and restart `seq` numbering.
+    // Note, must be called while writer thread is stopped.
+    static bool OpenOutputSocket(OutputHandle::NativeSocket socket);
+    // Server mode, close client socket output. Messages emitted till next OpenOutputSocket() call are discarded.
+    static void CloseOutputSocket();
+    // Size of serialized messages queued for writer thread, but not written yet.
+    static size_t GetPendingOutputSize()
+    {
+        return m_pendingSize.load(std::memory_order_relaxed);
+    }
+
     static const std::unordered_map<std::string, ExceptionBreakpointFilter> &GetExceptionFilters();
     static void AddCapabilitiesTo(nlohmann::json &capabilities);
 
@@ -63,13 +86,44 @@ class DAPIO
         static std::ofstream protocolLog;
         return protocolLog;
     }
+    // Protocol log records are prefixed by time since protocol log start (used by `dap_replay` for original pacing).
+    static std::chrono::steady_clock::time_point &GetProtocolLogStart()
+    {
+        static std::chrono::steady_clock::time_point protocolLogStart;
+        return protocolLogStart;
+    }
+
+    // Serialized message (without `seq` field) or protocol log only record.
+    struct OutputEntry
+    {
+        std::string_view prefix;
+        std::string text;
+        bool send;
+        std::chrono::steady_clock::time_point time{};
+    };
+
+    static OutputHandle &GetOutputHandle()
+    {
+        static OutputHandle outputHandle;
+        return outputHandle;
+    }
+
+    static MPSCQueue<OutputEntry> m_outQueue;
+    static std::mutex m_writerMutex;
+    static std::condition_variable m_writerCV;
+    static std::thread m_writerThread;
+    static std::atomic<bool> m_writerRunning;
+    static std::atomic<bool> m_writerStop;
+    static std::atomic<size_t> m_pendingSize;
 
     static std::mutex m_outMutex;
     static uint64_t m_seqCounter; // Note, this counter must be covered by m_outMutex.
+    static bool m_socketOutput; // Note, this flag must be covered by m_outMutex.
 
-    static void EmitMessage(nlohmann::json &message, std::string &output);
+    static void PushOutput(OutputEntry &&entry);
+    static void WriterWorker();
+    static void WriteBatch(std::vector<OutputEntry> &batch);
     static void EmitEvent(const std::string &name, const nlohmann::json &body);
-    static void LogInternal(std::string_view prefix, const std::string &text);
 };
 
 } // namespace dncdbg
@@ -351,7 +351,7 @@ struct Variable
     uint32_t variablesReference{0};
     int namedVariables{0};
     int indexedVariables{0};
-    // memoryReference?: string;
+    std::string memoryReference;
     // declarationLocationReference?: number;
     // valueLocationReference?: number;
 };
@@ -0,0 +1,378 @@
+// Copyright (c) 2026 Mikhail Kurinnoi
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "utils/allocationprofile.h"
+#include "utils/logger.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <new>
+#include <utility>
+#ifdef _WIN32
+#include <malloc.h>
+#endif // _WIN32
+
+namespace dncdbg
+{
+
+namespace
+{
+
+#ifdef ALLOCATION_PROFILE
+
+constexpr size_t cacheLineSize = 64;
+// Tags over limit are accounted as untagged.
+constexpr uint32_t maxTags = 512;
+constexpr uint32_t untaggedTag = 0;
+constexpr size_t kindCount = static_cast<size_t>(AllocationProfile::Kind::Count);
+
+struct alignas(cacheLineSize) TagCounters
+{
+    std::atomic<uint64_t> allocations;
+    std::atomic<uint64_t> bytes;
+};
+
+// Note, used by operator new, so must not have dynamic initialization (static storage is zero initialized).
+std::array<TagCounters, maxTags> tagCounters;
+thread_local uint32_t currentTag = untaggedTag;
+
+struct TagsState
+{
+    std::mutex mutex;
+    std::array<std::map<std::string, uint32_t, std::less<>>, kindCount> tagsByName;
+    std::vector<std::pair<AllocationProfile::Kind, std::string>> tags{{AllocationProfile::Kind::Request, ""}};
+    std::chrono::steady_clock::time_point resetTime = std::chrono::steady_clock::now();
+};
+
+TagsState &GetTagsState()
+{
+    static TagsState tagsState;
+    return tagsState;
+}
+
+// Create state at process start, so report elapsed time covers the same period as counters.
+[[maybe_unused]] const TagsState &tagsStateInit = GetTagsState();
+
+uint32_t GetTag(AllocationProfile::Kind kind, std::string_view name)
+{
+    TagsState &state = GetTagsState();
+    const std::scoped_lock<std::mutex> lock(state.mutex);
+
+    auto &tagsByName = state.tagsByName[static_cast<size_t>(kind)];
+    auto find = tagsByName.find(name);
+    if (find != tagsByName.end())
+    {
+        return find->second;
+    }
+
+    if (state.tags.size() >= maxTags)
+    {
+        return untaggedTag;
+    }
+
+    const auto tag = static_cast<uint32_t>(state.tags.size());
+    state.tags.emplace_back(kind, std::string(name));
+    tagsByName.emplace(std::string(name), tag);
+    return tag;
+}
+
+void RecordAllocation(size_t size)
+{
+    TagCounters &counters = tagCounters[currentTag];
+    counters.allocations.fetch_add(1, std::memory_order_relaxed);
+    counters.bytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+uint64_t ReadValue(std::atomic<uint64_t> &value, bool reset)
+{
+    return reset ? value.exchange(0, std::memory_order_relaxed) : value.load(std::memory_order_relaxed);
+}
+
+void *AllocateAligned(size_t size, size_t alignment)
+{
+#ifdef _WIN32
+    return _aligned_malloc(size, alignment);
+#else
+    void *ptr = nullptr;
+    return posix_memalign(&ptr, std::max(alignment, sizeof(void *)), size) == 0 ? ptr : nullptr;
+#endif // _WIN32
+}
+
+void FreeAligned(void *ptr)
+{
+#ifdef _WIN32
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif // _WIN32
+}
+
+// Same as default operator new: call new handler until allocation succeeds or throw std::bad_alloc.
+template <typename Allocator>
+void *Allocate(size_t size, Allocator allocator)
+{
+    RecordAllocation(size);
+    if (size == 0)
+    {
+        size = 1;
+    }
+
+    while (true)
+    {
+        void *ptr = allocator(size);
+        if (ptr != nullptr)
+        {
+            return ptr;
+        }
+
+        const std::new_handler handler = std::get_new_handler();
+        if (handler == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+#endif // ALLOCATION_PROFILE
+
+} // unnamed namespace
+
+#ifdef ALLOCATION_PROFILE
+
+AllocationProfile::Scope::Scope(Kind kind, std::string_view name)
+    : m_prevTag(currentTag)
+{
+    // New tag registration allocations are accounted as untagged.
+    currentTag = untaggedTag;
+    currentTag = GetTag(kind, name);
+}
+
+AllocationProfile::Scope::~Scope()
+{
+    currentTag = m_prevTag;
+}
+
+void AllocationProfile::GetReport(Report &report, bool reset, size_t maxTags)
+{
+    report = Report();
+    report.enabled = true;
+
+    TagsState &state = GetTagsState();
+    const std::scoped_lock<std::mutex> lock(state.mutex);
+
+    const auto now = std::chrono::steady_clock::now();
+    report.elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - state.resetTime);
+    if (reset)
+    {
+        state.resetTime = now;
+    }
+
+    report.untaggedAllocations = ReadValue(tagCounters[untaggedTag].allocations, reset);
+    report.untaggedBytes = ReadValue(tagCounters[untaggedTag].bytes, reset);
+    report.allocations = report.untaggedAllocations;
+    report.bytes = report.untaggedBytes;
+
+    for (size_t i = untaggedTag + 1; i < state.tags.size(); ++i)
+    {
+        TagStats stats;
+        stats.allocations = ReadValue(tagCounters[i].allocations, reset);
+        stats.bytes = ReadValue(tagCounters[i].bytes, reset);
+        if (stats.allocations == 0)
+        {
+            continue;
+        }
+
+        stats.kind = state.tags[i].first;
+        stats.name = state.tags[i].second;
+        report.allocations += stats.allocations;
+        report.bytes += stats.bytes;
+        report.tags.emplace_back(std::move(stats));
+    }
+
+    std::stable_sort(report.tags.begin(), report.tags.end(),
+                     [](const TagStats &a, const TagStats &b) { return a.bytes > b.bytes; });
+    if (report.tags.size() > maxTags)
+    {
+        report.tags.resize(maxTags);
+    }
+}
+
+#else
+
+void AllocationProfile::GetReport(Report &report, bool /*reset*/, size_t /*maxTags*/)
+{
+    report = Report();
+}
+
+#endif // ALLOCATION_PROFILE
+
+void AllocationProfile::WriteReport(std::ostream &out, const Report &report)
+{
+    if (!report.enabled)
+    {
+        out << "Allocation profile is not available (build without ALLOCATION_PROFILE)\n";
+        return;
+    }
+
+    out << "Allocation profile (" << report.elapsed.count() << "ms): allocations=" << report.allocations
+        << " bytes=" << report.bytes << ", untagged: allocations=" << report.untaggedAllocations
+        << " bytes=" << report.untaggedBytes << '\n';
+
+    for (const TagStats &stats : report.tags)
+    {
+        out << "  " << GetName(stats.kind) << ' ' << stats.name << ": allocations=" << stats.allocations
+            << " bytes=" << stats.bytes << '\n';
+    }
+}
+
+void AllocationProfile::LogReport()
+{
+    if (!IsEnabled())
+    {
+        return;
+    }
+
+    Report report;
+    GetReport(report);
+    LOGI(WriteReport(log, report));
+}
+
+const char *AllocationProfile::GetName(Kind kind)
+{
+    static const std::array<const char *, static_cast<size_t>(Kind::Count)> names{
+        "request",
+        "callback"
+    };
+    return names[static_cast<size_t>(kind)];
+}
+
+} // namespace dncdbg
+
+#ifdef ALLOCATION_PROFILE
+
+// Replaced global allocation functions, all forms are replaced for allocation/deallocation functions consistency.
+
+void *operator new(std::size_t size)
+{
+    return dncdbg::Allocate(size, [](std::size_t allocSize) { return std::malloc(allocSize); });
+}
+
+void *operator new[](std::size_t size)
+{
+    return ::operator new(size);
+}
+
+void *operator new(std::size_t size, const std::nothrow_t & /*tag*/) noexcept
+{
+    try
+    {
+        return ::operator new(size);
+    }
+    catch (...)
+    {
+        return nullptr;
+    }
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &tag) noexcept
+{
+    return ::operator new(size, tag);
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment)
+{
+    return dncdbg::Allocate(size, [alignment](std::size_t allocSize)
+        {
+            return dncdbg::AllocateAligned(allocSize, static_cast<std::size_t>(alignment));
+        });
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return ::operator new(size, alignment);
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t & /*tag*/) noexcept
+{
+    try
+    {
+        return ::operator new(size, alignment);
+    }
+    catch (...)
+    {
+        return nullptr;
+    }
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t &tag) noexcept
+{
+    return ::operator new(size, alignment, tag);
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t /*size*/) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t /*size*/) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, const std::nothrow_t & /*tag*/) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr, const std::nothrow_t & /*tag*/) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::align_val_t /*alignment*/) noexcept
+{
+    dncdbg::FreeAligned(ptr);
+}
+
+void operator delete[](void *ptr, std::align_val_t /*alignment*/) noexcept
+{
+    dncdbg::FreeAligned(ptr);
+}
+
+void operator delete(void *ptr, std::size_t /*size*/, std::align_val_t /*alignment*/) noexcept
+{
+    dncdbg::FreeAligned(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t /*size*/, std::align_val_t /*alignment*/) noexcept
+{
+    dncdbg::FreeAligned(ptr);
+}
+
+void operator delete(void *ptr, std::align_val_t /*alignment*/, const std::nothrow_t & /*tag*/) noexcept
+{
+    dncdbg::FreeAligned(ptr);
+}
+
+void operator delete[](void *ptr, std::align_val_t /*alignment*/, const std::nothrow_t & /*tag*/) noexcept
+{
+    dncdbg::FreeAligned(ptr);
+}
+
+#endif // ALLOCATION_PROFILE
@@ -0,0 +1,103 @@
+// Copyright (c) 2026 Mikhail Kurinnoi
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#ifndef UTILS_ALLOCATIONPROFILE_H
+#define UTILS_ALLOCATIONPROFILE_H
+
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace dncdbg
+{
+
+// AllocationProfile counts heap allocations (operator new calls and requested bytes) by DAP command and debugger
+// callback type, intended for heap churn sources search and allocation reduction work verification.
+//
+// Allocations are counted only in instrumented build (`-DALLOCATION_PROFILE=1`), where global operator new/delete
+// are replaced, in other builds Scope does nothing. Allocation is accounted to innermost Scope of current thread,
+// allocations out of any scope (protocol I/O, runtime threads, etc) are accounted as untagged.
+class AllocationProfile
+{
+  public:
+
+    // Note, `GetName()` must be updated in case of new entry.
+    enum class Kind : uint8_t
+    {
+        Request,  // DAP command handler, tag name is command.
+        Callback, // Debugger callback, tag name is callback type (ICorDebugManagedCallback method name).
+        Count // Must be last.
+    };
+
+    // Account allocations of current thread to tag from object creation to destruction.
+    class Scope
+    {
+      public:
+
+#ifdef ALLOCATION_PROFILE
+        Scope(Kind kind, std::string_view name);
+        ~Scope();
+#else
+        Scope(Kind /*kind*/, std::string_view /*name*/)
+        {
+        }
+        ~Scope() = default;
+#endif // ALLOCATION_PROFILE
+        Scope(Scope &&) = delete;
+        Scope(const Scope &) = delete;
+        Scope &operator=(Scope &&) = delete;
+        Scope &operator=(const Scope &) = delete;
+
+#ifdef ALLOCATION_PROFILE
+      private:
+
+        uint32_t m_prevTag;
+#endif // ALLOCATION_PROFILE
+    };
+
+    struct TagStats
+    {
+        Kind kind = Kind::Request;
+        std::string name;
+        uint64_t allocations = 0;
+        uint64_t bytes = 0;
+    };
+
+    struct Report
+    {
+        bool enabled = false; // Instrumented build.
+        std::chrono::milliseconds elapsed{0}; // Time since process start or previous reset.
+        uint64_t allocations = 0; // Include untagged.
+        uint64_t bytes = 0;
+        uint64_t untaggedAllocations = 0;
+        uint64_t untaggedBytes = 0;
+        std::vector<TagStats> tags; // Most allocated bytes first, tags without allocations are not included.
+    };
+
+    static constexpr bool IsEnabled()
+    {
+#ifdef ALLOCATION_PROFILE
+        return true;
+#else
+        return false;
+#endif // ALLOCATION_PROFILE
+    }
+
+    // In case `reset` is true, counters are set to zero right after read.
+    static void GetReport(Report &report, bool reset = false,
+                          size_t maxTags = std::numeric_limits<size_t>::max());
+    static void WriteReport(std::ostream &out, const Report &report);
+    // Write report into debugger log (instrumented build only).
+    static void LogReport();
+
+    static const char *GetName(Kind kind);
+};
+
+} // namespace dncdbg
+
+#endif // UTILS_ALLOCATIONPROFILE_H
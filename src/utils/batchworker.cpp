@@ -0,0 +1,97 @@
+// Copyright (c) 2026 Mikhail Kurinnoi
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "utils/batchworker.h"
+
+namespace dncdbg
+{
+
+BatchWorker::BatchWorker(std::mutex &mutex, ReadyCallback readyCallback, DeliverCallback deliverCallback)
+    : m_mutex(mutex),
+      m_readyCallback(std::move(readyCallback)),
+      m_deliverCallback(std::move(deliverCallback))
+{
+}
+
+BatchWorker::~BatchWorker()
+{
+    // Note, callbacks could refer already destroyed owner data at this point, don't deliver anything.
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_stop = true;
+    m_cv.notify_one(); // notify_one with lock
+    lock.unlock();
+
+    if (m_worker.joinable())
+    {
+        m_worker.join();
+    }
+}
+
+// Caller must hold m_mutex.
+void BatchWorker::Start()
+{
+    if (!m_worker.joinable() && !m_stop)
+    {
+        m_worker = std::thread(&BatchWorker::Worker, this);
+    }
+}
+
+// Caller must hold m_mutex.
+void BatchWorker::Notify()
+{
+    m_cv.notify_one(); // notify_one with lock
+}
+
+void BatchWorker::Flush()
+{
+    Deliver(true);
+}
+
+void BatchWorker::Stop()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_stop = true;
+    m_cv.notify_one(); // notify_one with lock
+    lock.unlock();
+
+    if (m_worker.joinable())
+    {
+        m_worker.join();
+    }
+
+    Flush();
+}
+
+void BatchWorker::Worker()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (!m_stop)
+    {
+        Clock::time_point deadline = Clock::time_point::max();
+        if (!m_readyCallback(Clock::now(), deadline))
+        {
+            if (deadline == Clock::time_point::max())
+            {
+                m_cv.wait(lock);
+            }
+            else
+            {
+                m_cv.wait_until(lock, deadline);
+            }
+            continue;
+        }
+
+        lock.unlock();
+        Deliver(false);
+        lock.lock();
+    }
+}
+
+void BatchWorker::Deliver(bool flush)
+{
+    const std::scoped_lock<std::mutex> lockDeliver(m_deliverMutex);
+    m_deliverCallback(flush);
+}
+
+} // namespace dncdbg
@@ -0,0 +1,69 @@
+// Copyright (c) 2026 Mikhail Kurinnoi
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#ifndef UTILS_BATCHWORKER_H
+#define UTILS_BATCHWORKER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace dncdbg
+{
+
+// BatchWorker is worker thread, that delivers data stored by producers in batches.
+//
+// Owner keeps stored data protected by its own mutex (passed to constructor). Producers store data with
+// owner mutex held and call Start()/Notify(). Worker thread wakes up, checks with ReadyCallback (called
+// with owner mutex held) that stored data should be delivered and calls DeliverCallback (called without
+// owner mutex). Flush() calls DeliverCallback from caller thread, delivery order between worker thread
+// and Flush() callers is kept.
+class BatchWorker
+{
+  public:
+
+    using Clock = std::chrono::steady_clock;
+    // Returns `true` in case stored data should be delivered now, otherwise `deadline` could be decreased to
+    // time point when check must be repeated (by default, worker waits for Notify() call).
+    using ReadyCallback = std::function<bool(Clock::time_point now, Clock::time_point &deadline)>;
+    // `flush` is `true` for Flush() and Stop() calls, all stored data should be delivered regardless of thresholds.
+    using DeliverCallback = std::function<void(bool flush)>;
+
+    BatchWorker(std::mutex &mutex, ReadyCallback readyCallback, DeliverCallback deliverCallback);
+    BatchWorker(BatchWorker &&) = delete;
+    BatchWorker(const BatchWorker &) = delete;
+    BatchWorker &operator=(BatchWorker &&) = delete;
+    BatchWorker &operator=(const BatchWorker &) = delete;
+    ~BatchWorker();
+
+    // Caller must hold owner mutex. Start worker thread, in case it was not started or stopped yet.
+    void Start();
+    // Caller must hold owner mutex. Wake up worker thread in order to check stored data.
+    void Notify();
+    // Deliver stored data from caller thread now.
+    void Flush();
+    // Stop worker thread and deliver all stored data. Must be called by owner destructor, since callbacks
+    // refer owner data.
+    void Stop();
+
+  private:
+
+    // Note, in case m_deliverMutex+m_mutex, m_deliverMutex must be locked first.
+    std::mutex m_deliverMutex; // Keep delivery order between worker thread and Flush() calls.
+    std::mutex &m_mutex;
+    std::condition_variable m_cv;
+    ReadyCallback m_readyCallback;
+    DeliverCallback m_deliverCallback;
+    std::thread m_worker;
+    bool m_stop{false};
+
+    void Worker();
+    void Deliver(bool flush);
+};
+
+} // namespace dncdbg
+
+#endif // UTILS_BATCHWORKER_H
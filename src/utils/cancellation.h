@@ -0,0 +1,90 @@
+// Copyright (c) 2026 Mikhail Kurinnoi
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#ifndef UTILS_CANCELLATION_H
+#define UTILS_CANCELLATION_H
+
+#include <atomic>
+#include <memory>
+
+namespace dncdbg
+{
+
+// Cooperative cancellation of protocol command execution.
+//
+// Protocol side create token for each command and bind it to the thread that execute command with
+// CancellationScope. Long running operations (evaluation, variables expansion, stack walk) check
+// IsCurrentCanceled() at safe points and return COR_E_OPERATIONCANCELED.
+//
+// Note, token is bound to thread, so code executed on other threads (managed callbacks, steppers)
+// is never canceled.
+class CancellationToken
+{
+  public:
+
+    CancellationToken()
+        : m_canceled(std::make_shared<std::atomic<bool>>(false))
+    {
+    }
+
+    void Cancel()
+    {
+        m_canceled->store(true, std::memory_order_release);
+    }
+
+    [[nodiscard]] bool IsCanceled() const
+    {
+        return m_canceled->load(std::memory_order_acquire);
+    }
+
+    // Check token bound to current thread, `false` in case thread have no bound token.
+    static bool IsCurrentCanceled()
+    {
+        const CancellationToken *token = CurrentToken();
+        return token != nullptr && token->IsCanceled();
+    }
+
+  private:
+
+    friend class CancellationScope;
+
+    static const CancellationToken *&CurrentToken()
+    {
+        static thread_local const CancellationToken *currentToken = nullptr;
+        return currentToken;
+    }
+
+    // Shared by all token copies.
+    std::shared_ptr<std::atomic<bool>> m_canceled;
+};
+
+// Bind token to current thread for scope lifetime.
+class CancellationScope
+{
+  public:
+
+    explicit CancellationScope(const CancellationToken &token)
+        : m_previous(CancellationToken::CurrentToken())
+    {
+        CancellationToken::CurrentToken() = &token;
+    }
+
+    CancellationScope(CancellationScope &&) = delete;
+    CancellationScope(const CancellationScope &) = delete;
+    CancellationScope &operator=(CancellationScope &&) = delete;
+    CancellationScope &operator=(const CancellationScope &) = delete;
+
+    ~CancellationScope()
+    {
+        CancellationToken::CurrentToken() = m_previous;
+    }
+
+  private:
+
+    const CancellationToken *m_previous;
+};
+
+} // namespace dncdbg
+
+#endif // UTILS_CANCELLATION_H
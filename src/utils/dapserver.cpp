@@ -0,0 +1,102 @@
+// Copyright (c) 2026 Mikhail Kurinnoi
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "utils/dapserver.h"
+#include "utils/logger.h"
+#include <cerrno>
+#include <cstdlib>
+
+namespace dncdbg
+{
+
+namespace
+{
+
+constexpr std::string_view unixSocketPrefix("unix:");
+
+} // unnamed namespace
+
+DAPServer::DAPServer()
+    : m_inputBuffer(*this),
+      m_input(&m_inputBuffer)
+{
+}
+
+DAPServer::~DAPServer()
+{
+    CloseClient();
+    CloseListener();
+
+    if (m_platformStarted)
+    {
+        PlatformCleanup();
+    }
+}
+
+bool DAPServer::Listen(const std::string &address)
+{
+    if (!m_platformStarted)
+    {
+        if (!PlatformStartup())
+        {
+            return false;
+        }
+        m_platformStarted = true;
+    }
+
+    if (address.rfind(unixSocketPrefix, 0) == 0)
+    {
+        const std::string path = address.substr(unixSocketPrefix.size());
+        if (path.empty())
+        {
+            LOGE(log << "DAPServer: empty Unix domain socket path");
+            return false;
+        }
+        return CreateUnixListener(path);
+    }
+
+    char *end = nullptr;
+    errno = 0;
+    static constexpr int base = 10;
+    static constexpr long maxPort = 65535;
+    const long port = std::strtol(address.c_str(), &end, base);
+    if (address.empty() || errno == ERANGE || *end != 0 || port <= 0 || port > maxPort)
+    {
+        LOGE(log << "DAPServer: wrong server address '" << address << "'");
+        return false;
+    }
+    return CreateTcpListener(static_cast<int>(port));
+}
+
+bool DAPServer::Accept()
+{
+    CloseClient();
+    return AcceptClient();
+}
+
+void DAPServer::CloseClient()
+{
+    CloseClientSocket();
+    m_inputBuffer.Reset();
+    m_input.clear();
+}
+
+DAPServer::InputBuffer::int_type DAPServer::InputBuffer::underflow()
+{
+    if (gptr() < egptr())
+    {
+        return traits_type::to_int_type(*gptr());
+    }
+
+    const int size = m_server.Recv(gsl::span<char>(m_buffer.data(), m_buffer.size()));
+    if (size <= 0)
+    {
+        return traits_type::eof();
+    }
+
+    setg(m_buffer.data(), m_buffer.data(), m_buffer.data() + size);
+    return traits_type::to_int_type(*gptr());
+}
+
+} // namespace dncdbg
@@ -0,0 +1,122 @@
+// Copyright (c) 2026 Mikhail Kurinnoi
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#ifndef UTILS_DAPSERVER_H
+#define UTILS_DAPSERVER_H
+
+#include "utils/outputhandle.h"
+#include <gsl/span>
+#include <array>
+#include <istream>
+#include <streambuf>
+#include <string>
+
+namespace dncdbg
+{
+
+// DAPServer is a protocol server for `--server` mode, so one debugger process serves successive
+// debug sessions (one client at a time) instead of stdin/stdout protocol channel.
+//
+// Listen address is a TCP port (loopback interface only) or `unix:<path>` for Unix domain socket
+// (not supported on Windows). Accepted client socket is switched into nonblocking mode, with big
+// socket buffers and TCP_NODELAY (for TCP), so small protocol messages are not delayed and big
+// responses don't stall on small kernel buffers.
+//
+// Protocol input is read by GetInput() stream, that wait for socket readability in case no data.
+// Protocol output is written by DAPIO into client socket (see DAPIO::OpenOutputSocket()).
+class DAPServer
+{
+  public:
+
+    using NativeSocket = OutputHandle::NativeSocket;
+
+    DAPServer();
+    DAPServer(DAPServer &&) = delete;
+    DAPServer(const DAPServer &) = delete;
+    DAPServer &operator=(DAPServer &&) = delete;
+    DAPServer &operator=(const DAPServer &) = delete;
+    ~DAPServer();
+
+    // Create listener for `port` or `unix:<path>` address. Returns true on success.
+    bool Listen(const std::string &address);
+
+    // Wait for next client connection, previous client (if any) is closed. Returns false on listener error.
+    bool Accept();
+
+    [[nodiscard]] NativeSocket GetClientSocket() const
+    {
+        return m_client;
+    }
+
+    // Protocol input of accepted client, EOF in case client closed connection or on read error.
+    std::istream &GetInput()
+    {
+        return m_input;
+    }
+
+    void CloseClient();
+
+  private:
+
+    // Input stream buffer, that reads from client socket.
+    class InputBuffer : public std::streambuf
+    {
+      public:
+
+        explicit InputBuffer(DAPServer &server)
+            : m_server(server)
+        {
+            Reset();
+        }
+
+        // Discard buffered data of previous client.
+        void Reset()
+        {
+            setg(m_buffer.data(), m_buffer.data(), m_buffer.data());
+        }
+
+      protected:
+
+        int_type underflow() override;
+
+      private:
+
+        DAPServer &m_server;
+        std::array<char, 64 * 1024> m_buffer{};
+    };
+
+    // Size of socket send and receive buffers, big enough for most of protocol messages
+    // (for example, big variables or stack trace responses) could be sent by one call.
+    static constexpr int SocketBufferSize = 1024 * 1024;
+
+    // Per-OS helpers.
+    static bool PlatformStartup();
+    static void PlatformCleanup();
+    [[nodiscard]] bool CreateTcpListener(int port);
+    [[nodiscard]] bool CreateUnixListener(const std::string &path);
+    [[nodiscard]] bool AcceptClient();
+    void CloseListener();
+    void CloseClientSocket();
+    // Read available data, wait for socket readability in case no data.
+    // Returns number of bytes read (>0), 0 on disconnect, -1 on error.
+    [[nodiscard]] int Recv(gsl::span<char> buffer);
+
+#ifdef _WIN32
+    static constexpr NativeSocket invalidSocket = ~static_cast<NativeSocket>(0); // INVALID_SOCKET
+#endif // _WIN32
+#ifdef FEATURE_PAL
+    static constexpr NativeSocket invalidSocket = -1;
+#endif // FEATURE_PAL
+
+    bool m_platformStarted{false};
+    NativeSocket m_listener{invalidSocket};
+    NativeSocket m_client{invalidSocket};
+    std::string m_unixSocketPath; // Removed at listener close.
+    InputBuffer m_inputBuffer;
+    std::istream m_input;
+};
+
+} // namespace dncdbg
+
+#endif // UTILS_DAPSERVER_H
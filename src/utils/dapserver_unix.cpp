@@ -0,0 +1,283 @@
+// Copyright (c) 2026 Mikhail Kurinnoi
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#ifdef FEATURE_PAL
+
+#include "utils/dapserver.h"
+#include "utils/logger.h"
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/types.h> // NOLINT(misc-include-cleaner)
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace dncdbg
+{
+
+namespace
+{
+
+void SetCloseOnExec(int fd)
+{
+    const int flags = ::fcntl(fd, F_GETFD, 0); // NOLINT(cppcoreguidelines-pro-type-vararg)
+    if (flags >= 0)
+    {
+        static_cast<void>(::fcntl(fd, F_SETFD, flags | FD_CLOEXEC)); // NOLINT(cppcoreguidelines-pro-type-vararg)
+    }
+}
+
+bool SetNonBlocking(int fd)
+{
+    const int flags = ::fcntl(fd, F_GETFL, 0); // NOLINT(cppcoreguidelines-pro-type-vararg)
+    return flags >= 0 && ::fcntl(fd, F_SETFL, flags | O_NONBLOCK) >= 0; // NOLINT(cppcoreguidelines-pro-type-vararg)
+}
+
+bool BindSocket(int s, const sockaddr *addr, socklen_t addrLen)
+{
+    if (::bind(s, addr, addrLen) < 0)
+    {
+        LOGE(log << "DAPServer: bind() failed, errno=" << errno);
+        return false;
+    }
+
+    return true;
+}
+
+bool ListenSocket(int s)
+{
+    if (::listen(s, 1) < 0)
+    {
+        LOGE(log << "DAPServer: listen() failed, errno=" << errno);
+        return false;
+    }
+
+    return true;
+}
+
+} // unnamed namespace
+
+bool DAPServer::PlatformStartup()
+{
+    // Ignore SIGPIPE, so write into socket closed by IDE return EPIPE instead of killing the process.
+    static_cast<void>(::signal(SIGPIPE, SIG_IGN));
+    return true;
+}
+
+void DAPServer::PlatformCleanup()
+{
+    // Nothing to do on POSIX.
+}
+
+bool DAPServer::CreateTcpListener(int port)
+{
+    CloseListener();
+
+    const int s = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (s < 0)
+    {
+        LOGE(log << "DAPServer: socket() failed, errno=" << errno);
+        return false;
+    }
+    SetCloseOnExec(s);
+
+    int reuse = 1;
+    if (::setsockopt(s, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse)) < 0)
+    {
+        LOGW(log << "DAPServer: setsockopt(SO_REUSEADDR) failed, errno=" << errno);
+    }
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(static_cast<uint16_t>(port));
+    // Bind to loopback only, debugger must not be reachable from network.
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    if (!BindSocket(s, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) || !ListenSocket(s))
+    {
+        ::close(s);
+        return false;
+    }
+
+    m_listener = s;
+    return true;
+}
+
+bool DAPServer::CreateUnixListener(const std::string &path)
+{
+    CloseListener();
+
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(addr.sun_path))
+    {
+        LOGE(log << "DAPServer: Unix domain socket path is too long: " << path);
+        return false;
+    }
+    std::memcpy(static_cast<char *>(addr.sun_path), path.c_str(), path.size() + 1);
+
+    const int s = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (s < 0)
+    {
+        LOGE(log << "DAPServer: socket() failed, errno=" << errno);
+        return false;
+    }
+    SetCloseOnExec(s);
+
+    // Remove stale socket file left by previous server process, but never remove other files.
+    struct stat st{};
+    if (::lstat(path.c_str(), &st) == 0 && S_ISSOCK(st.st_mode))
+    {
+        ::unlink(path.c_str());
+    }
+
+    // Only current user could connect to debugger. Socket file must be created with owner only access rights by
+    // bind() (connect() require write access), since chmod() after bind() leave window for other users to connect.
+    // Note, umask is process wide, but server listener is created at startup, before any session could create files.
+    const mode_t prevMask = ::umask(S_IXUSR | S_IRWXG | S_IRWXO);
+    const bool bound = BindSocket(s, reinterpret_cast<sockaddr *>(&addr), sizeof(addr));
+    static_cast<void>(::umask(prevMask));
+    if (!bound)
+    {
+        ::close(s);
+        return false;
+    }
+
+    // Socket file access rights could be ignored by bind() on some systems, make sure nobody else have access
+    // before start listening.
+    if (::chmod(path.c_str(), S_IRUSR | S_IWUSR) < 0)
+    {
+        LOGE(log << "DAPServer: chmod() failed, errno=" << errno);
+        ::close(s);
+        ::unlink(path.c_str());
+        return false;
+    }
+
+    if (!ListenSocket(s))
+    {
+        ::close(s);
+        ::unlink(path.c_str());
+        return false;
+    }
+
+    m_listener = s;
+    m_unixSocketPath = path;
+    return true;
+}
+
+bool DAPServer::AcceptClient()
+{
+    if (m_listener < 0)
+    {
+        return false;
+    }
+
+    int c = -1;
+    while ((c = ::accept(m_listener, nullptr, nullptr)) < 0)
+    {
+        if (errno != EINTR && errno != ECONNABORTED)
+        {
+            LOGE(log << "DAPServer: accept() failed, errno=" << errno);
+            return false;
+        }
+    }
+    SetCloseOnExec(c);
+
+    if (!SetNonBlocking(c))
+    {
+        LOGW(log << "DAPServer: fcntl(O_NONBLOCK) failed, errno=" << errno);
+    }
+
+    int bufferSize = SocketBufferSize;
+    if (::setsockopt(c, SOL_SOCKET, SO_SNDBUF, &bufferSize, sizeof(bufferSize)) < 0 ||
+        ::setsockopt(c, SOL_SOCKET, SO_RCVBUF, &bufferSize, sizeof(bufferSize)) < 0)
+    {
+        LOGW(log << "DAPServer: setsockopt(SO_SNDBUF/SO_RCVBUF) failed, errno=" << errno);
+    }
+
+    if (m_unixSocketPath.empty())
+    {
+        int noDelay = 1;
+        if (::setsockopt(c, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay)) < 0)
+        {
+            LOGW(log << "DAPServer: setsockopt(TCP_NODELAY) failed, errno=" << errno);
+        }
+    }
+
+    m_client = c;
+    LOGI(log << "DAPServer: client connected");
+    return true;
+}
+
+void DAPServer::CloseListener()
+{
+    if (m_listener >= 0)
+    {
+        ::close(m_listener);
+        m_listener = -1;
+    }
+
+    if (!m_unixSocketPath.empty())
+    {
+        ::unlink(m_unixSocketPath.c_str());
+        m_unixSocketPath.clear();
+    }
+}
+
+void DAPServer::CloseClientSocket()
+{
+    if (m_client >= 0)
+    {
+        ::shutdown(m_client, SHUT_RDWR);
+        ::close(m_client);
+        m_client = -1;
+    }
+}
+
+int DAPServer::Recv(gsl::span<char> buffer)
+{
+    if (m_client < 0 || buffer.empty())
+    {
+        return -1;
+    }
+
+    while (true)
+    {
+        const ssize_t n = ::recv(m_client, buffer.data(), buffer.size(), 0);
+        if (n >= 0)
+        {
+            return static_cast<int>(n);
+        }
+
+        if (errno == EINTR)
+        {
+            continue;
+        }
+
+        if (errno != EAGAIN && errno != EWOULDBLOCK)
+        {
+            LOGE(log << "DAPServer: recv() failed, errno=" << errno);
+            return -1;
+        }
+
+        pollfd pfd{};
+        pfd.fd = m_client;
+        pfd.events = POLLIN;
+        if (::poll(&pfd, 1, -1) < 0 && errno != EINTR)
+        {
+            LOGE(log << "DAPServer: poll() failed, errno=" << errno);
+            return -1;
+        }
+    }
+}
+
+} // namespace dncdbg
+
+#endif // FEATURE_PAL
@@ -0,0 +1,179 @@
+// Copyright (c) 2026 Mikhail Kurinnoi
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#ifdef _WIN32
+
+#include "utils/dapserver.h"
+#include "utils/logger.h"
+#include <winsock2.h>
+#include <ws2tcpip.h>
+
+namespace dncdbg
+{
+
+bool DAPServer::PlatformStartup()
+{
+    // Note, WSAStartup() and WSACleanup() calls are reference counted by Winsock itself.
+    WSADATA wsaData;
+    const int rc = WSAStartup(MAKEWORD(2, 2), &wsaData);
+    if (rc != 0)
+    {
+        LOGE(log << "DAPServer: WSAStartup failed, rc=" << rc);
+        return false;
+    }
+    return true;
+}
+
+void DAPServer::PlatformCleanup()
+{
+    WSACleanup();
+}
+
+bool DAPServer::CreateTcpListener(int port)
+{
+    CloseListener();
+
+    // Debuggee process must not inherit listener socket.
+    const SOCKET s = WSASocketW(AF_INET, SOCK_STREAM, IPPROTO_TCP, nullptr, 0, WSA_FLAG_NO_HANDLE_INHERIT);
+    if (s == INVALID_SOCKET)
+    {
+        LOGE(log << "DAPServer: socket() failed, err=" << WSAGetLastError());
+        return false;
+    }
+
+    // Windows SO_REUSEADDR allows port stealing, use exclusive address instead.
+    BOOL exclusive = TRUE;
+    if (::setsockopt(s, SOL_SOCKET, SO_EXCLUSIVEADDRUSE,
+                     reinterpret_cast<const char *>(&exclusive), sizeof(exclusive)) == SOCKET_ERROR)
+    {
+        LOGW(log << "DAPServer: setsockopt(SO_EXCLUSIVEADDRUSE) failed, err=" << WSAGetLastError());
+    }
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(static_cast<u_short>(port));
+    // Bind to loopback only, debugger must not be reachable from network.
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    if (::bind(s, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) == SOCKET_ERROR)
+    {
+        LOGE(log << "DAPServer: bind() failed on port " << port << ", err=" << WSAGetLastError());
+        ::closesocket(s);
+        return false;
+    }
+
+    if (::listen(s, 1) == SOCKET_ERROR)
+    {
+        LOGE(log << "DAPServer: listen() failed, err=" << WSAGetLastError());
+        ::closesocket(s);
+        return false;
+    }
+
+    m_listener = static_cast<NativeSocket>(s);
+    return true;
+}
+
+bool DAPServer::CreateUnixListener(const std::string &path)
+{
+    LOGE(log << "DAPServer: Unix domain socket is not supported on Windows: " << path);
+    return false;
+}
+
+bool DAPServer::AcceptClient()
+{
+    if (m_listener == invalidSocket)
+    {
+        return false;
+    }
+
+    const SOCKET c = ::accept(static_cast<SOCKET>(m_listener), nullptr, nullptr);
+    if (c == INVALID_SOCKET)
+    {
+        LOGE(log << "DAPServer: accept() failed, err=" << WSAGetLastError());
+        return false;
+    }
+
+    // Debuggee process must not inherit protocol connection.
+    static_cast<void>(SetHandleInformation(reinterpret_cast<HANDLE>(c), HANDLE_FLAG_INHERIT, 0));
+
+    u_long nonBlocking = 1;
+    if (::ioctlsocket(c, FIONBIO, &nonBlocking) == SOCKET_ERROR)
+    {
+        LOGW(log << "DAPServer: ioctlsocket(FIONBIO) failed, err=" << WSAGetLastError());
+    }
+
+    int bufferSize = SocketBufferSize;
+    if (::setsockopt(c, SOL_SOCKET, SO_SNDBUF, reinterpret_cast<const char *>(&bufferSize), sizeof(bufferSize)) == SOCKET_ERROR ||
+        ::setsockopt(c, SOL_SOCKET, SO_RCVBUF, reinterpret_cast<const char *>(&bufferSize), sizeof(bufferSize)) == SOCKET_ERROR)
+    {
+        LOGW(log << "DAPServer: setsockopt(SO_SNDBUF/SO_RCVBUF) failed, err=" << WSAGetLastError());
+    }
+
+    BOOL noDelay = TRUE;
+    if (::setsockopt(c, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char *>(&noDelay), sizeof(noDelay)) == SOCKET_ERROR)
+    {
+        LOGW(log << "DAPServer: setsockopt(TCP_NODELAY) failed, err=" << WSAGetLastError());
+    }
+
+    m_client = static_cast<NativeSocket>(c);
+    LOGI(log << "DAPServer: client connected");
+    return true;
+}
+
+void DAPServer::CloseListener()
+{
+    if (m_listener != invalidSocket)
+    {
+        ::closesocket(static_cast<SOCKET>(m_listener));
+        m_listener = invalidSocket;
+    }
+}
+
+void DAPServer::CloseClientSocket()
+{
+    if (m_client != invalidSocket)
+    {
+        ::shutdown(static_cast<SOCKET>(m_client), SD_BOTH);
+        ::closesocket(static_cast<SOCKET>(m_client));
+        m_client = invalidSocket;
+    }
+}
+
+int DAPServer::Recv(gsl::span<char> buffer)
+{
+    if (m_client == invalidSocket || buffer.empty())
+    {
+        return -1;
+    }
+
+    const auto s = static_cast<SOCKET>(m_client);
+    while (true)
+    {
+        const int n = ::recv(s, buffer.data(), static_cast<int>(buffer.size()), 0);
+        if (n != SOCKET_ERROR)
+        {
+            return n;
+        }
+
+        const int error = WSAGetLastError();
+        if (error != WSAEWOULDBLOCK)
+        {
+            LOGE(log << "DAPServer: recv() failed, err=" << error);
+            return -1;
+        }
+
+        fd_set readSet;
+        FD_ZERO(&readSet);
+        FD_SET(s, &readSet);
+        if (::select(0, &readSet, nullptr, nullptr, nullptr) == SOCKET_ERROR)
+        {
+            LOGE(log << "DAPServer: select() failed, err=" << WSAGetLastError());
+            return -1;
+        }
+    }
+}
+
+} // namespace dncdbg
+
+#endif // _WIN32
@@ -5,9 +5,8 @@
 
 #include "utils/ioredirect.h"
 #include "utils/logger.h"
-#include <array>
+#include <algorithm>
 #include <cassert>
-#include <cerrno>
 
 namespace dncdbg
 {
@@ -57,24 +56,12 @@ IORedirect::IORedirect(OutputCallback callback)
 // Destructor: stop worker threads and close all remaining pipe handles.
 IORedirect::~IORedirect()
 {
-    // Signal worker threads to stop.
-    m_stopWorkers.store(true);
+    // Stop worker threads, debugger-side read ends are closed after this call.
+    StopWorkers();
 
-    // Close the debugger-side read ends to unblock worker threads waiting on read().
+    // Close any remaining pipe handles.
     ClosePipe(m_stdoutRead);
     ClosePipe(m_stderrRead);
-
-    // Wait for worker threads to finish.
-    if (m_stdoutThread.joinable())
-    {
-        m_stdoutThread.join();
-    }
-    if (m_stderrThread.joinable())
-    {
-        m_stderrThread.join();
-    }
-
-    // Close any remaining pipe handles.
     ClosePipe(m_stdinRead);
     ClosePipe(m_stdinWrite);
     ClosePipe(m_stdoutWrite);
@@ -106,66 +93,14 @@ void IORedirect::Exec(const std::function<void()> &func)
     ClosePipe(m_stderrWrite);
 
     // Start worker threads to read from the child's stdout and stderr.
-    m_stdoutThread = std::thread(&IORedirect::ReaderWorker, this, StreamType::Stdout);
-    m_stderrThread = std::thread(&IORedirect::ReaderWorker, this, StreamType::Stderr);
+    StartWorkers();
 }
 
-// Write data to the child process's stdin pipe.
-int IORedirect::WriteStdin(gsl::span<const char> data)
+// Set buffer size for reading from stdout/stderr pipes.
+void IORedirect::SetReadBufferSize(size_t size)
 {
-    const std::scoped_lock<std::mutex> lock(m_stdinMutex);
-
-    if (m_stdinWrite == invalidPipe())
-    {
-        return 0; // Pipe already closed.
-    }
-
-    return WritePipe(m_stdinWrite, data.data(), data.size());
-}
-
-// Close the stdin pipe to signal EOF to the child process.
-void IORedirect::CloseStdin()
-{
-    const std::scoped_lock<std::mutex> lock(m_stdinMutex);
-    ClosePipe(m_stdinWrite);
-}
-
-// Worker thread function: reads from a pipe and calls the output callback.
-void IORedirect::ReaderWorker(StreamType type)
-{
-    // Select the appropriate pipe handle based on stream type.
-    const bool isStdout = (type == StreamType::Stdout);
-    const PipeHandle handle = isStdout ? m_stdoutRead : m_stderrRead;
-
-    std::array<char, ReadBufferSize> buffer{};
-
-    while (!m_stopWorkers.load())
-    {
-        // Read data from the pipe (blocking call).
-        const int bytesRead = ReadPipe(handle, buffer.data(), buffer.size());
-
-        if (bytesRead > 0)
-        {
-            // Deliver data to the callback.
-            m_callback(type, gsl::span<char>(buffer.data(), bytesRead));
-        }
-        else if (bytesRead == 0)
-        {
-            // EOF: child process closed its end of the pipe.
-            LOGD(log << "IORedirect: EOF on " << (isStdout ? "stdout" : "stderr"));
-            break;
-        }
-        else
-        {
-            // Error reading from pipe.
-            if (!m_stopWorkers.load())
-            {
-                LOGE(log << "IORedirect: read error on " << (isStdout ? "stdout" : "stderr")
-                         << ", errno=" << errno);
-            }
-            break;
-        }
-    }
+    assert(!m_execCalled && "SetReadBufferSize() must be called before Exec()");
+    m_readBufferSize = std::max(size, MinReadBufferSize);
 }
 
 } // namespace dncdbg
@@ -12,6 +12,7 @@
 #include <cstdint>
 #include <functional>
 #include <mutex>
+#include <string>
 #include <thread>
 
 namespace dncdbg
@@ -25,6 +26,10 @@ namespace dncdbg
 // and stderr pipes and deliver data via a callback. The debugger can also write
 // data to the child's stdin pipe.
 //
+// On Unix, single worker thread multiplexes stdout/stderr nonblocking reads and
+// stdin writes (epoll on Linux, kqueue on macOS). On Windows, each output stream
+// have its own blocking reader thread.
+//
 // Usage:
 //   1. Construct IORedirect with an OutputCallback.
 //   2. Call Exec() with a lambda that creates the child process.
@@ -80,18 +85,25 @@ class IORedirect
 
     // Write data to the child process's stdin pipe.
     //
-    // The data from `data` is written to the stdin pipe.
-    // Returns the number of bytes actually written, or -1 on error.
+    // The data from `data` is written to the stdin pipe (on Unix, data is queued
+    // for worker thread and never blocks caller, in case child don't read stdin).
+    // Returns the number of bytes actually written (queued), or -1 on error.
     // Returns 0 if the stdin pipe has been closed.
     int WriteStdin(gsl::span<const char> data);
 
     // Close the stdin pipe to signal EOF to the child process.
     void CloseStdin();
 
+    // Default and minimal buffer size for reading from stdout/stderr pipes.
+    static constexpr size_t DefaultReadBufferSize = 64 * 1024;
+    static constexpr size_t MinReadBufferSize = 512;
+
+    // Set buffer size for reading from stdout/stderr pipes, must be called before Exec().
+    void SetReadBufferSize(size_t size);
+
   private:
 
-    // Default buffer size for reading from stdout/stderr pipes.
-    static constexpr size_t ReadBufferSize = 4096;
+    size_t m_readBufferSize{DefaultReadBufferSize};
 
     // Output callback invoked when data arrives on stdout or stderr.
     OutputCallback m_callback;
@@ -105,13 +117,6 @@ class IORedirect
     // Mutex to protect WriteStdin() and CloseStdin() from concurrent access.
     std::mutex m_stdinMutex;
 
-    // Worker threads for reading stdout and stderr from the child process.
-    std::thread m_stdoutThread;
-    std::thread m_stderrThread;
-
-    // Worker thread function that reads from a pipe and calls the output callback.
-    void ReaderWorker(StreamType type);
-
     // Platform-specific pipe handle type and invalid value.
 #ifdef _WIN32
     using PipeHandle = void *; // HANDLE on Windows
@@ -142,6 +147,41 @@ class IORedirect
     PipeHandle m_stderrRead;  // Debugger-side read end.
     PipeHandle m_stderrWrite; // Child-side write end (given to child process).
 
+#ifdef _WIN32
+    // Worker threads for reading stdout and stderr from the child process.
+    std::thread m_stdoutThread;
+    std::thread m_stderrThread;
+
+    // Worker thread function that reads from a pipe and calls the output callback.
+    void ReaderWorker(StreamType type);
+#endif // _WIN32
+
+#ifdef FEATURE_PAL
+    // Worker thread for stdout/stderr reads and stdin writes.
+    std::thread m_ioThread;
+
+    // Data queued by WriteStdin() and not written yet (covered by m_stdinMutex).
+    std::string m_stdinBuffer;
+    // CloseStdin() was called, stdin pipe must be closed after m_stdinBuffer written (covered by m_stdinMutex).
+    bool m_stdinCloseRequested{false};
+
+    // Pipe for worker thread wakeup (new stdin data or stop request).
+    PipeHandle m_wakeupRead{invalidPipe()};
+    PipeHandle m_wakeupWrite{invalidPipe()};
+
+    // Worker thread function, event loop for all pipes.
+    void IOWorker();
+    // Read all available data from nonblocking pipe. Returns false on EOF or error.
+    bool ReadAvailable(PipeHandle handle, StreamType type, gsl::span<char> buffer);
+    // Write queued stdin data, as much as pipe could accept. Returns true in case some data left.
+    bool WriteQueuedStdin();
+    void Wakeup();
+#endif // FEATURE_PAL
+
+    // Platform-specific worker threads start (called by Exec()) and stop (called by destructor).
+    void StartWorkers();
+    void StopWorkers();
+
     // Platform-specific helper methods (implemented in iosystem_unix.cpp / iosystem_win32.cpp).
 
     // Create an unnamed pipe. Returns true on success.
@@ -155,6 +195,7 @@ class IORedirect
     static int ReadPipe(PipeHandle handle, char *buffer, size_t size);
 
     // Write to a pipe. Returns number of bytes written, -1 on error.
+    // For nonblocking pipe, returns number of bytes written before pipe was full.
     static int WritePipe(PipeHandle handle, const char *buffer, size_t size);
 
     // Set whether a pipe handle is inheritable by child processes.
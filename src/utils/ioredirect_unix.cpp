@@ -13,10 +13,118 @@
 #include <cstring>
 #include <fcntl.h>
 #include <unistd.h>
+#include <vector>
+#ifdef __linux__
+#include <sys/epoll.h>
+#else
+#include <sys/event.h>
+#endif // __linux__
 
 namespace dncdbg
 {
 
+namespace
+{
+
+// Readiness notification for few descriptors: epoll on Linux, kqueue on macOS.
+// Each descriptor is watched for read or write readiness only (not both).
+class Poller
+{
+  public:
+
+    static constexpr int MaxEvents = 4;
+
+    Poller()
+    {
+#ifdef __linux__
+        m_fd = ::epoll_create1(EPOLL_CLOEXEC);
+#else
+        m_fd = ::kqueue(); // Note, kqueue descriptor is not inherited by child processes.
+#endif // __linux__
+    }
+    Poller(Poller &&) = delete;
+    Poller(const Poller &) = delete;
+    Poller &operator=(Poller &&) = delete;
+    Poller &operator=(const Poller &) = delete;
+    ~Poller()
+    {
+        if (m_fd != -1)
+        {
+            ::close(m_fd);
+        }
+    }
+
+    [[nodiscard]] bool IsValid() const
+    {
+        return m_fd != -1;
+    }
+
+    bool Add(int fd, bool write)
+    {
+#ifdef __linux__
+        epoll_event event{};
+        event.events = write ? EPOLLOUT : EPOLLIN;
+        event.data.fd = fd;
+        return ::epoll_ctl(m_fd, EPOLL_CTL_ADD, fd, &event) == 0;
+#else
+        struct kevent change{};
+        EV_SET(&change, fd, write ? EVFILT_WRITE : EVFILT_READ, EV_ADD | EV_ENABLE, 0, 0, nullptr);
+        return ::kevent(m_fd, &change, 1, nullptr, 0, nullptr) != -1;
+#endif // __linux__
+    }
+
+    void Remove(int fd, bool write)
+    {
+#ifdef __linux__
+        static_cast<void>(write);
+        epoll_event event{}; // Note, kernels before 2.6.9 require non-null pointer for EPOLL_CTL_DEL.
+        static_cast<void>(::epoll_ctl(m_fd, EPOLL_CTL_DEL, fd, &event));
+#else
+        struct kevent change{};
+        EV_SET(&change, fd, write ? EVFILT_WRITE : EVFILT_READ, EV_DELETE, 0, 0, nullptr);
+        static_cast<void>(::kevent(m_fd, &change, 1, nullptr, 0, nullptr));
+#endif // __linux__
+    }
+
+    // Wait for ready descriptors. Returns number of descriptors stored into `fds`, -1 on error.
+    int Wait(std::array<int, MaxEvents> &fds)
+    {
+#ifdef __linux__
+        std::array<epoll_event, MaxEvents> events{};
+        const int count = ::epoll_wait(m_fd, events.data(), MaxEvents, -1);
+        for (int i = 0; i < count; ++i)
+        {
+            fds.at(i) = events.at(i).data.fd;
+        }
+#else
+        std::array<struct kevent, MaxEvents> events{};
+        const int count = ::kevent(m_fd, nullptr, 0, events.data(), MaxEvents, nullptr);
+        for (int i = 0; i < count; ++i)
+        {
+            fds.at(i) = static_cast<int>(events.at(i).ident);
+        }
+#endif // __linux__
+        return count;
+    }
+
+  private:
+
+    int m_fd{-1};
+};
+
+bool SetNonBlocking(int fd)
+{
+    const int flags = fcntl(fd, F_GETFL); // NOLINT(cppcoreguidelines-pro-type-vararg)
+    if (flags < 0 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0) // NOLINT(cppcoreguidelines-pro-type-vararg)
+    {
+        LOGE(log << "IORedirect: fcntl(O_NONBLOCK) failed, errno=" << errno);
+        return false;
+    }
+    return true;
+}
+
+} // unnamed namespace
+
 // Create an unnamed pipe. Returns true on success.
 bool IORedirect::CreatePipe(PipeHandle &readEnd, PipeHandle &writeEnd)
 {
@@ -59,6 +167,7 @@ int IORedirect::ReadPipe(PipeHandle handle, char *buffer, size_t size)
 }
 
 // Write to a pipe. Returns number of bytes written, -1 on error.
+// For nonblocking pipe, returns number of bytes written before pipe was full.
 int IORedirect::WritePipe(PipeHandle handle, const char *buffer, size_t size)
 {
     size_t totalWritten = 0;
@@ -73,6 +182,10 @@ int IORedirect::WritePipe(PipeHandle handle, const char *buffer, size_t size)
             {
                 continue; // Retry on interrupt.
             }
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+            {
+                break; // Pipe is full, rest of data should be written later.
+            }
             LOGE(log << "IORedirect::WritePipe: write() failed, errno=" << errno);
             return -1;
         }
@@ -186,6 +299,224 @@ void IORedirect::RestoreStdFiles(SavedStdFiles &saved)
     saved.valid = false;
 }
 
+// Start worker thread for stdout/stderr reads and stdin writes.
+void IORedirect::StartWorkers()
+{
+    const std::scoped_lock<std::mutex> lock(m_stdinMutex);
+
+    if (!CreatePipe(m_wakeupRead, m_wakeupWrite))
+    {
+        LOGE(log << "IORedirect: failed to create wakeup pipe");
+        return;
+    }
+    SetInheritable(m_wakeupRead, false);
+    SetInheritable(m_wakeupWrite, false);
+
+    // Note, O_NONBLOCK is set for debugger-side pipe ends only (child-side ends have own file descriptions).
+    if (!SetNonBlocking(m_wakeupRead) ||
+        !SetNonBlocking(m_wakeupWrite) ||
+        !SetNonBlocking(m_stdoutRead) ||
+        !SetNonBlocking(m_stderrRead) ||
+        (m_stdinWrite != invalidPipe() && !SetNonBlocking(m_stdinWrite)))
+    {
+        return;
+    }
+
+    m_ioThread = std::thread(&IORedirect::IOWorker, this);
+}
+
+// Stop worker thread.
+void IORedirect::StopWorkers()
+{
+    m_stopWorkers.store(true);
+
+    {
+        const std::scoped_lock<std::mutex> lock(m_stdinMutex);
+        Wakeup();
+    }
+
+    if (m_ioThread.joinable())
+    {
+        m_ioThread.join();
+    }
+
+    ClosePipe(m_wakeupRead);
+    ClosePipe(m_wakeupWrite);
+}
+
+// Caller must hold m_stdinMutex.
+void IORedirect::Wakeup()
+{
+    if (m_wakeupWrite == invalidPipe())
+    {
+        return;
+    }
+
+    // Note, pipe is nonblocking, in case it's full worker thread already have pending wakeup.
+    const char byte = 0;
+    static_cast<void>(::write(m_wakeupWrite, &byte, 1));
+}
+
+// Write data to the child process's stdin pipe.
+int IORedirect::WriteStdin(gsl::span<const char> data)
+{
+    const std::scoped_lock<std::mutex> lock(m_stdinMutex);
+
+    if (m_stdinWrite == invalidPipe() || m_stdinCloseRequested)
+    {
+        return 0; // Pipe already closed.
+    }
+
+    // Data is written by worker thread, caller must not be blocked by child, that don't read stdin.
+    m_stdinBuffer.append(data.data(), data.size());
+    Wakeup();
+    return static_cast<int>(data.size());
+}
+
+// Close the stdin pipe to signal EOF to the child process.
+void IORedirect::CloseStdin()
+{
+    const std::scoped_lock<std::mutex> lock(m_stdinMutex);
+
+    if (!m_ioThread.joinable())
+    {
+        ClosePipe(m_stdinWrite);
+        return;
+    }
+
+    // Pipe will be closed by worker thread after all queued data written.
+    m_stdinCloseRequested = true;
+    Wakeup();
+}
+
+bool IORedirect::WriteQueuedStdin()
+{
+    const std::scoped_lock<std::mutex> lock(m_stdinMutex);
+
+    if (!m_stdinBuffer.empty() && m_stdinWrite != invalidPipe())
+    {
+        const int written = WritePipe(m_stdinWrite, m_stdinBuffer.data(), m_stdinBuffer.size());
+        if (written < 0)
+        {
+            m_stdinBuffer.clear(); // Child can't receive this data (for example, stdin closed by child).
+        }
+        else
+        {
+            m_stdinBuffer.erase(0, static_cast<size_t>(written));
+        }
+    }
+
+    if (m_stdinCloseRequested && m_stdinBuffer.empty())
+    {
+        ClosePipe(m_stdinWrite);
+        m_stdinCloseRequested = false;
+    }
+
+    return !m_stdinBuffer.empty() && m_stdinWrite != invalidPipe();
+}
+
+bool IORedirect::ReadAvailable(PipeHandle handle, StreamType type, gsl::span<char> buffer)
+{
+    const bool isStdout = (type == StreamType::Stdout);
+
+    // Limit reads per wakeup, so busy stream can't starve other one.
+    constexpr int maxReads = 16;
+    for (int i = 0; i < maxReads; ++i)
+    {
+        const int bytesRead = ReadPipe(handle, buffer.data(), buffer.size());
+
+        if (bytesRead > 0)
+        {
+            m_callback(type, buffer.first(bytesRead));
+            if (static_cast<size_t>(bytesRead) < buffer.size())
+            {
+                return true; // Pipe is drained.
+            }
+        }
+        else if (bytesRead == 0)
+        {
+            // EOF: child process closed its end of the pipe.
+            LOGD(log << "IORedirect: EOF on " << (isStdout ? "stdout" : "stderr"));
+            return false;
+        }
+        else if (errno == EAGAIN || errno == EWOULDBLOCK)
+        {
+            return true;
+        }
+        else if (errno != EINTR)
+        {
+            LOGE(log << "IORedirect: read error on " << (isStdout ? "stdout" : "stderr") << ", errno=" << errno);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Worker thread function: event loop for stdout/stderr reads and stdin writes.
+void IORedirect::IOWorker()
+{
+    Poller poller;
+    if (!poller.IsValid() ||
+        !poller.Add(m_wakeupRead, false) ||
+        !poller.Add(m_stdoutRead, false) ||
+        !poller.Add(m_stderrRead, false))
+    {
+        LOGE(log << "IORedirect: event loop initialization failed, errno=" << errno);
+        return;
+    }
+
+    std::vector<char> buffer(m_readBufferSize);
+    std::array<int, Poller::MaxEvents> readyFds{};
+    // Stdin pipe is watched for write readiness only while queued data can't be written.
+    PipeHandle watchedStdin = invalidPipe();
+
+    while (!m_stopWorkers.load())
+    {
+        if (watchedStdin != invalidPipe())
+        {
+            poller.Remove(watchedStdin, true);
+            watchedStdin = invalidPipe();
+        }
+        if (WriteQueuedStdin() && poller.Add(m_stdinWrite, true))
+        {
+            watchedStdin = m_stdinWrite;
+        }
+
+        const int count = poller.Wait(readyFds);
+        if (count < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            LOGE(log << "IORedirect: event loop wait failed, errno=" << errno);
+            break;
+        }
+
+        for (int i = 0; i < count; ++i)
+        {
+            const int fd = readyFds.at(i);
+            if (fd == m_wakeupRead)
+            {
+                // Drain wakeup pipe, requests are checked at loop start.
+                std::array<char, 64> drain{};
+                while (ReadPipe(m_wakeupRead, drain.data(), drain.size()) > 0)
+                {
+                }
+            }
+            else if (fd == m_stdoutRead || fd == m_stderrRead)
+            {
+                const StreamType type = (fd == m_stdoutRead) ? StreamType::Stdout : StreamType::Stderr;
+                if (!ReadAvailable(fd, type, buffer))
+                {
+                    poller.Remove(fd, false);
+                }
+            }
+        }
+    }
+}
+
 } // namespace dncdbg
 
 #endif // FEATURE_PAL
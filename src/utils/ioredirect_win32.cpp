@@ -13,6 +13,7 @@
 #include <cstring>
 #include <fcntl.h>
 #include <io.h>
+#include <vector>
 #include <windows.h>
 
 namespace dncdbg
@@ -262,6 +263,92 @@ void IORedirect::RestoreStdFiles(SavedStdFiles &saved)
     saved.valid = false;
 }
 
+// Start worker threads to read from the child's stdout and stderr.
+void IORedirect::StartWorkers()
+{
+    m_stdoutThread = std::thread(&IORedirect::ReaderWorker, this, StreamType::Stdout);
+    m_stderrThread = std::thread(&IORedirect::ReaderWorker, this, StreamType::Stderr);
+}
+
+// Stop worker threads.
+void IORedirect::StopWorkers()
+{
+    // Signal worker threads to stop.
+    m_stopWorkers.store(true);
+
+    // Close the debugger-side read ends to unblock worker threads waiting on read().
+    ClosePipe(m_stdoutRead);
+    ClosePipe(m_stderrRead);
+
+    // Wait for worker threads to finish.
+    if (m_stdoutThread.joinable())
+    {
+        m_stdoutThread.join();
+    }
+    if (m_stderrThread.joinable())
+    {
+        m_stderrThread.join();
+    }
+}
+
+// Write data to the child process's stdin pipe.
+int IORedirect::WriteStdin(gsl::span<const char> data)
+{
+    const std::scoped_lock<std::mutex> lock(m_stdinMutex);
+
+    if (m_stdinWrite == invalidPipe())
+    {
+        return 0; // Pipe already closed.
+    }
+
+    return WritePipe(m_stdinWrite, data.data(), data.size());
+}
+
+// Close the stdin pipe to signal EOF to the child process.
+void IORedirect::CloseStdin()
+{
+    const std::scoped_lock<std::mutex> lock(m_stdinMutex);
+    ClosePipe(m_stdinWrite);
+}
+
+// Worker thread function: reads from a pipe and calls the output callback.
+void IORedirect::ReaderWorker(StreamType type)
+{
+    // Select the appropriate pipe handle based on stream type.
+    const bool isStdout = (type == StreamType::Stdout);
+    const PipeHandle handle = isStdout ? m_stdoutRead : m_stderrRead;
+
+    std::vector<char> buffer(m_readBufferSize);
+
+    while (!m_stopWorkers.load())
+    {
+        // Read data from the pipe (blocking call).
+        const int bytesRead = ReadPipe(handle, buffer.data(), buffer.size());
+
+        if (bytesRead > 0)
+        {
+            // Deliver data to the callback.
+            m_callback(type, gsl::span<char>(buffer.data(), bytesRead));
+        }
+        else if (bytesRead == 0)
+        {
+            // EOF: child process closed its end of the pipe.
+            LOGD(log << "IORedirect: EOF on " << (isStdout ? "stdout" : "stderr"));
+            break;
+        }
+        else
+        {
+            // Error reading from pipe.
+            if (!m_stopWorkers.load())
+            {
+                LOGE(log << "IORedirect: read error on " << (isStdout ? "stdout" : "stderr")
+                         << ", errno=" << errno);
+            }
+            break;
+        }
+    }
+}
+
 } // namespace dncdbg
 
 #endif // _WIN32
@@ -7,7 +7,19 @@
 #include <ctime>
 #include <cstring>
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
 
 #ifdef _WIN32
 #include <cassert>
@@ -25,7 +37,6 @@
 namespace dncdbg
 {
 
-std::mutex Logger::m_logMutex;
 LogLevel Logger::m_logLevel = LogLevel::INF;
 
 namespace
@@ -93,11 +104,508 @@ unsigned get_pid()
     return process_id;
 }
 
+struct LogRecord
+{
+    struct timespec ts{};
+    const char *file{nullptr};
+    const char *func{nullptr};
+    int line{0};
+    unsigned tid{0};
+    LogLevel level{LogLevel::INF};
+    std::string message;
+};
+
+// Function should form output line like this:
+//
+// 1500636976.777 I(P 2293, T 2293): udev.c:64 uevent_control_cb() > Set udev monitor buffer size 131072
+// ^              ^    ^       ^      ^     ^              ^          ^
+// |              |    ` pid   ` tid  |     ` line number  |          ` user provided message
+// |              ` log level         ` file name          ` function name
+// `--- time sec.msec
+//
+void WriteRecord(std::ostream &stream, const LogRecord &record)
+{
+    char levelSymb = 'I';
+    static constexpr std::string_view levelSymbol("DIWE");
+    if (record.level >= LogLevel::DBG && record.level <= LogLevel::ERR)
+    {
+        levelSymb = levelSymbol.at(static_cast<uint8_t>(record.level));
+    }
+
+    static constexpr size_t headerSize = 512;
+    std::array<char, headerSize> header{};
+    const int size = std::snprintf(header.data(), header.size(), "%ld.%03ld %c(P%04u, T%04u): %s:%d %s() > ",
+                                   static_cast<long>(record.ts.tv_sec & MAX_TIMESTAMP_SECONDS), record.ts.tv_nsec / NSEC_TO_MSEC,
+                                   levelSymb, get_pid(), record.tid, record.file, record.line, record.func);
+    if (size > 0)
+    {
+        stream.write(header.data(), std::min(static_cast<std::streamsize>(size), static_cast<std::streamsize>(header.size() - 1)));
+    }
+    stream.write(record.message.data(), static_cast<std::streamsize>(record.message.size()));
+    stream.put('\n');
+}
+
+// Stream buffer that appends output to string.
+class StringAppendBuf : public std::streambuf
+{
+  public:
+
+    void SetTarget(std::string *target)
+    {
+        m_target = target;
+    }
+
+  protected:
+
+    int_type overflow(int_type ch) override
+    {
+        if (!traits_type::eq_int_type(ch, traits_type::eof()))
+        {
+            m_target->push_back(traits_type::to_char_type(ch));
+        }
+        return traits_type::not_eof(ch);
+    }
+
+    std::streamsize xsputn(const char *s, std::streamsize count) override
+    {
+        m_target->append(s, static_cast<size_t>(count));
+        return count;
+    }
+
+  private:
+
+    std::string *m_target{nullptr};
+};
+
+// Per-thread stream for user message formatting, reused for all thread records.
+class MessageStream
+{
+  public:
+
+    MessageStream()
+        : m_stream(&m_buf),
+          m_flags(m_stream.flags()),
+          m_precision(m_stream.precision()),
+          m_fill(m_stream.fill())
+    {
+    }
+
+    void Format(std::string &target, const Logger::LoggerCallback &cb)
+    {
+        // Don't let previous record formatting flags affect this one.
+        m_stream.clear();
+        m_stream.flags(m_flags);
+        m_stream.precision(m_precision);
+        m_stream.fill(m_fill);
+        m_stream.width(0);
+
+        m_buf.SetTarget(&target);
+        cb(m_stream);
+        m_buf.SetTarget(nullptr);
+    }
+
+  private:
+
+    StringAppendBuf m_buf;
+    std::ostream m_stream;
+    std::ios_base::fmtflags m_flags;
+    std::streamsize m_precision;
+    char m_fill;
+};
+
+constexpr size_t cacheLineSize = 64;
+
+// Single-producer single-consumer ring of log records. Producer is the thread that owns ring,
+// consumer is the logger thread. Records message strings are reused, so in steady state
+// record write don't need memory allocation.
+// Note, debugger create a lot of short living threads (each DAP command is executed by new thread), so ring is small
+// and returned into pool at thread exit (see LogBackend::GetThreadRing()).
+class LogRing
+{
+  public:
+
+    static constexpr size_t Capacity = 256; // Must be power of 2.
+
+    // Producer only. Returns record for fill or nullptr in case ring is full.
+    LogRecord *Reserve()
+    {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if (head - m_tail.load(std::memory_order_acquire) == Capacity)
+        {
+            return nullptr;
+        }
+        return &m_records[head & (Capacity - 1)];
+    }
+
+    // Producer only. Publish record returned by Reserve().
+    void Commit()
+    {
+        m_head.store(m_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // Consumer only. Swap all published records with `batch` entries starting from `batchSize`.
+    void Drain(std::vector<LogRecord> &batch, size_t &batchSize)
+    {
+        const size_t head = m_head.load(std::memory_order_acquire);
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        for (; tail != head; ++tail)
+        {
+            if (batchSize == batch.size())
+            {
+                batch.emplace_back();
+            }
+            std::swap(batch[batchSize], m_records[tail & (Capacity - 1)]);
+            ++batchSize;
+        }
+        m_tail.store(tail, std::memory_order_release);
+    }
+
+    [[nodiscard]] bool Empty() const
+    {
+        return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_relaxed);
+    }
+
+    void Close()
+    {
+        m_closed.store(true, std::memory_order_release);
+    }
+
+    // Ring must be closed and drained, called under logger mutex before ring reuse by new thread.
+    void Reopen()
+    {
+        m_closed.store(false, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] bool Closed() const
+    {
+        return m_closed.load(std::memory_order_acquire);
+    }
+
+    // Producer only. Mark record write in progress (see LogBackend::Write() and LogBackend shutdown).
+    void SetWriting(bool writing)
+    {
+        m_writing.store(writing, writing ? std::memory_order_seq_cst : std::memory_order_release);
+    }
+
+    [[nodiscard]] bool Writing() const
+    {
+        return m_writing.load(std::memory_order_seq_cst);
+    }
+
+  private:
+
+    alignas(cacheLineSize) std::atomic<size_t> m_head{0};
+    alignas(cacheLineSize) std::atomic<size_t> m_tail{0};
+    std::atomic<bool> m_closed{false};
+    std::atomic<bool> m_writing{false};
+    std::vector<LogRecord> m_records{Capacity};
+};
+
+// Ring reference of current thread, ring is closed at thread exit and moved into free rings pool by logger thread
+// after drain.
+struct ThreadRing
+{
+    ThreadRing() = default;
+    ThreadRing(ThreadRing &&) = delete;
+    ThreadRing(const ThreadRing &) = delete;
+    ThreadRing &operator=(ThreadRing &&) = delete;
+    ThreadRing &operator=(const ThreadRing &) = delete;
+
+    ~ThreadRing()
+    {
+        if (ring)
+        {
+            ring->Close();
+        }
+    }
+
+    std::shared_ptr<LogRing> ring;
+};
+
+class LogBackend
+{
+  public:
+
+    static LogBackend &GetInstance()
+    {
+        static LogBackend backend;
+        return backend;
+    }
+
+    LogBackend(LogBackend &&) = delete;
+    LogBackend(const LogBackend &) = delete;
+    LogBackend &operator=(LogBackend &&) = delete;
+    LogBackend &operator=(const LogBackend &) = delete;
+
+    void Open(const char *fileName)
+    {
+        const std::scoped_lock<std::mutex> lock(m_mutex);
+        if (m_running.load(std::memory_order_relaxed))
+        {
+            return;
+        }
+
+        // Note, buffer must be set before open.
+        m_streamBuffer.resize(streamBufferSize);
+        m_stream.rdbuf()->pubsetbuf(m_streamBuffer.data(), static_cast<std::streamsize>(m_streamBuffer.size()));
+        m_stream.open(fileName, std::ios::app);
+        if (!m_stream.good())
+        {
+            return;
+        }
+
+        m_stop = false;
+        m_thread = std::thread(&LogBackend::LoggerThread, this);
+        m_running.store(true, std::memory_order_release);
+        m_opened.store(true, std::memory_order_release);
+    }
+
+    void Write(LogLevel level, const char *file, int line, const char *func, const Logger::LoggerCallback &cb)
+    {
+        if (!m_running.load(std::memory_order_acquire))
+        {
+            if (m_opened.load(std::memory_order_acquire))
+            {
+                WriteSync(level, file, line, func, cb);
+            }
+            return;
+        }
+
+        LogRing &ring = GetThreadRing();
+        // Note, logger shutdown could start at any time, in this case ring could be already drained for the last time.
+        // Check running state again after write mark, shutdown wait for marked writes before final drain.
+        ring.SetWriting(true);
+        if (!m_running.load(std::memory_order_seq_cst))
+        {
+            ring.SetWriting(false);
+            WriteSync(level, file, line, func, cb);
+            return;
+        }
+
+        LogRecord *record = ring.Reserve();
+        if (record == nullptr)
+        {
+            ring.SetWriting(false);
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            Wakeup();
+            return;
+        }
+
+        clock_gettime(CLOCK_MONOTONIC, &record->ts);
+        record->file = file;
+        record->func = func;
+        record->line = line;
+        record->tid = get_tid();
+        record->level = level;
+        record->message.clear();
+        static thread_local MessageStream messageStream;
+        messageStream.Format(record->message, cb);
+
+        ring.Commit();
+        ring.SetWriting(false);
+        Wakeup();
+    }
+
+    uint64_t GetDropped() const
+    {
+        return m_dropped.load(std::memory_order_relaxed);
+    }
+
+  private:
+
+    // Logger thread wakeup interval in case no wakeup was requested (records could be delayed by
+    // wakeup request and drain race).
+    static constexpr std::chrono::milliseconds drainInterval{100};
+    static constexpr size_t streamBufferSize = 256 * 1024;
+    // Don't keep huge message strings allocated after write.
+    static constexpr size_t maxRetainedMessageSize = 4 * 1024;
+
+    LogBackend() = default;
+
+    ~LogBackend()
+    {
+        {
+            const std::scoped_lock<std::mutex> lock(m_mutex);
+            if (!m_running.load(std::memory_order_relaxed))
+            {
+                return;
+            }
+            m_stop = true;
+            m_cv.notify_one(); // notify_one with lock
+        }
+        // Note, producers write into rings until logger thread is joined, since stream is written by logger thread
+        // without lock.
+        m_thread.join();
+
+        // Switch producers to synchronous write and write records, that were committed after logger thread final drain.
+        m_running.store(false, std::memory_order_seq_cst);
+        const std::scoped_lock<std::mutex> lock(m_mutex);
+        for (const auto &ring : m_rings)
+        {
+            while (ring->Writing())
+            {
+                std::this_thread::yield();
+            }
+        }
+        std::vector<LogRecord> batch;
+        WriteRings(m_rings, batch);
+        // Note, threads, that are not finished yet, could still log after this point, don't let them write into
+        // destroyed stream.
+        m_stream.close();
+    }
+
+    // Used in case log was opened, but logger thread is joined already (at exit).
+    void WriteSync(LogLevel level, const char *file, int line, const char *func, const Logger::LoggerCallback &cb)
+    {
+        const std::scoped_lock<std::mutex> lock(m_mutex);
+        if (!m_stream.good())
+        {
+            return;
+        }
+
+        LogRecord record;
+        clock_gettime(CLOCK_MONOTONIC, &record.ts);
+        record.file = file;
+        record.func = func;
+        record.line = line;
+        record.tid = get_tid();
+        record.level = level;
+        static thread_local MessageStream messageStream;
+        messageStream.Format(record.message, cb);
+        WriteRecord(m_stream, record);
+        m_stream.flush();
+    }
+
+    LogRing &GetThreadRing()
+    {
+        static thread_local ThreadRing threadRing;
+        if (!threadRing.ring)
+        {
+            const std::scoped_lock<std::mutex> lock(m_mutex);
+            if (m_freeRings.empty())
+            {
+                threadRing.ring = std::make_shared<LogRing>();
+            }
+            else
+            {
+                threadRing.ring = std::move(m_freeRings.back());
+                m_freeRings.pop_back();
+                threadRing.ring->Reopen();
+            }
+            m_rings.emplace_back(threadRing.ring);
+        }
+        return *threadRing.ring;
+    }
+
+    // Request logger thread wakeup, only first request after drain take mutex.
+    void Wakeup()
+    {
+        if (!m_wakeup.exchange(true, std::memory_order_acq_rel))
+        {
+            const std::scoped_lock<std::mutex> lock(m_mutex);
+            m_cv.notify_one(); // notify_one with lock
+        }
+    }
+
+    // Drain rings and write records merged by time into stream, return written records count.
+    size_t WriteRings(const std::vector<std::shared_ptr<LogRing>> &rings, std::vector<LogRecord> &batch)
+    {
+        size_t batchSize = 0;
+        for (const auto &ring : rings)
+        {
+            ring->Drain(batch, batchSize);
+        }
+        // Each ring is ordered already, merge records of all threads by time.
+        std::stable_sort(batch.begin(), batch.begin() + static_cast<std::ptrdiff_t>(batchSize),
+                         [](const LogRecord &a, const LogRecord &b)
+                         {
+                             return a.ts.tv_sec != b.ts.tv_sec ? a.ts.tv_sec < b.ts.tv_sec : a.ts.tv_nsec < b.ts.tv_nsec;
+                         });
+
+        for (size_t i = 0; i < batchSize; ++i)
+        {
+            WriteRecord(m_stream, batch[i]);
+            batch[i].message.clear();
+            if (batch[i].message.capacity() > maxRetainedMessageSize)
+            {
+                batch[i].message.shrink_to_fit();
+            }
+        }
+        return batchSize;
+    }
+
+    void LoggerThread()
+    {
+        std::vector<std::shared_ptr<LogRing>> rings;
+        std::vector<LogRecord> batch;
+        uint64_t reportedDropped = 0;
+        bool stop = false;
+        while (!stop)
+        {
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_cv.wait_for(lock, drainInterval, [this]() { return m_stop || m_wakeup.load(std::memory_order_relaxed); });
+                stop = m_stop;
+
+                // Move drained rings of finished threads into pool, all records of closed ring are already published.
+                const auto finished = std::stable_partition(m_rings.begin(), m_rings.end(),
+                                                            [](const std::shared_ptr<LogRing> &ring) { return !ring->Closed() || !ring->Empty(); });
+                std::move(finished, m_rings.end(), std::back_inserter(m_freeRings));
+                m_rings.erase(finished, m_rings.end());
+                rings = m_rings;
+            }
+            // Reset request before drain, so records committed after this point will request new wakeup.
+            m_wakeup.exchange(false, std::memory_order_acq_rel);
+
+            const size_t batchSize = WriteRings(rings, batch);
+
+            const uint64_t dropped = m_dropped.load(std::memory_order_relaxed);
+            const bool reportDropped = dropped != reportedDropped;
+            if (reportDropped)
+            {
+                LogRecord record;
+                clock_gettime(CLOCK_MONOTONIC, &record.ts);
+                record.file = &__FILE__[PathLen(__FILE__)]; // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+                record.func = __func__;
+                record.line = __LINE__;
+                record.tid = get_tid();
+                record.level = LogLevel::WRN;
+                record.message = std::to_string(dropped - reportedDropped) + " log records dropped (thread log buffer is full)";
+                WriteRecord(m_stream, record);
+                reportedDropped = dropped;
+            }
+
+            if (batchSize != 0 || reportDropped)
+            {
+                m_stream.flush();
+            }
+        }
+    }
+
+    std::vector<char> m_streamBuffer;
+    std::ofstream m_stream; // Written only by logger thread while it's running, after join - under m_mutex.
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::vector<std::shared_ptr<LogRing>> m_rings;
+    std::vector<std::shared_ptr<LogRing>> m_freeRings; // Drained rings of finished threads.
+    std::thread m_thread;
+    bool m_stop{false};
+    std::atomic<bool> m_running{false};
+    std::atomic<bool> m_opened{false};
+    std::atomic<bool> m_wakeup{false};
+    std::atomic<uint64_t> m_dropped{0};
+};
+
 } // unnamed namespace
 
 void Logger::OpenLogStream(const char *fileName)
 {
-    GetLogStream().open(fileName, std::ios::app);
+    LogBackend::GetInstance().Open(fileName);
+}
+
+uint64_t Logger::GetDroppedRecords()
+{
+    return LogBackend::GetInstance().GetDropped();
 }
 
 void Logger::SetLogLevel(const char *level)
@@ -156,50 +664,14 @@ void Logger::SetLogLevel(const char *level)
     }
 }
 
-// Function should form output line like this:
-//
-// 1500636976.777 I(P 2293, T 2293): udev.c:64 uevent_control_cb() > Set udev monitor buffer size 131072
-// ^              ^    ^       ^      ^     ^              ^          ^
-// |              |    ` pid   ` tid  |     ` line number  |          ` user provided message
-// |              ` log level         ` file name          ` function name
-// `--- time sec.msec
-//
 void Logger::LogPrint(LogLevel level, const char *file, int line, const char *func, const LoggerCallback &cb)
 {
-    if (level < m_logLevel ||
-        !GetLogStream().good())
-    {
-        return;
-    }
-
-    struct timespec ts{};
-    clock_gettime(CLOCK_MONOTONIC, &ts);
-
-    const std::scoped_lock<std::mutex> lock(m_logMutex);
-
-    char levelSymb = 'I';
-    static constexpr std::string_view levelSymbol("DIWE");
-    if (level >= LogLevel::DBG && level <= LogLevel::ERR)
-    {
-        levelSymb = levelSymbol.at(static_cast<uint8_t>(level));
-    }
-
-    GetLogStream() << (ts.tv_sec & MAX_TIMESTAMP_SECONDS) << '.'
-                   << std::dec << std::setfill('0') << std::setw(3)
-                   << (ts.tv_nsec / NSEC_TO_MSEC) << ' '
-                   << levelSymb << "(P" << std::setw(4) << get_pid()
-                   << ", T" << std::setw(4) << get_tid() << "): "
-                   << file << ":" << line << " " << func << "() > ";
-
-    cb(GetLogStream());
-
-    if (GetLogStream().fail())
+    if (level < m_logLevel)
     {
         return;
     }
 
-    GetLogStream() << '\n';
-    GetLogStream().flush();
+    LogBackend::GetInstance().Write(level, file, line, func, cb);
 }
 
 } // namespace dncdbg
@@ -10,7 +10,6 @@
 #include <fstream>
 #include <functional>
 #include <iomanip>
-#include <mutex>
 #include <string_view>
 
 #ifdef _MSC_VER
@@ -30,6 +29,9 @@ enum class LogLevel : uint8_t
     ERR      // ERROR
 };
 
+// Logger is asynchronous: user message is formatted on calling thread into per-thread lock-free ring
+// buffer, record header formatting and file write are done by background thread. In case thread ring
+// buffer is full, record is dropped (dropped records are counted and reported in log).
 class Logger
 {
   public:
@@ -39,17 +41,11 @@ class Logger
     static void LogPrint(LogLevel level, const char *file, int line, const char *func, const LoggerCallback &cb);
     static void OpenLogStream(const char *fileName);
     static void SetLogLevel(const char *level);
+    static uint64_t GetDroppedRecords();
 
   private:
 
-    static std::mutex m_logMutex;
     static LogLevel m_logLevel;
-
-    static std::ofstream &GetLogStream()
-    {
-        static std::ofstream logStream;
-        return logStream;
-    }
 };
 
 // This function computes file path (directory component) length at compile time.
@@ -0,0 +1,117 @@
+// Copyright (c) 2026 Mikhail Kurinnoi
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "utils/memorycache.h"
+#include <algorithm>
+#include <cstring>
+
+namespace dncdbg
+{
+
+void MemoryCache::Invalidate()
+{
+    m_pages.clear();
+    m_slabs.clear();
+    m_lastSlabUsedPages = 0;
+}
+
+uint8_t *MemoryCache::AllocatePages(size_t count)
+{
+    if (m_slabs.empty() || m_lastSlabUsedPages + count > SlabPages)
+    {
+        if (m_slabs.size() == MaxSlabs)
+        {
+            Invalidate();
+        }
+        m_slabs.emplace_back(std::make_unique<Slab>());
+        m_lastSlabUsedPages = 0;
+    }
+
+    uint8_t *pages = m_slabs.back()->data() + m_lastSlabUsedPages * PageSize;
+    m_lastSlabUsedPages += count;
+    return pages;
+}
+
+const uint8_t *MemoryCache::FetchPages(uint64_t pageAddress, uint64_t endAddress)
+{
+    // Find run of not cached pages, that should be read.
+    size_t runPages = 1;
+    while (runPages < MaxRunPages &&
+           pageAddress + runPages * PageSize < endAddress &&
+           m_pages.find(pageAddress + runPages * PageSize) == m_pages.end())
+    {
+        ++runPages;
+    }
+
+    uint8_t *run = AllocatePages(runPages);
+    const bool runReadable = m_readCallback(pageAddress, run, runPages * PageSize);
+    if (runReadable || runPages == 1)
+    {
+        for (size_t i = 0; i < runPages; ++i)
+        {
+            m_pages[pageAddress + i * PageSize] = runReadable ? run + i * PageSize : nullptr;
+        }
+        return runReadable ? run : nullptr;
+    }
+
+    // Some page in run can't be read, check pages one by one.
+    for (size_t i = 0; i < runPages; ++i)
+    {
+        uint8_t *page = run + i * PageSize;
+        m_pages[pageAddress + i * PageSize] = m_readCallback(pageAddress + i * PageSize, page, PageSize) ? page : nullptr;
+    }
+    return m_pages[pageAddress];
+}
+
+size_t MemoryCache::ReadDirect(uint64_t address, uint8_t *buffer, size_t size)
+{
+    if (m_readCallback(address, buffer, size))
+    {
+        return size;
+    }
+
+    // Find first unreadable page.
+    size_t read = 0;
+    while (read < size)
+    {
+        const size_t chunkSize = std::min(PageSize - static_cast<size_t>((address + read) % PageSize), size - read);
+        if (!m_readCallback(address + read, buffer + read, chunkSize))
+        {
+            break;
+        }
+        read += chunkSize;
+    }
+    return read;
+}
+
+size_t MemoryCache::Read(uint64_t address, uint8_t *buffer, size_t size)
+{
+    if (size > MaxRunPages * PageSize)
+    {
+        return ReadDirect(address, buffer, size);
+    }
+
+    size_t read = 0;
+    const uint64_t endAddress = address + size;
+    uint64_t pageAddress = address - (address % PageSize);
+    while (read < size)
+    {
+        auto find = m_pages.find(pageAddress);
+        const uint8_t *page = find != m_pages.end() ? find->second : FetchPages(pageAddress, endAddress);
+        if (page == nullptr)
+        {
+            break;
+        }
+
+        const size_t pageOffset = static_cast<size_t>((address + read) - pageAddress);
+        const size_t chunkSize = std::min(PageSize - pageOffset, size - read);
+        std::memcpy(buffer + read, page + pageOffset, chunkSize);
+        read += chunkSize;
+        pageAddress += PageSize;
+    }
+
+    return read;
+}
+
+} // namespace dncdbg
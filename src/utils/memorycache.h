@@ -0,0 +1,72 @@
+// Copyright (c) 2026 Mikhail Kurinnoi
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#ifndef UTILS_MEMORYCACHE_H
+#define UTILS_MEMORYCACHE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace dncdbg
+{
+
+// Page granular read-through cache of debuggee memory, for code that reads many small parts of the same memory
+// region (for example, PE headers parsing).
+//
+// Cache is intended for scoped use while debuggee memory can't be changed, it is not thread safe. Missing pages
+// are fetched by runs (up to `MaxRunPages` pages per read callback call) directly into slab memory, unreadable
+// pages are remembered too. Reads bigger than run bypass cache.
+class MemoryCache
+{
+  public:
+
+    static constexpr size_t PageSize = 4096;
+    // Maximum pages fetched by one read callback call, larger reads bypass cache.
+    static constexpr size_t MaxRunPages = 16;
+    // Pages are allocated by slabs, in case of limit reached, all cached pages are dropped.
+    static constexpr size_t SlabPages = 2 * MaxRunPages;
+    static constexpr size_t MaxSlabs = 16;
+
+    // Read `size` bytes at `address` into `buffer`, return `true` only in case all bytes were read.
+    using ReadCallback = std::function<bool(uint64_t address, uint8_t *buffer, size_t size)>;
+
+    explicit MemoryCache(ReadCallback readCallback)
+        : m_readCallback(std::move(readCallback))
+    {
+    }
+    MemoryCache(MemoryCache &&) = delete;
+    MemoryCache(const MemoryCache &) = delete;
+    MemoryCache &operator=(MemoryCache &&) = delete;
+    MemoryCache &operator=(const MemoryCache &) = delete;
+    ~MemoryCache() = default;
+
+    // Read `size` bytes at `address`, return number of bytes read before first unreadable page.
+    size_t Read(uint64_t address, uint8_t *buffer, size_t size);
+
+    // Drop all cached pages, must be called after debuggee memory change.
+    void Invalidate();
+
+  private:
+
+    using Slab = std::array<uint8_t, SlabPages * PageSize>;
+
+    ReadCallback m_readCallback;
+    // Page start address to page data in slab, `nullptr` for unreadable page.
+    std::unordered_map<uint64_t, const uint8_t *> m_pages;
+    std::vector<std::unique_ptr<Slab>> m_slabs;
+    size_t m_lastSlabUsedPages{0};
+
+    uint8_t *AllocatePages(size_t count);
+    const uint8_t *FetchPages(uint64_t pageAddress, uint64_t endAddress);
+    size_t ReadDirect(uint64_t address, uint8_t *buffer, size_t size);
+};
+
+} // namespace dncdbg
+
+#endif // UTILS_MEMORYCACHE_H
@@ -0,0 +1,305 @@
+// Copyright (c) 2026 Mikhail Kurinnoi
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "utils/metrics.h"
+#include "utils/logger.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <limits>
+#include <mutex>
+#include <thread>
+
+namespace dncdbg
+{
+
+namespace
+{
+
+constexpr size_t cacheLineSize = 64;
+// Should be enough to have all debugger threads (protocol, callbacks, commands, output writer) in different shards.
+constexpr size_t shardCount = 16;
+constexpr size_t counterCount = static_cast<size_t>(Metrics::Counter::Count);
+constexpr size_t histogramCount = static_cast<size_t>(Metrics::Histogram::Count);
+
+struct HistogramData
+{
+    std::atomic<uint64_t> count;
+    std::atomic<uint64_t> sum;
+    std::atomic<uint64_t> max;
+    std::array<std::atomic<uint64_t>, Metrics::HistogramBuckets> buckets;
+};
+
+struct alignas(cacheLineSize) Shard
+{
+    std::array<std::atomic<int64_t>, counterCount> counters;
+    std::array<HistogramData, histogramCount> histograms;
+};
+
+// Note, static storage is zero initialized.
+std::array<Shard, shardCount> &GetShards()
+{
+    static std::array<Shard, shardCount> shards;
+    return shards;
+}
+
+Shard &GetThreadShard()
+{
+    static std::atomic<size_t> nextShard{0};
+    static thread_local const size_t shardIndex = nextShard.fetch_add(1, std::memory_order_relaxed) % shardCount;
+    return GetShards()[shardIndex];
+}
+
+std::mutex snapshotMutex;
+// Process start or previous reset time, protected by snapshotMutex.
+std::chrono::steady_clock::time_point resetTime = std::chrono::steady_clock::now();
+
+size_t GetBucketIndex(uint64_t value)
+{
+    size_t index = 0;
+    while (value != 0)
+    {
+        value >>= 1;
+        ++index;
+    }
+    return index;
+}
+
+uint64_t ReadValue(std::atomic<uint64_t> &value, bool reset)
+{
+    return reset ? value.exchange(0, std::memory_order_relaxed) : value.load(std::memory_order_relaxed);
+}
+
+struct LogDumpState
+{
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::thread thread;
+    bool stop = false;
+};
+
+LogDumpState &GetLogDumpState()
+{
+    static LogDumpState logDumpState;
+    return logDumpState;
+}
+
+void LogSnapshot()
+{
+    Metrics::Snapshot snapshot;
+    Metrics::GetSnapshot(snapshot);
+    LOGI(log << "Metrics: "; Metrics::WriteSnapshot(log, snapshot));
+}
+
+} // unnamed namespace
+
+uint64_t Metrics::HistogramSnapshot::Percentile(double percentile) const
+{
+    if (count == 0)
+    {
+        return 0;
+    }
+
+    const auto rank = static_cast<uint64_t>(static_cast<double>(count) * percentile / 100.0);
+    uint64_t seen = 0;
+    for (size_t i = 0; i < HistogramBuckets; ++i)
+    {
+        seen += buckets[i];
+        if (seen > rank || seen == count)
+        {
+            uint64_t upperBound = std::numeric_limits<uint64_t>::max();
+            if (i < HistogramBuckets - 1)
+            {
+                upperBound = (uint64_t{1} << i) - 1;
+            }
+            return std::min(upperBound, max);
+        }
+    }
+
+    return max;
+}
+
+void Metrics::Add(Counter counter, int64_t value)
+{
+    GetThreadShard().counters[static_cast<size_t>(counter)].fetch_add(value, std::memory_order_relaxed);
+}
+
+void Metrics::Record(Histogram histogram, uint64_t value)
+{
+    HistogramData &data = GetThreadShard().histograms[static_cast<size_t>(histogram)];
+    data.count.fetch_add(1, std::memory_order_relaxed);
+    data.sum.fetch_add(value, std::memory_order_relaxed);
+    data.buckets[GetBucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+
+    uint64_t max = data.max.load(std::memory_order_relaxed);
+    while (value > max && !data.max.compare_exchange_weak(max, value, std::memory_order_relaxed))
+    {
+    }
+}
+
+void Metrics::GetSnapshot(Snapshot &snapshot, bool reset)
+{
+    const std::scoped_lock<std::mutex> lock(snapshotMutex);
+
+    snapshot = Snapshot();
+    const auto now = std::chrono::steady_clock::now();
+    snapshot.elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - resetTime);
+    if (reset)
+    {
+        resetTime = now;
+    }
+
+    for (Shard &shard : GetShards())
+    {
+        for (size_t i = 0; i < counterCount; ++i)
+        {
+            snapshot.counters[i] += reset ? shard.counters[i].exchange(0, std::memory_order_relaxed)
+                                          : shard.counters[i].load(std::memory_order_relaxed);
+        }
+
+        for (size_t i = 0; i < histogramCount; ++i)
+        {
+            HistogramData &data = shard.histograms[i];
+            HistogramSnapshot &result = snapshot.histograms[i];
+            result.count += ReadValue(data.count, reset);
+            result.sum += ReadValue(data.sum, reset);
+            result.max = std::max(result.max, ReadValue(data.max, reset));
+            for (size_t j = 0; j < HistogramBuckets; ++j)
+            {
+                result.buckets[j] += ReadValue(data.buckets[j], reset);
+            }
+        }
+    }
+
+    // Level counters are not reset, since they reflect current state (restore reset value).
+    if (reset)
+    {
+        const auto levelIndex = static_cast<size_t>(Counter::SymbolsBytesLoaded);
+        GetShards()[0].counters[levelIndex].fetch_add(snapshot.counters[levelIndex], std::memory_order_relaxed);
+    }
+}
+
+void Metrics::WriteSnapshot(std::ostream &out, const Snapshot &snapshot)
+{
+    out << "elapsed=" << snapshot.elapsed.count() << "ms";
+
+    for (size_t i = 0; i < counterCount; ++i)
+    {
+        if (snapshot.counters[i] != 0)
+        {
+            out << ' ' << GetName(static_cast<Counter>(i)) << '=' << snapshot.counters[i];
+        }
+    }
+
+    for (size_t i = 0; i < histogramCount; ++i)
+    {
+        const HistogramSnapshot &histogram = snapshot.histograms[i];
+        if (histogram.count == 0)
+        {
+            continue;
+        }
+
+        out << ' ' << GetName(static_cast<Histogram>(i)) << "={count=" << histogram.count
+            << " sum=" << histogram.sum
+            << " p50=" << histogram.Percentile(50)
+            << " p90=" << histogram.Percentile(90)
+            << " p99=" << histogram.Percentile(99)
+            << " max=" << histogram.max << '}';
+    }
+}
+
+const char *Metrics::GetName(Counter counter)
+{
+    static const std::array<const char *, counterCount> names{
+        "callbacksQueued",
+        "callbacksProcessed",
+        "stopEvents",
+        "funcEvals",
+        "funcEvalsFailed",
+        "funcEvalsTimedOut",
+        "symbolsLoaded",
+        "symbolsCacheReused",
+        "symbolsBytesLoaded",
+        "symbolsIndexesEvicted",
+        "symbolsIndexesRebuilt",
+        "userCodeOffsetsHits",
+        "userCodeOffsetsMisses",
+        "asyncInfoHits",
+        "asyncInfoMisses",
+        "variablesRequests",
+        "variableReferences",
+        "dapRequestsRead",
+        "dapBytesRead",
+        "dapMessagesWritten",
+        "dapBytesWritten",
+        "dapBatchesWritten"
+    };
+    return names[static_cast<size_t>(counter)];
+}
+
+const char *Metrics::GetName(Histogram histogram)
+{
+    static const std::array<const char *, histogramCount> names{
+        "funcEvalTimeUs",
+        "variablesRequestTimeUs",
+        "symbolsLoadTimeUs",
+        "dapBatchMessages",
+        "dapBatchBytes",
+        "breakpointQueueUs",
+        "breakpointDecisionUs",
+        "breakpointStoppedUs",
+        "breakpointStackTraceUs",
+        "stepCompleteQueueUs",
+        "stepCompleteDecisionUs",
+        "stepCompleteStoppedUs",
+        "stepCompleteStackTraceUs",
+        "breakQueueUs",
+        "breakDecisionUs",
+        "breakStoppedUs",
+        "breakStackTraceUs",
+        "exceptionQueueUs",
+        "exceptionDecisionUs",
+        "exceptionStoppedUs",
+        "exceptionStackTraceUs"
+    };
+    return names[static_cast<size_t>(histogram)];
+}
+
+void Metrics::StartLogDump(std::chrono::seconds interval)
+{
+    LogDumpState &state = GetLogDumpState();
+    if (interval.count() == 0 || state.thread.joinable())
+    {
+        return;
+    }
+
+    state.stop = false;
+    state.thread = std::thread([&state, interval]()
+        {
+            std::unique_lock<std::mutex> lock(state.mutex);
+            while (!state.cv.wait_for(lock, interval, [&state]() { return state.stop; }))
+            {
+                LogSnapshot();
+            }
+        });
+}
+
+void Metrics::StopLogDump()
+{
+    LogDumpState &state = GetLogDumpState();
+    if (!state.thread.joinable())
+    {
+        return;
+    }
+
+    {
+        const std::scoped_lock<std::mutex> lock(state.mutex);
+        state.stop = true;
+        state.cv.notify_one(); // notify_one with lock
+    }
+    state.thread.join();
+    LogSnapshot();
+}
+
+} // namespace dncdbg
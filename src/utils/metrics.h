@@ -0,0 +1,156 @@
+// Copyright (c) 2026 Mikhail Kurinnoi
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#ifndef UTILS_METRICS_H
+#define UTILS_METRICS_H
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+namespace dncdbg
+{
+
+// Metrics is process wide registry of runtime counters and histograms, intended for sessions comparison
+// and regressions search (how many func-evals were run, cache hit rates, amount of data sent to IDE, etc).
+//
+// Values are stored in per-thread shards (thread is bound to shard at first update), so update is relaxed
+// atomic add into cache line that is not shared with other threads in most cases. Snapshot sums all shards,
+// snapshot taken during updates is consistent for each metric, but not between different metrics.
+class Metrics
+{
+  public:
+
+    // Note, `GetName()` must be updated in case of new entry.
+    enum class Counter : uint8_t
+    {
+        CallbacksQueued,
+        CallbacksProcessed,
+        StopEvents,
+        FuncEvals,
+        FuncEvalsFailed,
+        FuncEvalsTimedOut,
+        SymbolsLoaded,
+        SymbolsCacheReused,
+        SymbolsBytesLoaded,  // Level: PDB data bytes (mapped or embedded) of currently loaded modules.
+        SymbolsIndexesEvicted,
+        SymbolsIndexesRebuilt,
+        UserCodeOffsetsHits,
+        UserCodeOffsetsMisses,
+        AsyncInfoHits,
+        AsyncInfoMisses,
+        VariablesRequests,
+        VariableReferences,
+        DAPRequestsRead,
+        DAPBytesRead,
+        DAPMessagesWritten,
+        DAPBytesWritten,
+        DAPBatchesWritten,
+        Count // Must be last.
+    };
+
+    // Note, `GetName()` must be updated in case of new entry.
+    enum class Histogram : uint8_t
+    {
+        FuncEvalTimeUs,
+        VariablesRequestTimeUs,
+        SymbolsLoadTimeUs,
+        DAPBatchMessages,
+        DAPBatchBytes,
+        // Stop latency by callback type (see CallbacksQueue), stages order must be the same for all types:
+        // arrival to dequeue, dequeue to stop decision, arrival to stopped event, stopped event to stack trace.
+        BreakpointQueueUs,
+        BreakpointDecisionUs,
+        BreakpointStoppedUs,
+        BreakpointStackTraceUs,
+        StepCompleteQueueUs,
+        StepCompleteDecisionUs,
+        StepCompleteStoppedUs,
+        StepCompleteStackTraceUs,
+        BreakQueueUs,
+        BreakDecisionUs,
+        BreakStoppedUs,
+        BreakStackTraceUs,
+        ExceptionQueueUs,
+        ExceptionDecisionUs,
+        ExceptionStoppedUs,
+        ExceptionStackTraceUs,
+        Count // Must be last.
+    };
+
+    // Histogram bucket `i` holds values with bit width `i`: bucket 0 - zero, bucket 1 - one,
+    // bucket 2 - [2, 3], bucket 3 - [4, 7], ..., bucket 64 - [2^63, 2^64 - 1].
+    static constexpr size_t HistogramBuckets = 65;
+
+    struct HistogramSnapshot
+    {
+        uint64_t count = 0;
+        uint64_t sum = 0;
+        uint64_t max = 0;
+        std::array<uint64_t, HistogramBuckets> buckets{};
+
+        // Estimation by bucket upper bound (limited by max value), `percentile` in [0, 100] range.
+        [[nodiscard]] uint64_t Percentile(double percentile) const;
+    };
+
+    struct Snapshot
+    {
+        std::chrono::milliseconds elapsed{0}; // Time since process start or previous reset.
+        std::array<int64_t, static_cast<size_t>(Counter::Count)> counters{};
+        std::array<HistogramSnapshot, static_cast<size_t>(Histogram::Count)> histograms{};
+    };
+
+    // Record histogram value with time passed from object creation to destruction (in microseconds).
+    class ScopedTimer
+    {
+      public:
+
+        explicit ScopedTimer(Histogram histogram)
+            : m_histogram(histogram),
+              m_start(std::chrono::steady_clock::now())
+        {
+        }
+        ScopedTimer(ScopedTimer &&) = delete;
+        ScopedTimer(const ScopedTimer &) = delete;
+        ScopedTimer &operator=(ScopedTimer &&) = delete;
+        ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+        ~ScopedTimer()
+        {
+            RecordTime(m_histogram, std::chrono::steady_clock::now() - m_start);
+        }
+
+      private:
+
+        Histogram m_histogram;
+        std::chrono::steady_clock::time_point m_start;
+    };
+
+    // Note, negative `value` is allowed for level counters.
+    static void Add(Counter counter, int64_t value = 1);
+    static void Record(Histogram histogram, uint64_t value);
+    // Record duration in microseconds.
+    static void RecordTime(Histogram histogram, std::chrono::steady_clock::duration duration)
+    {
+        Record(histogram, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(duration).count()));
+    }
+
+    // In case `reset` is true, metrics are set to zero right after read (updates are not lost).
+    static void GetSnapshot(Snapshot &snapshot, bool reset = false);
+    static void WriteSnapshot(std::ostream &out, const Snapshot &snapshot);
+
+    static const char *GetName(Counter counter);
+    static const char *GetName(Histogram histogram);
+
+    // Periodically write metrics snapshot into debugger log, zero interval disables dump.
+    static void StartLogDump(std::chrono::seconds interval);
+    // Stop dump thread and write final snapshot.
+    static void StopLogDump();
+};
+
+} // namespace dncdbg
+
+#endif // UTILS_METRICS_H
@@ -0,0 +1,100 @@
+// Copyright (c) 2026 Mikhail Kurinnoi
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#ifndef UTILS_MPSCQUEUE_H
+#define UTILS_MPSCQUEUE_H
+
+#include <atomic>
+#include <utility>
+#include <vector>
+
+namespace dncdbg
+{
+
+// Lock-free multi-producer single-consumer queue.
+//
+// Producers push entries with a single CAS on the list head (no locks, no waiting on the consumer).
+// The consumer takes all pending entries at once and receives them in push order.
+//
+// Note, queue don't provide any consumer wakeup logic, Push() returns `true` in case queue was empty,
+// so producer could notify consumer only on empty -> non-empty transition.
+template <typename T>
+class MPSCQueue
+{
+  public:
+
+    MPSCQueue() = default;
+    MPSCQueue(MPSCQueue &&) = delete;
+    MPSCQueue(const MPSCQueue &) = delete;
+    MPSCQueue &operator=(MPSCQueue &&) = delete;
+    MPSCQueue &operator=(const MPSCQueue &) = delete;
+
+    ~MPSCQueue()
+    {
+        Node *node = m_head.exchange(nullptr, std::memory_order_acquire);
+        while (node != nullptr)
+        {
+            Node *next = node->next;
+            delete node;
+            node = next;
+        }
+    }
+
+    // Returns `true` in case queue was empty before this push.
+    bool Push(T &&value)
+    {
+        Node *node = new Node{std::move(value), nullptr};
+        Node *head = m_head.load(std::memory_order_relaxed);
+        do
+        {
+            node->next = head;
+        }
+        while (!m_head.compare_exchange_weak(head, node, std::memory_order_release, std::memory_order_relaxed));
+
+        return head == nullptr;
+    }
+
+    [[nodiscard]] bool Empty() const
+    {
+        return m_head.load(std::memory_order_acquire) == nullptr;
+    }
+
+    // Consumer only. Move all pending entries into `out` (appended in push order).
+    void PopAll(std::vector<T> &out)
+    {
+        Node *node = m_head.exchange(nullptr, std::memory_order_acquire);
+
+        // Entries are stored in LIFO order, reverse list first.
+        Node *reversed = nullptr;
+        while (node != nullptr)
+        {
+            Node *next = node->next;
+            node->next = reversed;
+            reversed = node;
+            node = next;
+        }
+
+        while (reversed != nullptr)
+        {
+            Node *next = reversed->next;
+            out.emplace_back(std::move(reversed->value));
+            delete reversed;
+            reversed = next;
+        }
+    }
+
+  private:
+
+    struct Node
+    {
+        T value;
+        Node *next;
+    };
+
+    std::atomic<Node *> m_head{nullptr};
+};
+
+} // namespace dncdbg
+
+#endif // UTILS_MPSCQUEUE_H
@@ -0,0 +1,266 @@
+// Copyright (c) 2026 Mikhail Kurinnoi
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "utils/outputcoalescer.h"
+#include <algorithm>
+#include <string_view>
+#include <vector>
+
+namespace dncdbg
+{
+
+namespace
+{
+
+// Note, must be bigger than longest UTF-8 sequence, so size based delivery always have progress.
+constexpr size_t minOutputSize = 1024;
+
+// Returns data size without incomplete UTF-8 sequence at the end (if any).
+size_t CompleteUtf8Size(std::string_view data)
+{
+    const size_t size = data.size();
+    constexpr size_t maxSequenceTail = 3;
+    for (size_t back = 1; back <= maxSequenceTail && back <= size; ++back)
+    {
+        const auto byte = static_cast<unsigned char>(data[size - back]);
+        if ((byte & 0xC0) == 0x80) // continuation byte
+        {
+            continue;
+        }
+
+        size_t sequenceLength = 1;
+        if ((byte & 0xE0) == 0xC0)
+        {
+            sequenceLength = 2;
+        }
+        else if ((byte & 0xF0) == 0xE0)
+        {
+            sequenceLength = 3;
+        }
+        else if ((byte & 0xF8) == 0xF0)
+        {
+            sequenceLength = 4;
+        }
+
+        return sequenceLength > back ? size - back : size;
+    }
+
+    return size;
+}
+
+// Returns size of first portion, that should be delivered for data bigger than `maxSize`.
+size_t PortionSize(std::string_view data, size_t maxSize)
+{
+    if (data.size() <= maxSize)
+    {
+        return data.size();
+    }
+
+    const std::string_view window = data.substr(0, maxSize);
+    const size_t newLine = window.rfind('\n');
+    if (newLine != std::string_view::npos)
+    {
+        return newLine + 1;
+    }
+
+    const size_t size = CompleteUtf8Size(window);
+    return size == 0 ? maxSize : size;
+}
+
+} // unnamed namespace
+
+OutputCoalescer::OutputCoalescer(OutputCallback outputCallback, DroppedCallback droppedCallback, BusyCallback busyCallback)
+    : m_outputCallback(std::move(outputCallback)),
+      m_droppedCallback(std::move(droppedCallback)),
+      m_busyCallback(std::move(busyCallback)),
+      m_worker(m_mutex,
+               [this](Clock::time_point now, Clock::time_point &deadline) { return IsReadyForConsumer(now, deadline); },
+               [this](bool flush) { Deliver(flush); })
+{
+}
+
+OutputCoalescer::~OutputCoalescer()
+{
+    m_worker.Stop();
+}
+
+void OutputCoalescer::SetOptions(const Options &options)
+{
+    const std::scoped_lock<std::mutex> lock(m_mutex);
+    m_options = options;
+    m_options.flushInterval = std::max(options.flushInterval, std::chrono::milliseconds(1));
+    m_options.maxOutputSize = std::max(options.maxOutputSize, minOutputSize);
+    m_options.maxBacklogSize = std::max(options.maxBacklogSize, m_options.maxOutputSize);
+}
+
+void OutputCoalescer::Append(IORedirect::StreamType type, gsl::span<const char> data)
+{
+    if (data.empty())
+    {
+        return;
+    }
+
+    const std::scoped_lock<std::mutex> lock(m_mutex);
+
+    m_worker.Start();
+
+    StreamState &stream = m_streams.at(static_cast<size_t>(type));
+
+    // Drop whole chunk, in order to don't break UTF-8 sequence in collected data.
+    if (!stream.pending.empty() && stream.pending.size() + data.size() > m_options.maxBacklogSize)
+    {
+        if (stream.droppedBytes == 0)
+        {
+            stream.droppedOffset = stream.pending.size();
+        }
+        stream.droppedBytes += data.size();
+        return;
+    }
+
+    const bool wasEmpty = stream.pending.empty();
+    const bool wasBelowLimit = stream.pending.size() < m_options.maxOutputSize;
+    if (wasEmpty)
+    {
+        stream.pendingSince = Clock::now();
+    }
+    stream.pending.append(data.data(), data.size());
+
+    if (wasEmpty || (wasBelowLimit && stream.pending.size() >= m_options.maxOutputSize))
+    {
+        m_worker.Notify();
+    }
+}
+
+void OutputCoalescer::Flush()
+{
+    m_worker.Flush();
+}
+
+bool OutputCoalescer::IsReady(Clock::time_point now, Clock::time_point &deadline) const
+{
+    bool ready = false;
+    for (const auto &stream : m_streams)
+    {
+        if (stream.pending.empty())
+        {
+            ready = ready || stream.droppedBytes != 0;
+            continue;
+        }
+
+        const Clock::time_point expire = stream.pendingSince + m_options.flushInterval;
+        if (stream.pending.size() >= m_options.maxOutputSize || now >= expire)
+        {
+            ready = true;
+        }
+        deadline = std::min(deadline, expire);
+    }
+    return ready;
+}
+
+// Caller must hold m_mutex.
+bool OutputCoalescer::IsReadyForConsumer(Clock::time_point now, Clock::time_point &deadline) const
+{
+    if (!IsReady(now, deadline))
+    {
+        return false;
+    }
+
+    if (m_busyCallback && m_busyCallback())
+    {
+        // Consumer is backed up, keep collecting data in backlog.
+        deadline = now + m_options.flushInterval;
+        return false;
+    }
+
+    return true;
+}
+
+// Called by m_worker with delivery lock held.
+void OutputCoalescer::Deliver(bool force)
+{
+    struct Portion
+    {
+        IORedirect::StreamType type;
+        std::string text;
+        size_t droppedBytes;
+    };
+    std::vector<Portion> portions;
+
+    {
+        const std::scoped_lock<std::mutex> lock(m_mutex);
+        const Clock::time_point now = Clock::now();
+
+        for (size_t i = 0; i < StreamsCount; ++i)
+        {
+            const auto type = static_cast<IORedirect::StreamType>(i);
+            StreamState &stream = m_streams.at(i);
+
+            const bool expired = !stream.pending.empty() && now >= stream.pendingSince + m_options.flushInterval;
+            size_t end = 0;
+            if (force)
+            {
+                end = stream.pending.size();
+            }
+            else if (expired)
+            {
+                end = CompleteUtf8Size(stream.pending);
+            }
+            else if (stream.pending.size() >= m_options.maxOutputSize)
+            {
+                // Keep partial last line for next delivery.
+                end = stream.pending.rfind('\n');
+                end = (end == std::string::npos) ? CompleteUtf8Size(stream.pending) : end + 1;
+            }
+
+            auto addPortions = [&](size_t begin, size_t finish)
+            {
+                std::string_view data(stream.pending.data() + begin, finish - begin);
+                while (!data.empty())
+                {
+                    const size_t size = PortionSize(data, m_options.maxOutputSize);
+                    portions.push_back({type, std::string(data.substr(0, size)), 0});
+                    data.remove_prefix(size);
+                }
+            };
+
+            if (stream.droppedBytes != 0 && end >= stream.droppedOffset)
+            {
+                addPortions(0, stream.droppedOffset);
+                portions.push_back({type, {}, stream.droppedBytes});
+                addPortions(stream.droppedOffset, end);
+                stream.droppedBytes = 0;
+                stream.droppedOffset = 0;
+            }
+            else
+            {
+                addPortions(0, end);
+                stream.droppedOffset -= std::min(stream.droppedOffset, end);
+            }
+
+            stream.pending.erase(0, end);
+            if (expired && !stream.pending.empty())
+            {
+                // Incomplete UTF-8 sequence left, wait for the rest of it during next interval.
+                stream.pendingSince = now;
+            }
+        }
+    }
+
+    for (auto &portion : portions)
+    {
+        if (portion.droppedBytes != 0)
+        {
+            if (m_droppedCallback)
+            {
+                m_droppedCallback(portion.type, portion.droppedBytes);
+            }
+        }
+        else if (m_outputCallback)
+        {
+            m_outputCallback(portion.type, std::move(portion.text));
+        }
+    }
+}
+
+} // namespace dncdbg
@@ -0,0 +1,96 @@
+// Copyright (c) 2026 Mikhail Kurinnoi
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#ifndef UTILS_OUTPUTCOALESCER_H
+#define UTILS_OUTPUTCOALESCER_H
+
+#include "utils/batchworker.h"
+#include "utils/ioredirect.h"
+#include <gsl/span>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string>
+
+namespace dncdbg
+{
+
+// OutputCoalescer joins small chunks of debuggee stdout/stderr into bigger output portions.
+//
+// Data is collected per stream and delivered from internal worker thread when:
+//   - collected data reached `maxOutputSize` bytes;
+//   - oldest collected data is older than `flushInterval`;
+//   - Flush() is called (for example, before process exit event).
+// Delivered portions are split on line boundaries where possible (partial last line is kept until
+// `flushInterval` expired) and never split in the middle of UTF-8 sequence.
+//
+// In case consumer is not ready (BusyCallback returns `true`), data is kept up to `maxBacklogSize`
+// bytes per stream, new data is dropped after that. Amount of dropped data is reported by
+// DroppedCallback right after the data collected before drop.
+class OutputCoalescer
+{
+  public:
+
+    struct Options
+    {
+        std::chrono::milliseconds flushInterval{20};
+        size_t maxOutputSize{64 * 1024};
+        size_t maxBacklogSize{16 * 1024 * 1024};
+    };
+
+    // Callbacks are called from worker thread or Flush() caller thread, but never in parallel.
+    using OutputCallback = std::function<void(IORedirect::StreamType, std::string &&)>;
+    using DroppedCallback = std::function<void(IORedirect::StreamType, size_t)>;
+    using BusyCallback = std::function<bool()>;
+
+    OutputCoalescer(OutputCallback outputCallback, DroppedCallback droppedCallback, BusyCallback busyCallback);
+    OutputCoalescer(OutputCoalescer &&) = delete;
+    OutputCoalescer(const OutputCoalescer &) = delete;
+    OutputCoalescer &operator=(OutputCoalescer &&) = delete;
+    OutputCoalescer &operator=(const OutputCoalescer &) = delete;
+    // Stop worker thread and deliver all collected data.
+    ~OutputCoalescer();
+
+    void SetOptions(const Options &options);
+
+    // Collect data, called by IORedirect worker threads. Worker thread is started at first call.
+    void Append(IORedirect::StreamType type, gsl::span<const char> data);
+
+    // Deliver all collected data now, regardless of thresholds and consumer state.
+    void Flush();
+
+  private:
+
+    using Clock = BatchWorker::Clock;
+
+    struct StreamState
+    {
+        std::string pending;
+        Clock::time_point pendingSince;
+        size_t droppedBytes{0};
+        size_t droppedOffset{0}; // `pending` size at first drop, dropped bytes notice position
+    };
+
+    static constexpr size_t StreamsCount = 2;
+
+    OutputCallback m_outputCallback;
+    DroppedCallback m_droppedCallback;
+    BusyCallback m_busyCallback;
+
+    std::mutex m_mutex;
+    Options m_options;
+    std::array<StreamState, StreamsCount> m_streams;
+    BatchWorker m_worker;
+
+    // Caller must hold m_mutex.
+    bool IsReady(Clock::time_point now, Clock::time_point &deadline) const;
+    bool IsReadyForConsumer(Clock::time_point now, Clock::time_point &deadline) const;
+    void Deliver(bool force);
+};
+
+} // namespace dncdbg
+
+#endif // UTILS_OUTPUTCOALESCER_H
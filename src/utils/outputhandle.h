@@ -0,0 +1,83 @@
+// Copyright (c) 2026 Mikhail Kurinnoi
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#ifndef UTILS_OUTPUTHANDLE_H
+#define UTILS_OUTPUTHANDLE_H
+
+#include <gsl/span>
+#include <cstdint>
+#include <string_view>
+
+namespace dncdbg
+{
+
+// OutputHandle is a non-inheritable output handle with gather write support.
+//
+// Standard output is duplicated at open, so temporary std handles redirection during debuggee
+// launch (see IORedirect::Exec()) can't affect protocol output and debuggee don't inherit it.
+// In server mode (see DAPServer) protocol output is connected client socket instead.
+class OutputHandle
+{
+  public:
+
+    OutputHandle() = default;
+    OutputHandle(OutputHandle &&) = delete;
+    OutputHandle(const OutputHandle &) = delete;
+    OutputHandle &operator=(OutputHandle &&) = delete;
+    OutputHandle &operator=(const OutputHandle &) = delete;
+    ~OutputHandle();
+
+#ifdef _WIN32
+    using NativeSocket = uintptr_t; // SOCKET on Windows
+#endif // _WIN32
+#ifdef FEATURE_PAL
+    using NativeSocket = int; // socket descriptor on Unix
+#endif // FEATURE_PAL
+
+    // Duplicate process standard output. Returns true on success.
+    bool OpenStdout();
+    // Use connected socket (could be in nonblocking mode) for output. On Unix socket descriptor is
+    // duplicated, on Windows socket is used as is and must not be closed while handle is open.
+    // Returns true on success.
+    bool OpenSocket(NativeSocket socket);
+
+    [[nodiscard]] bool IsOpen() const
+    {
+        return m_handle != invalidHandle();
+    }
+
+    // Write all chunks in order. On Unix this is done by writev() calls (one call in most cases),
+    // on Windows chunks are joined into one buffer for single WriteFile() call.
+    // Returns false on any write error.
+    bool WriteAll(gsl::span<const std::string_view> chunks);
+
+    void Close();
+
+  private:
+
+#ifdef _WIN32
+    using NativeHandle = void *; // HANDLE on Windows
+    static NativeHandle invalidHandle()
+    {
+        return reinterpret_cast<NativeHandle>(static_cast<intptr_t>(-1));
+    }
+#endif // _WIN32
+
+#ifdef FEATURE_PAL
+    using NativeHandle = int; // file descriptor on Unix
+    static NativeHandle invalidHandle()
+    {
+        return -1;
+    }
+#endif // FEATURE_PAL
+
+    NativeHandle m_handle{invalidHandle()};
+#ifdef _WIN32
+    bool m_isSocket{false}; // m_handle is not owned socket, written by send()
+#endif // _WIN32
+};
+
+} // namespace dncdbg
+
+#endif // UTILS_OUTPUTHANDLE_H
@@ -0,0 +1,156 @@
+// Copyright (c) 2026 Mikhail Kurinnoi
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#ifdef FEATURE_PAL
+
+#include "utils/outputhandle.h"
+#include "utils/logger.h"
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <csignal>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <vector>
+
+namespace dncdbg
+{
+
+namespace
+{
+
+#ifdef IOV_MAX
+constexpr size_t maxIovCount = IOV_MAX;
+#else
+constexpr size_t maxIovCount = 16; // _XOPEN_IOV_MAX
+#endif
+
+// Wait until descriptor is ready for write, in case it was opened in nonblocking mode by other side.
+bool WaitWritable(int fd)
+{
+    pollfd pfd{};
+    pfd.fd = fd;
+    pfd.events = POLLOUT;
+    while (::poll(&pfd, 1, -1) < 0)
+    {
+        if (errno != EINTR)
+        {
+            return false;
+        }
+    }
+    return (pfd.revents & (POLLERR | POLLHUP | POLLNVAL)) == 0;
+}
+
+} // unnamed namespace
+
+OutputHandle::~OutputHandle()
+{
+    Close();
+}
+
+bool OutputHandle::OpenStdout()
+{
+    Close();
+
+    // Ignore SIGPIPE, so write into closed by IDE pipe return EPIPE instead of killing the process.
+    static_cast<void>(::signal(SIGPIPE, SIG_IGN));
+
+    m_handle = ::fcntl(STDOUT_FILENO, F_DUPFD_CLOEXEC, 0); // NOLINT(cppcoreguidelines-pro-type-vararg)
+    if (m_handle == invalidHandle())
+    {
+        LOGE(log << "OutputHandle: fcntl(F_DUPFD_CLOEXEC) failed, errno=" << errno);
+        return false;
+    }
+
+    return true;
+}
+
+bool OutputHandle::OpenSocket(NativeSocket socket)
+{
+    Close();
+
+    // Ignore SIGPIPE, so write into socket closed by IDE return EPIPE instead of killing the process.
+    static_cast<void>(::signal(SIGPIPE, SIG_IGN));
+
+    m_handle = ::fcntl(socket, F_DUPFD_CLOEXEC, 0); // NOLINT(cppcoreguidelines-pro-type-vararg)
+    if (m_handle == invalidHandle())
+    {
+        LOGE(log << "OutputHandle: fcntl(F_DUPFD_CLOEXEC) failed, errno=" << errno);
+        return false;
+    }
+
+    return true;
+}
+
+bool OutputHandle::WriteAll(gsl::span<const std::string_view> chunks)
+{
+    if (m_handle == invalidHandle())
+    {
+        return false;
+    }
+
+    std::vector<iovec> iov;
+    iov.reserve(chunks.size());
+    for (const auto &chunk : chunks)
+    {
+        if (!chunk.empty())
+        {
+            iov.push_back({const_cast<char *>(chunk.data()), chunk.size()}); // NOLINT(cppcoreguidelines-pro-type-const-cast)
+        }
+    }
+
+    size_t index = 0;
+    while (index < iov.size())
+    {
+        const size_t count = std::min(maxIovCount, iov.size() - index);
+        ssize_t written = ::writev(m_handle, &iov.at(index), static_cast<int>(count));
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            if ((errno == EAGAIN || errno == EWOULDBLOCK) && WaitWritable(m_handle))
+            {
+                continue;
+            }
+            LOGE(log << "OutputHandle: writev() failed, errno=" << errno);
+            return false;
+        }
+
+        // Handle partial write, skip fully written chunks and adjust first partially written one.
+        while (written > 0 && index < iov.size())
+        {
+            iovec &entry = iov.at(index);
+            if (static_cast<size_t>(written) >= entry.iov_len)
+            {
+                written -= static_cast<ssize_t>(entry.iov_len);
+                ++index;
+            }
+            else
+            {
+                entry.iov_base = static_cast<char *>(entry.iov_base) + written;
+                entry.iov_len -= static_cast<size_t>(written);
+                written = 0;
+            }
+        }
+    }
+
+    return true;
+}
+
+void OutputHandle::Close()
+{
+    if (m_handle != invalidHandle())
+    {
+        ::close(m_handle);
+        m_handle = invalidHandle();
+    }
+}
+
+} // namespace dncdbg
+
+#endif // FEATURE_PAL
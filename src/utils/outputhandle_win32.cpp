@@ -0,0 +1,150 @@
+// Copyright (c) 2026 Mikhail Kurinnoi
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#ifdef _WIN32
+
+#include "utils/outputhandle.h"
+#include "utils/logger.h"
+#include <string>
+#include <winsock2.h>
+#include <windows.h>
+
+namespace dncdbg
+{
+
+namespace
+{
+
+// Send whole buffer into socket, that could be in nonblocking mode.
+bool SendAll(SOCKET socket, const std::string &buffer)
+{
+    size_t totalSent = 0;
+    while (totalSent < buffer.size())
+    {
+        const int sent = ::send(socket, buffer.data() + totalSent, static_cast<int>(buffer.size() - totalSent), 0);
+        if (sent != SOCKET_ERROR)
+        {
+            totalSent += static_cast<size_t>(sent);
+            continue;
+        }
+
+        const int error = WSAGetLastError();
+        if (error != WSAEWOULDBLOCK)
+        {
+            LOGE(log << "OutputHandle: send() failed, err=" << error);
+            return false;
+        }
+
+        fd_set writeSet;
+        FD_ZERO(&writeSet);
+        FD_SET(socket, &writeSet);
+        if (::select(0, nullptr, &writeSet, nullptr, nullptr) == SOCKET_ERROR)
+        {
+            LOGE(log << "OutputHandle: select() failed, err=" << WSAGetLastError());
+            return false;
+        }
+    }
+
+    return true;
+}
+
+} // unnamed namespace
+
+OutputHandle::~OutputHandle()
+{
+    Close();
+}
+
+bool OutputHandle::OpenStdout()
+{
+    Close();
+
+    HANDLE stdoutHandle = GetStdHandle(STD_OUTPUT_HANDLE);
+    if (stdoutHandle == INVALID_HANDLE_VALUE || stdoutHandle == nullptr)
+    {
+        LOGE(log << "OutputHandle: GetStdHandle failed, error=" << GetLastError());
+        return false;
+    }
+
+    // Duplicate as non-inheritable handle, debuggee process must not hold protocol output.
+    HANDLE duplicated = INVALID_HANDLE_VALUE;
+    if (!DuplicateHandle(GetCurrentProcess(), stdoutHandle, GetCurrentProcess(), &duplicated,
+                         0, FALSE, DUPLICATE_SAME_ACCESS))
+    {
+        LOGE(log << "OutputHandle: DuplicateHandle failed, error=" << GetLastError());
+        return false;
+    }
+
+    m_handle = duplicated;
+    return true;
+}
+
+bool OutputHandle::OpenSocket(NativeSocket socket)
+{
+    Close();
+
+    // Socket handle can't be duplicated by DuplicateHandle(), socket is not owned and used as is.
+    m_handle = reinterpret_cast<NativeHandle>(socket);
+    m_isSocket = true;
+    return true;
+}
+
+bool OutputHandle::WriteAll(gsl::span<const std::string_view> chunks)
+{
+    if (m_handle == invalidHandle())
+    {
+        return false;
+    }
+
+    // Windows have WriteFileGather() for page aligned buffers only, join chunks into one buffer instead.
+    size_t totalSize = 0;
+    for (const auto &chunk : chunks)
+    {
+        totalSize += chunk.size();
+    }
+
+    std::string buffer;
+    buffer.reserve(totalSize);
+    for (const auto &chunk : chunks)
+    {
+        buffer.append(chunk);
+    }
+
+    if (m_isSocket)
+    {
+        return SendAll(reinterpret_cast<SOCKET>(m_handle), buffer);
+    }
+
+    size_t totalWritten = 0;
+    while (totalWritten < buffer.size())
+    {
+        DWORD written = 0;
+        if (!WriteFile(m_handle, buffer.data() + totalWritten, static_cast<DWORD>(buffer.size() - totalWritten),
+                       &written, nullptr))
+        {
+            LOGE(log << "OutputHandle: WriteFile failed, error=" << GetLastError());
+            return false;
+        }
+        totalWritten += written;
+    }
+
+    return true;
+}
+
+void OutputHandle::Close()
+{
+    if (m_handle != invalidHandle())
+    {
+        if (!m_isSocket)
+        {
+            CloseHandle(m_handle);
+        }
+        m_handle = invalidHandle();
+        m_isSocket = false;
+    }
+}
+
+} // namespace dncdbg
+
+#endif // _WIN32
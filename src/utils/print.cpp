@@ -4,12 +4,125 @@
 // See the LICENSE file in the project root for more information.
 
 #include "utils/print.h"
+#include <array>
+#include <cstdint>
 #include <iomanip>
 #include <sstream>
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
 
 namespace dncdbg
 {
 
+namespace
+{
+
+constexpr size_t escapeTableSize = 256;
+
+// Second character of escape sequence, or zero in case character is printed as is.
+// Note, quote characters are handled separately, since only one kind of quote is escaped.
+constexpr std::array<char, escapeTableSize> CreateEscapeTable()
+{
+    std::array<char, escapeTableSize> table{};
+    table['\\'] = '\\';
+    table['\0'] = '0';
+    table['\a'] = 'a';
+    table['\b'] = 'b';
+    table['\f'] = 'f';
+    table['\n'] = 'n';
+    table['\r'] = 'r';
+    table['\t'] = 't';
+    table['\v'] = 'v';
+    return table;
+}
+
+constexpr std::array<char, escapeTableSize> escapeTable = CreateEscapeTable();
+
+// All escaped control characters are less or equal to '\r'.
+constexpr unsigned char maxEscapedControl = '\r';
+
+bool NeedEscape(char c, char quote)
+{
+    return static_cast<unsigned char>(c) <= maxEscapedControl || c == '\\' || c == quote;
+}
+
+// Find first character that could need escaping (scan could stop on control characters that are not
+// escaped, caller must check it by escape table).
+
+size_t ScalarFindSpecial(const char *str, size_t size, char quote)
+{
+    size_t i = 0;
+    while (i < size && !NeedEscape(str[i], quote))
+    {
+        ++i;
+    }
+    return i;
+}
+
+#if defined(__SSE2__)
+
+size_t Sse2FindSpecial(const char *str, size_t size, char quote)
+{
+    static constexpr size_t sse2Block = 16;
+    const __m128i maxControl = _mm_set1_epi8(static_cast<char>(maxEscapedControl));
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i quoteChar = _mm_set1_epi8(quote);
+    size_t i = 0;
+    for (; i + sse2Block <= size; i += sse2Block)
+    {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(str + i));
+        // Unsigned `v <= maxControl` is `min(v, maxControl) == v`.
+        const __m128i special = _mm_or_si128(_mm_cmpeq_epi8(_mm_min_epu8(v, maxControl), v),
+                                             _mm_or_si128(_mm_cmpeq_epi8(v, backslash), _mm_cmpeq_epi8(v, quoteChar)));
+        const int mask = _mm_movemask_epi8(special);
+        if (mask != 0)
+        {
+            return i + static_cast<size_t>(__builtin_ctz(static_cast<unsigned>(mask)));
+        }
+    }
+    return i + ScalarFindSpecial(str + i, size - i, quote);
+}
+
+#if defined(__AVX2__)
+
+size_t Avx2FindSpecial(const char *str, size_t size, char quote)
+{
+    static constexpr size_t avx2Block = 32;
+    const __m256i maxControl = _mm256_set1_epi8(static_cast<char>(maxEscapedControl));
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    const __m256i quoteChar = _mm256_set1_epi8(quote);
+    size_t i = 0;
+    for (; i + avx2Block <= size; i += avx2Block)
+    {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(str + i));
+        const __m256i special = _mm256_or_si256(_mm256_cmpeq_epi8(_mm256_min_epu8(v, maxControl), v),
+                                                _mm256_or_si256(_mm256_cmpeq_epi8(v, backslash), _mm256_cmpeq_epi8(v, quoteChar)));
+        const int mask = _mm256_movemask_epi8(special);
+        if (mask != 0)
+        {
+            return i + static_cast<size_t>(__builtin_ctz(static_cast<unsigned>(mask)));
+        }
+    }
+    return i + Sse2FindSpecial(str + i, size - i, quote);
+}
+
+#endif // __AVX2__
+#endif // __SSE2__
+
+size_t FindSpecial(const char *str, size_t size, char quote)
+{
+#if defined(__AVX2__)
+    return Avx2FindSpecial(str, size, quote);
+#elif defined(__SSE2__)
+    return Sse2FindSpecial(str, size, quote);
+#else
+    return ScalarFindSpecial(str, size, quote);
+#endif
+}
+
+} // unnamed namespace
+
 std::string PrintGUID(const GUID &guid)
 {
     std::ostringstream ss;
@@ -32,4 +145,79 @@ std::string PrintGUID(const GUID &guid)
     return ss.str();
 }
 
+std::string PrintAddress(uint64_t address)
+{
+    static constexpr int addrSize = 16;
+    std::ostringstream ss;
+    ss << "0x" << std::hex << std::setfill('0') << std::setw(addrSize) << address;
+    return ss.str();
+}
+
+std::string EscapeString(std::string_view str, char quote)
+{
+    std::string result;
+    // Reserve for usual case with few escaped characters, append() will grow buffer in case of need.
+    static constexpr size_t reserveDivider = 8;
+    result.reserve(str.size() + (str.size() / reserveDivider));
+
+    size_t start = 0; // Start of not yet copied run.
+    size_t i = 0;
+    while (true)
+    {
+        i += FindSpecial(str.data() + i, str.size() - i, quote);
+        if (i == str.size())
+        {
+            break;
+        }
+
+        const char c = str[i];
+        const char escaped = c == quote ? quote : escapeTable[static_cast<unsigned char>(c)];
+        if (escaped != 0)
+        {
+            result.append(str.data() + start, i - start);
+            result.push_back('\\');
+            result.push_back(escaped);
+            start = i + 1;
+        }
+        ++i;
+    }
+    result.append(str.data() + start, str.size() - start);
+
+    return result;
+}
+
+void AppendBase64(const uint8_t *data, size_t size, std::string &output)
+{
+    static constexpr char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+    const size_t start = output.size();
+    output.resize(start + ((size + 2) / 3) * 4);
+    char *out = &output[start];
+
+    size_t i = 0;
+    for (; i + 3 <= size; i += 3)
+    {
+        const uint32_t triple = (static_cast<uint32_t>(data[i]) << 16) |
+                                (static_cast<uint32_t>(data[i + 1]) << 8) |
+                                static_cast<uint32_t>(data[i + 2]);
+        *out++ = alphabet[(triple >> 18) & 0x3F];
+        *out++ = alphabet[(triple >> 12) & 0x3F];
+        *out++ = alphabet[(triple >> 6) & 0x3F];
+        *out++ = alphabet[triple & 0x3F];
+    }
+
+    if (i < size)
+    {
+        uint32_t triple = static_cast<uint32_t>(data[i]) << 16;
+        if (i + 1 < size)
+        {
+            triple |= static_cast<uint32_t>(data[i + 1]) << 8;
+        }
+        *out++ = alphabet[(triple >> 18) & 0x3F];
+        *out++ = alphabet[(triple >> 12) & 0x3F];
+        *out++ = i + 1 < size ? alphabet[(triple >> 6) & 0x3F] : '=';
+        *out++ = '=';
+    }
+}
+
 } // namespace dncdbg
@@ -10,13 +10,26 @@
 #else
 #include <wtypes.h>
 #endif
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <string_view>
 
 namespace dncdbg
 {
 
 std::string PrintGUID(const GUID &guid);
 
+// Print address as `0x` and 16 hex digits (DAP memory reference format).
+std::string PrintAddress(uint64_t address);
+
+// Add C# character escaping (same as MS vsdbg and MSVS C# debugger have) for string or char value,
+// `quote` is the only quote character that is escaped.
+std::string EscapeString(std::string_view str, char quote);
+
+// Append base64 (RFC 4648, with padding) encoded data to `output`.
+void AppendBase64(const uint8_t *data, size_t size, std::string &output);
+
 } // namespace dncdbg
 
 #endif // UTILS_PRINT_H
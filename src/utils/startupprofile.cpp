@@ -0,0 +1,267 @@
+// Copyright (c) 2026 Mikhail Kurinnoi
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "utils/startupprofile.h"
+#include "utils/logger.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <numeric>
+#include <sstream>
+#include <thread>
+#include <utility>
+
+namespace dncdbg
+{
+
+namespace
+{
+
+// Slowest modules count in delayed report.
+constexpr size_t reportModules = 10;
+
+StartupProfile::NowFunction nowFunction = nullptr;
+
+thread_local StartupProfile::ModuleScope *currentScope = nullptr;
+thread_local StartupProfile::PhaseTimer *currentTimer = nullptr;
+
+std::atomic<StartupProfile::Clock::rep> callbacksSuspended{0};
+
+std::mutex profileMutex;
+// Protected by profileMutex.
+StartupProfile::Clock::time_point startTime = StartupProfile::Clock::now();
+std::vector<StartupProfile::ModuleTimes> modulesTimes;
+
+struct DelayedReportState
+{
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::thread thread;
+    bool stop = false;
+};
+
+DelayedReportState &GetDelayedReportState()
+{
+    static DelayedReportState delayedReportState;
+    return delayedReportState;
+}
+
+std::chrono::microseconds ToMicroseconds(StartupProfile::Clock::duration duration)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(duration);
+}
+
+void WriteTime(std::ostream &out, std::chrono::microseconds time)
+{
+    out << time.count() / 1000 << '.' << (time.count() % 1000) / 100 << "ms";
+}
+
+// Write not zero phases, slowest first.
+void WritePhases(std::ostream &out, const StartupProfile::PhaseTimes &phases)
+{
+    std::array<size_t, StartupProfile::PhaseCount> order{};
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&phases](size_t a, size_t b) { return phases[a] > phases[b]; });
+
+    const char *separator = "";
+    for (const size_t i : order)
+    {
+        if (phases[i].count() == 0)
+        {
+            break;
+        }
+
+        out << separator << StartupProfile::GetName(static_cast<StartupProfile::Phase>(i)) << '=';
+        WriteTime(out, phases[i]);
+        separator = " ";
+    }
+}
+
+} // unnamed namespace
+
+StartupProfile::ModuleScope::ModuleScope()
+    : m_start(Now()),
+      m_prevScope(currentScope)
+{
+    currentScope = this;
+}
+
+StartupProfile::ModuleScope::~ModuleScope()
+{
+    currentScope = m_prevScope;
+
+    ModuleTimes moduleTimes;
+    moduleTimes.name = std::move(m_name);
+    moduleTimes.total = ToMicroseconds(Now() - m_start);
+    moduleTimes.phases = m_phases;
+
+    const std::scoped_lock<std::mutex> lock(profileMutex);
+    modulesTimes.emplace_back(std::move(moduleTimes));
+}
+
+StartupProfile::PhaseTimer::PhaseTimer(Phase phase)
+    : m_phase(phase),
+      m_start(Now()),
+      m_parentTimer(currentTimer)
+{
+    currentTimer = this;
+}
+
+StartupProfile::PhaseTimer::~PhaseTimer()
+{
+    currentTimer = m_parentTimer;
+
+    const Clock::duration duration = Now() - m_start;
+    if (m_parentTimer != nullptr)
+    {
+        m_parentTimer->m_nestedTime += duration;
+    }
+
+    if (currentScope != nullptr)
+    {
+        currentScope->m_phases[static_cast<size_t>(m_phase)] += ToMicroseconds(duration - m_nestedTime);
+    }
+}
+
+StartupProfile::Clock::time_point StartupProfile::Now()
+{
+    return nowFunction != nullptr ? nowFunction() : Clock::now();
+}
+
+void StartupProfile::SetNowFunction(NowFunction newNowFunction)
+{
+    nowFunction = newNowFunction;
+}
+
+void StartupProfile::AddCallbackTime(Clock::duration duration)
+{
+    callbacksSuspended.fetch_add(duration.count(), std::memory_order_relaxed);
+}
+
+void StartupProfile::Start(std::chrono::seconds reportDelay, std::function<void(const std::string &)> reportCallback)
+{
+    Stop();
+
+    {
+        const std::scoped_lock<std::mutex> lock(profileMutex);
+        startTime = Now();
+        modulesTimes.clear();
+        callbacksSuspended.store(0, std::memory_order_relaxed);
+    }
+
+    if (reportDelay.count() == 0)
+    {
+        return;
+    }
+
+    DelayedReportState &state = GetDelayedReportState();
+    state.stop = false;
+    state.thread = std::thread([&state, reportDelay, reportCallback = std::move(reportCallback)]()
+        {
+            {
+                std::unique_lock<std::mutex> lock(state.mutex);
+                if (state.cv.wait_for(lock, reportDelay, [&state]() { return state.stop; }))
+                {
+                    return;
+                }
+            }
+
+            Report report;
+            GetReport(report, reportModules);
+            std::ostringstream ss;
+            WriteReport(ss, report);
+            LOGI(log << ss.str());
+            if (reportCallback)
+            {
+                reportCallback(ss.str());
+            }
+        });
+}
+
+void StartupProfile::Stop()
+{
+    DelayedReportState &state = GetDelayedReportState();
+    if (!state.thread.joinable())
+    {
+        return;
+    }
+
+    {
+        const std::scoped_lock<std::mutex> lock(state.mutex);
+        state.stop = true;
+        state.cv.notify_one(); // notify_one with lock
+    }
+    state.thread.join();
+}
+
+void StartupProfile::GetReport(Report &report, size_t maxModules)
+{
+    report = Report();
+    {
+        const std::scoped_lock<std::mutex> lock(profileMutex);
+        report.elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(Now() - startTime);
+        report.modules = modulesTimes;
+    }
+    report.callbacksSuspended = ToMicroseconds(Clock::duration(callbacksSuspended.load(std::memory_order_relaxed)));
+    report.modulesCount = report.modules.size();
+
+    for (const ModuleTimes &moduleTimes : report.modules)
+    {
+        report.modulesTotal += moduleTimes.total;
+        for (size_t i = 0; i < PhaseCount; ++i)
+        {
+            report.phases[i] += moduleTimes.phases[i];
+        }
+    }
+
+    std::stable_sort(report.modules.begin(), report.modules.end(),
+                     [](const ModuleTimes &a, const ModuleTimes &b) { return a.total > b.total; });
+    if (report.modules.size() > maxModules)
+    {
+        report.modules.resize(maxModules);
+    }
+}
+
+void StartupProfile::WriteReport(std::ostream &out, const Report &report)
+{
+    out << "Startup profile (" << report.elapsed.count() << "ms since start): " << report.modulesCount
+        << " modules loaded in ";
+    WriteTime(out, report.modulesTotal);
+    out << ", callbacks suspended ";
+    WriteTime(out, report.callbacksSuspended);
+    out << "\n  phases: ";
+    WritePhases(out, report.phases);
+    out << '\n';
+
+    if (report.modules.empty())
+    {
+        return;
+    }
+
+    out << "  slowest modules:\n";
+    for (const ModuleTimes &moduleTimes : report.modules)
+    {
+        out << "    ";
+        WriteTime(out, moduleTimes.total);
+        out << ' ' << moduleTimes.name << ": ";
+        WritePhases(out, moduleTimes.phases);
+        out << '\n';
+    }
+}
+
+const char *StartupProfile::GetName(Phase phase)
+{
+    static const std::array<const char *, PhaseCount> names{
+        "pdbDiscovery",
+        "pdbIndexing",
+        "metadata",
+        "jmc",
+        "extensionMethods",
+        "breakpointBinding"
+    };
+    return names[static_cast<size_t>(phase)];
+}
+
+} // namespace dncdbg
@@ -0,0 +1,162 @@
+// Copyright (c) 2026 Mikhail Kurinnoi
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#ifndef UTILS_STARTUPPROFILE_H
+#define UTILS_STARTUPPROFILE_H
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace dncdbg
+{
+
+// StartupProfile collects time spent by debugger during debuggee startup: module load phases for each module and
+// total time debuggee was suspended by callbacks processing. Intended for "why startup is slow" investigation,
+// report could be requested by protocol or written with delay after `configurationDone`.
+//
+// Module phases are collected by thread local ModuleScope (one LoadModule callback), so code that is not aware
+// about current module (symbols reader, metadata) could use PhaseTimer without module passing.
+class StartupProfile
+{
+  public:
+
+    using Clock = std::chrono::steady_clock;
+    using NowFunction = Clock::time_point (*)();
+
+    // Note, `GetName()` must be updated in case of new entry.
+    enum class Phase : uint8_t
+    {
+        PDBDiscovery,      // Find and open PDB file (or embedded PDB).
+        PDBIndexing,       // Source files, methods ranges and async methods indexes creation.
+        Metadata,          // Module metadata setup (JIT flags, JMC status, module ID).
+        JMC,               // Disable JMC for types/methods by attributes.
+        ExtensionMethods,  // Evaluator's extension methods cache fill.
+        BreakpointBinding, // Resolve pending breakpoints in module.
+        Count // Must be last.
+    };
+
+    static constexpr size_t PhaseCount = static_cast<size_t>(Phase::Count);
+    using PhaseTimes = std::array<std::chrono::microseconds, PhaseCount>;
+
+    // Collect phases of one module load on current thread, result is stored into profile at scope destruction.
+    class ModuleScope
+    {
+      public:
+
+        ModuleScope();
+        ModuleScope(ModuleScope &&) = delete;
+        ModuleScope(const ModuleScope &) = delete;
+        ModuleScope &operator=(ModuleScope &&) = delete;
+        ModuleScope &operator=(const ModuleScope &) = delete;
+        ~ModuleScope();
+
+        // Note, module name is known only after metadata load.
+        void SetName(const std::string &name)
+        {
+            m_name = name;
+        }
+
+      private:
+
+        friend class StartupProfile;
+
+        std::string m_name;
+        Clock::time_point m_start;
+        PhaseTimes m_phases{};
+        ModuleScope *m_prevScope;
+    };
+
+    // Add time to phase of current module scope (if any). Time of nested timers is excluded, so each phase
+    // has only its own time (for example, PDB discovery time is not included into PDB indexing time).
+    class PhaseTimer
+    {
+      public:
+
+        explicit PhaseTimer(Phase phase);
+        PhaseTimer(PhaseTimer &&) = delete;
+        PhaseTimer(const PhaseTimer &) = delete;
+        PhaseTimer &operator=(PhaseTimer &&) = delete;
+        PhaseTimer &operator=(const PhaseTimer &) = delete;
+        ~PhaseTimer();
+
+      private:
+
+        Phase m_phase;
+        Clock::time_point m_start;
+        Clock::duration m_nestedTime{0};
+        PhaseTimer *m_parentTimer;
+    };
+
+    // Add time passed from object creation to destruction into callbacks suspended time.
+    class CallbackTimer
+    {
+      public:
+
+        CallbackTimer()
+            : m_start(Now())
+        {
+        }
+        CallbackTimer(CallbackTimer &&) = delete;
+        CallbackTimer(const CallbackTimer &) = delete;
+        CallbackTimer &operator=(CallbackTimer &&) = delete;
+        CallbackTimer &operator=(const CallbackTimer &) = delete;
+
+        ~CallbackTimer()
+        {
+            AddCallbackTime(Now() - m_start);
+        }
+
+      private:
+
+        Clock::time_point m_start;
+    };
+
+    struct ModuleTimes
+    {
+        std::string name;
+        std::chrono::microseconds total{0}; // Whole LoadModule callback time, include time not covered by phases.
+        PhaseTimes phases{};
+    };
+
+    struct Report
+    {
+        std::chrono::milliseconds elapsed{0}; // Time since Start() call (or process start).
+        // Debuggee suspended time by all callbacks, except evaluation related callbacks and stop events (user's pause).
+        std::chrono::microseconds callbacksSuspended{0};
+        std::chrono::microseconds modulesTotal{0};
+        size_t modulesCount = 0;
+        PhaseTimes phases{};
+        std::vector<ModuleTimes> modules; // Slowest modules first.
+    };
+
+    // Current time for all profile timers, `Clock::now()` by default.
+    static Clock::time_point Now();
+    // Replace time source (`nullptr` restores default one), intended for tests. Must be called while profile is not
+    // used by other threads.
+    static void SetNowFunction(NowFunction nowFunction);
+
+    static void AddCallbackTime(Clock::duration duration);
+
+    // Reset collected data, should be called before debuggee start (configurationDone). In case `reportDelay` is not
+    // zero, report is written into log and passed to `reportCallback` after delay.
+    static void Start(std::chrono::seconds reportDelay, std::function<void(const std::string &)> reportCallback);
+    // Cancel delayed report (if any).
+    static void Stop();
+
+    static void GetReport(Report &report, size_t maxModules = std::numeric_limits<size_t>::max());
+    static void WriteReport(std::ostream &out, const Report &report);
+
+    static const char *GetName(Phase phase);
+};
+
+} // namespace dncdbg
+
+#endif // UTILS_STARTUPPROFILE_H
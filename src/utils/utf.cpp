@@ -8,8 +8,11 @@
 #ifdef _WIN32
 #include <stringapiset.h>
 #else
-#include <iconv.h>
-#include <vector>
+#include <cstddef>
+#include <cstdint>
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
 #endif
 
 namespace dncdbg
@@ -20,70 +23,495 @@ namespace
 
 #ifdef FEATURE_PAL
 
-std::u16string utf8_to_utf16(const std::string &utf8_str)
+// Native UTF-8 <-> UTF-16 transcoding.
+//
+// Each conversion is done in two passes: first pass validates input and calculates exact output size,
+// second pass writes directly into the result string. ASCII runs are checked and converted by SIMD
+// kernels (SSE2 or AVX2 on x86-64), other characters are processed by scalar code.
+// Invalid input (lone surrogates, overlong or truncated UTF-8 sequences, code points above U+10FFFF)
+// produce empty result, the same as previous iconv() based implementation.
+
+constexpr char32_t maxCodePoint = 0x10FFFF;
+constexpr char16_t surrogateFirst = 0xD800;
+constexpr char16_t lowSurrogateFirst = 0xDC00;
+constexpr char16_t surrogateLast = 0xDFFF;
+constexpr char32_t supplementaryFirst = 0x10000;
+
+bool IsHighSurrogate(char16_t c)
 {
-#if BIGENDIAN
-    static const std::string toCode = "UTF-16BE";
-#else
-    static const std::string toCode = "UTF-16LE";
-#endif
-    iconv_t conv = iconv_open(toCode.c_str(), "UTF-8"); // Open converter from UTF-8 to UTF-16LE
-    // iconv_open returns -1 on error; compare as intptr_t to avoid int-to-ptr cast.
-    if (reinterpret_cast<intptr_t>(conv) == -1)
+    return c >= surrogateFirst && c < lowSurrogateFirst;
+}
+
+bool IsLowSurrogate(char16_t c)
+{
+    return c >= lowSurrogateFirst && c <= surrogateLast;
+}
+
+bool IsContinuation(unsigned char c)
+{
+    return (c & 0xC0) == 0x80;
+}
+
+// ASCII run kernels, all return number of processed leading ASCII characters.
+
+size_t ScalarPrefix16(const char16_t *src, size_t size)
+{
+    size_t i = 0;
+    while (i < size && src[i] < 0x80)
     {
-        return {};
+        ++i;
+    }
+    return i;
+}
+
+size_t ScalarPrefix8(const char *src, size_t size)
+{
+    size_t i = 0;
+    while (i < size && static_cast<unsigned char>(src[i]) < 0x80)
+    {
+        ++i;
     }
+    return i;
+}
 
-    size_t in_bytes = utf8_str.size();
-    char *in_buf = const_cast<char *>(utf8_str.c_str()); // NOLINT(cppcoreguidelines-pro-type-const-cast)
-    size_t out_bytes = (in_bytes * 2) + 2; // worst case UTF-16 is twice the size of UTF-8 in bytes
-    std::vector<char> out_buf(out_bytes);
-    char *out_ptr = out_buf.data();
-    const size_t original_out_bytes = out_bytes;
+size_t ScalarNarrow(const char16_t *src, size_t size, char *dst)
+{
+    size_t i = 0;
+    while (i < size && src[i] < 0x80)
+    {
+        dst[i] = static_cast<char>(src[i]);
+        ++i;
+    }
+    return i;
+}
 
-    if (iconv(conv, &in_buf, &in_bytes, &out_ptr, &out_bytes) == static_cast<size_t>(-1))
+size_t ScalarWiden(const char *src, size_t size, char16_t *dst)
+{
+    size_t i = 0;
+    while (i < size && static_cast<unsigned char>(src[i]) < 0x80)
     {
-        iconv_close(conv);
-        return {};
+        dst[i] = static_cast<char16_t>(src[i]);
+        ++i;
+    }
+    return i;
+}
+
+#if defined(__SSE2__)
+
+constexpr size_t sse2Block = 16;
+
+size_t Sse2Prefix16(const char16_t *src, size_t size)
+{
+    const __m128i mask = _mm_set1_epi16(static_cast<short>(0xFF80));
+    size_t i = 0;
+    for (; i + sse2Block <= size; i += sse2Block)
+    {
+        const __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        const __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i + (sse2Block / 2)));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(_mm_or_si128(v0, v1), mask), _mm_setzero_si128())) != 0xFFFF)
+        {
+            break;
+        }
+    }
+    return i + ScalarPrefix16(src + i, size - i);
+}
+
+size_t Sse2Prefix8(const char *src, size_t size)
+{
+    size_t i = 0;
+    for (; i + sse2Block <= size; i += sse2Block)
+    {
+        if (_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i))) != 0)
+        {
+            break;
+        }
+    }
+    return i + ScalarPrefix8(src + i, size - i);
+}
+
+size_t Sse2Narrow(const char16_t *src, size_t size, char *dst)
+{
+    const __m128i mask = _mm_set1_epi16(static_cast<short>(0xFF80));
+    size_t i = 0;
+    for (; i + sse2Block <= size; i += sse2Block)
+    {
+        const __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        const __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i + (sse2Block / 2)));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(_mm_or_si128(v0, v1), mask), _mm_setzero_si128())) != 0xFFFF)
+        {
+            break;
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_packus_epi16(v0, v1));
+    }
+    return i + ScalarNarrow(src + i, size - i, dst + i);
+}
+
+size_t Sse2Widen(const char *src, size_t size, char16_t *dst)
+{
+    size_t i = 0;
+    for (; i + sse2Block <= size; i += sse2Block)
+    {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        if (_mm_movemask_epi8(v) != 0)
+        {
+            break;
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_unpacklo_epi8(v, _mm_setzero_si128()));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i + (sse2Block / 2)), _mm_unpackhi_epi8(v, _mm_setzero_si128()));
+    }
+    return i + ScalarWiden(src + i, size - i, dst + i);
+}
+
+// Length of null-terminated string. Note, aligned loads never cross page boundary, but could read data
+// after terminator in the same block, so address sanitizer is disabled here.
+__attribute__((no_sanitize_address)) size_t Sse2Length16(const char16_t *str)
+{
+    static constexpr uintptr_t alignMask = sizeof(__m128i) - 1;
+    const char16_t *ptr = str;
+    while ((reinterpret_cast<uintptr_t>(ptr) & alignMask) != 0)
+    {
+        if (*ptr == 0)
+        {
+            return static_cast<size_t>(ptr - str);
+        }
+        ++ptr;
+    }
+
+    const __m128i zero = _mm_setzero_si128();
+    while (true)
+    {
+        const int mask = _mm_movemask_epi8(_mm_cmpeq_epi16(_mm_load_si128(reinterpret_cast<const __m128i *>(ptr)), zero));
+        if (mask != 0)
+        {
+            return static_cast<size_t>(ptr - str) + (static_cast<unsigned>(__builtin_ctz(static_cast<unsigned>(mask))) / sizeof(char16_t));
+        }
+        ptr += sizeof(__m128i) / sizeof(char16_t);
+    }
+}
+
+#if defined(__AVX2__)
+
+constexpr size_t avx2Block = 32;
+
+size_t Avx2Prefix16(const char16_t *src, size_t size)
+{
+    const __m256i mask = _mm256_set1_epi16(static_cast<short>(0xFF80));
+    size_t i = 0;
+    for (; i + avx2Block <= size; i += avx2Block)
+    {
+        const __m256i v0 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+        const __m256i v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i + (avx2Block / 2)));
+        if (_mm256_testz_si256(_mm256_or_si256(v0, v1), mask) == 0)
+        {
+            break;
+        }
+    }
+    return i + Sse2Prefix16(src + i, size - i);
+}
+
+size_t Avx2Prefix8(const char *src, size_t size)
+{
+    size_t i = 0;
+    for (; i + avx2Block <= size; i += avx2Block)
+    {
+        if (_mm256_movemask_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i))) != 0)
+        {
+            break;
+        }
     }
+    return i + Sse2Prefix8(src + i, size - i);
+}
+
+size_t Avx2Narrow(const char16_t *src, size_t size, char *dst)
+{
+    const __m256i mask = _mm256_set1_epi16(static_cast<short>(0xFF80));
+    size_t i = 0;
+    for (; i + avx2Block <= size; i += avx2Block)
+    {
+        const __m256i v0 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+        const __m256i v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i + (avx2Block / 2)));
+        if (_mm256_testz_si256(_mm256_or_si256(v0, v1), mask) == 0)
+        {
+            break;
+        }
+        // Pack works per 128-bit lane, restore order of 64-bit quarters.
+        const __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(v0, v1), 0xD8);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), packed);
+    }
+    return i + Sse2Narrow(src + i, size - i, dst + i);
+}
+
+size_t Avx2Widen(const char *src, size_t size, char16_t *dst)
+{
+    size_t i = 0;
+    for (; i + avx2Block <= size; i += avx2Block)
+    {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+        if (_mm256_movemask_epi8(v) != 0)
+        {
+            break;
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), _mm256_cvtepu8_epi16(_mm256_castsi256_si128(v)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i + (avx2Block / 2)), _mm256_cvtepu8_epi16(_mm256_extracti128_si256(v, 1)));
+    }
+    return i + Sse2Widen(src + i, size - i, dst + i);
+}
+
+#endif // __AVX2__
+#endif // __SSE2__
+
+// Note, AVX2 kernels are used only in case whole debugger is built for AVX2 (`-mavx2`), since runtime dispatch
+// into AVX2 code for short runs cost more than it save (SSE/AVX transition at each kernel call).
+#if defined(__AVX2__)
+#define ASCII_KERNEL(name) Avx2##name
+#elif defined(__SSE2__)
+#define ASCII_KERNEL(name) Sse2##name
+#else
+#define ASCII_KERNEL(name) Scalar##name
+#endif
 
-    iconv_close(conv);
+size_t AsciiPrefix16(const char16_t *src, size_t size)
+{
+    return ASCII_KERNEL(Prefix16)(src, size);
+}
 
-    const size_t u16_len = (original_out_bytes - out_bytes) / sizeof(char16_t);
-    return {reinterpret_cast<char16_t *>(out_buf.data()), u16_len};
+size_t AsciiPrefix8(const char *src, size_t size)
+{
+    return ASCII_KERNEL(Prefix8)(src, size);
 }
 
-std::string utf16_to_utf8(const std::u16string &utf16_str)
+size_t AsciiNarrow(const char16_t *src, size_t size, char *dst)
 {
-#if BIGENDIAN
-    static const std::string fromCode = "UTF-16BE";
+    return ASCII_KERNEL(Narrow)(src, size, dst);
+}
+
+size_t AsciiWiden(const char *src, size_t size, char16_t *dst)
+{
+    return ASCII_KERNEL(Widen)(src, size, dst);
+}
+
+#undef ASCII_KERNEL
+
+size_t Length16(const char16_t *str)
+{
+#if defined(__SSE2__)
+    return Sse2Length16(str);
 #else
-    static const std::string fromCode = "UTF-16LE";
+    return std::char_traits<char16_t>::length(str);
 #endif
-    iconv_t conv = iconv_open("UTF-8", fromCode.c_str()); // Open converter from UTF-16LE to UTF-8
-    // iconv_open returns -1 on error; compare as intptr_t to avoid int-to-ptr cast.
-    if (reinterpret_cast<intptr_t>(conv) == -1)
+}
+
+// Validate one non-ASCII UTF-8 sequence. Returns sequence length or 0 in case of invalid sequence.
+size_t ValidateUtf8Sequence(const unsigned char *src, size_t size)
+{
+    const unsigned char lead = src[0];
+    if (lead >= 0xC2 && lead <= 0xDF)
+    {
+        return (size >= 2 && IsContinuation(src[1])) ? 2 : 0;
+    }
+
+    if (lead >= 0xE0 && lead <= 0xEF)
+    {
+        if (size < 3 || !IsContinuation(src[1]) || !IsContinuation(src[2]) ||
+            (lead == 0xE0 && src[1] < 0xA0) || // overlong
+            (lead == 0xED && src[1] > 0x9F))   // surrogates
+        {
+            return 0;
+        }
+        return 3;
+    }
+
+    if (lead >= 0xF0 && lead <= 0xF4)
+    {
+        if (size < 4 || !IsContinuation(src[1]) || !IsContinuation(src[2]) || !IsContinuation(src[3]) ||
+            (lead == 0xF0 && src[1] < 0x90) || // overlong
+            (lead == 0xF4 && src[1] > 0x8F))   // above U+10FFFF
+        {
+            return 0;
+        }
+        return 4;
+    }
+
+    return 0; // continuation byte, overlong 2-byte lead or not used byte
+}
+
+// Validate UTF-8 and calculate UTF-16 length. Returns false in case of invalid input.
+bool Utf16Length(const char *src, size_t size, size_t &length)
+{
+    const auto *bytes = reinterpret_cast<const unsigned char *>(src);
+    length = 0;
+    size_t i = 0;
+    while (i < size)
+    {
+        if (bytes[i] < 0x80)
+        {
+            const size_t run = AsciiPrefix8(src + i, size - i);
+            i += run;
+            length += run;
+            continue;
+        }
+
+        const size_t sequence = ValidateUtf8Sequence(bytes + i, size - i);
+        if (sequence == 0)
+        {
+            return false;
+        }
+        i += sequence;
+        length += sequence == 4 ? 2 : 1;
+    }
+    return true;
+}
+
+// Validate UTF-16 and calculate UTF-8 length. Returns false in case of invalid input.
+bool Utf8Length(const char16_t *src, size_t size, size_t &length)
+{
+    length = 0;
+    size_t i = 0;
+    while (i < size)
+    {
+        const char16_t c = src[i];
+        if (c < 0x80)
+        {
+            const size_t run = AsciiPrefix16(src + i, size - i);
+            i += run;
+            length += run;
+        }
+        else if (c < 0x800)
+        {
+            length += 2;
+            ++i;
+        }
+        else if (IsHighSurrogate(c))
+        {
+            if (i + 1 >= size || !IsLowSurrogate(src[i + 1]))
+            {
+                return false;
+            }
+            length += 4;
+            i += 2;
+        }
+        else if (IsLowSurrogate(c))
+        {
+            return false;
+        }
+        else
+        {
+            length += 3;
+            ++i;
+        }
+    }
+    return true;
+}
+
+std::u16string utf8_to_utf16(const char *src, size_t size)
+{
+    size_t length = 0;
+    if (!Utf16Length(src, size, length))
     {
         return {};
     }
 
-    size_t in_bytes = utf16_str.size() * sizeof(char16_t);
-    char *in_buf = reinterpret_cast<char *>(const_cast<char16_t *>(utf16_str.c_str())); // NOLINT(cppcoreguidelines-pro-type-const-cast)
-    size_t out_bytes = (in_bytes * 2) + 2; // worst case UTF-8 is twice the size of UTF-16 in bytes
-    std::vector<char> out_buf(out_bytes);
-    char *out_ptr = out_buf.data();
-    const size_t original_out_bytes = out_bytes;
+    std::u16string result(length, u'\0');
+    char16_t *dst = result.data();
+    if (length == size)
+    {
+        // ASCII only.
+        AsciiWiden(src, size, dst);
+        return result;
+    }
 
-    if (iconv(conv, &in_buf, &in_bytes, &out_ptr, &out_bytes) == static_cast<size_t>(-1))
+    const auto *bytes = reinterpret_cast<const unsigned char *>(src);
+    size_t i = 0;
+    while (i < size)
+    {
+        if (bytes[i] < 0x80)
+        {
+            const size_t run = AsciiWiden(src + i, size - i, dst);
+            i += run;
+            dst += run;
+            continue;
+        }
+
+        // Sequence already validated.
+        const unsigned char lead = bytes[i];
+        if (lead < 0xE0)
+        {
+            *dst++ = static_cast<char16_t>(((lead & 0x1F) << 6) | (bytes[i + 1] & 0x3F));
+            i += 2;
+        }
+        else if (lead < 0xF0)
+        {
+            *dst++ = static_cast<char16_t>(((lead & 0x0F) << 12) | ((bytes[i + 1] & 0x3F) << 6) | (bytes[i + 2] & 0x3F));
+            i += 3;
+        }
+        else
+        {
+            const char32_t codePoint = (((lead & 0x07) << 18) | ((bytes[i + 1] & 0x3F) << 12) |
+                                        ((bytes[i + 2] & 0x3F) << 6) | (bytes[i + 3] & 0x3F)) - supplementaryFirst;
+            *dst++ = static_cast<char16_t>(surrogateFirst + (codePoint >> 10));
+            *dst++ = static_cast<char16_t>(lowSurrogateFirst + (codePoint & 0x3FF));
+            i += 4;
+        }
+    }
+    return result;
+}
+
+std::string utf16_to_utf8(const char16_t *src, size_t size)
+{
+    size_t length = 0;
+    if (!Utf8Length(src, size, length))
     {
-        iconv_close(conv);
         return {};
     }
 
-    iconv_close(conv);
+    std::string result(length, '\0');
+    char *dst = result.data();
+    if (length == size)
+    {
+        // ASCII only.
+        AsciiNarrow(src, size, dst);
+        return result;
+    }
+
+    size_t i = 0;
+    while (i < size)
+    {
+        char32_t c = src[i];
+        if (c < 0x80)
+        {
+            const size_t run = AsciiNarrow(src + i, size - i, dst);
+            i += run;
+            dst += run;
+            continue;
+        }
+
+        if (c < 0x800)
+        {
+            *dst++ = static_cast<char>(0xC0 | (c >> 6));
+            *dst++ = static_cast<char>(0x80 | (c & 0x3F));
+            ++i;
+            continue;
+        }
 
-    const size_t u8_len = (original_out_bytes - out_bytes) / sizeof(char);
-    return {out_buf.data(), u8_len};
+        if (IsHighSurrogate(static_cast<char16_t>(c)))
+        {
+            // Surrogate pair already validated.
+            c = supplementaryFirst + ((c - surrogateFirst) << 10) + (src[i + 1] - lowSurrogateFirst);
+            static_assert(maxCodePoint == supplementaryFirst + 0xFFFFF);
+            *dst++ = static_cast<char>(0xF0 | (c >> 18));
+            *dst++ = static_cast<char>(0x80 | ((c >> 12) & 0x3F));
+            *dst++ = static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+            *dst++ = static_cast<char>(0x80 | (c & 0x3F));
+            i += 2;
+            continue;
+        }
+
+        *dst++ = static_cast<char>(0xE0 | (c >> 12));
+        *dst++ = static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+        *dst++ = static_cast<char>(0x80 | (c & 0x3F));
+        ++i;
+    }
+    return result;
 }
 
 #endif // FEATURE_PAL
@@ -99,7 +527,7 @@ std::string to_utf8(const WCHAR *wstr_)
     WideCharToMultiByte(CP_UTF8, 0, wstr.c_str(), -1, str.data(), count, nullptr, nullptr);
     return str;
 #else
-    return utf16_to_utf8(wstr_);
+    return utf16_to_utf8(wstr_, Length16(wstr_));
 #endif
 }
 
@@ -111,7 +539,7 @@ WSTRING to_utf16(const std::string &utf8)
     MultiByteToWideChar(CP_UTF8, 0, utf8.c_str(), static_cast<int>(utf8.length()), wstr.data(), count);
     return wstr;
 #else
-    return utf8_to_utf16(utf8);
+    return utf8_to_utf16(utf8.data(), utf8.size());
 #endif
 }
 
@@ -10,6 +10,7 @@ public class ControlInfo
     public string? SourceFilesPath { get; private set; }
     public string? TargetAssemblyPath { get; private set; }
     public string CorerunPath { get; private set; }
+    public string? DebuggerPath { get; private set; }
 
     public ControlInfo(ControlScript script, DbgTestCore.Environment env)
     {
@@ -18,6 +19,7 @@ public class ControlInfo
         SourceFilesPath = env.SourceFilesPath;
         TargetAssemblyPath = env.TargetAssemblyPath;
         CorerunPath = env.CorerunPath;
+        DebuggerPath = env.DebuggerPath;
     }
 }
 }
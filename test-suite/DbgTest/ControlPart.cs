@@ -18,5 +18,6 @@ public class Environment
     public string? SourceFilesPath { get; set; }
     public string? TargetAssemblyPath { get; set; }
     public string CorerunPath { get; set; } = "dotnet";
+    public string? DebuggerPath { get; set; }
 }
 }
@@ -34,6 +34,7 @@ public class InitializeRequestArguments
     public bool? supportsVariableType;
     public bool? supportsVariablePaging;
     public bool? supportsRunInTerminalRequest;
+    public bool? supportsMemoryReferences;
 }
 
 public class LaunchRequest : Request
@@ -62,6 +63,8 @@ public class LaunchRequestArguments
     public string internalConsoleOptions = string.Empty;
     public string __sessionId = string.Empty;
     public ExpressionEvaluationOptions? expressionEvaluationOptions;
+    public Dictionary<string, object>? commandTimeouts;
+    public UInt64? symbolsIndexesBudget;
 }
 
 public class ExpressionEvaluationOptions
@@ -462,4 +465,71 @@ public class ModulesArguments
     public int? startModule;
     public int? moduleCount;
 }
+
+public class ReadMemoryRequest : Request
+{
+    public ReadMemoryRequest()
+    {
+        command = "readMemory";
+    }
+    public ReadMemoryArguments arguments = new ReadMemoryArguments();
+}
+
+public class ReadMemoryArguments
+{
+    public string memoryReference = string.Empty;
+    public Int64? offset;
+    public Int64 count;
+}
+
+public class MetricsRequest : Request
+{
+    public MetricsRequest()
+    {
+        command = "metrics";
+    }
+    public MetricsArguments arguments = new MetricsArguments();
+}
+
+public class MetricsArguments
+{
+    public bool? reset;
+}
+
+public class StartupProfileRequest : Request
+{
+    public StartupProfileRequest()
+    {
+        command = "startupProfile";
+    }
+    public StartupProfileArguments arguments = new StartupProfileArguments();
+}
+
+public class StartupProfileArguments
+{
+    public int? maxModules;
+}
+
+public class SymbolsMemoryRequest : Request
+{
+    public SymbolsMemoryRequest()
+    {
+        command = "symbolsMemory";
+    }
+}
+
+public class AllocationProfileRequest : Request
+{
+    public AllocationProfileRequest()
+    {
+        command = "allocationProfile";
+    }
+    public AllocationProfileArguments arguments = new AllocationProfileArguments();
+}
+
+public class AllocationProfileArguments
+{
+    public bool? reset;
+    public int? maxTags;
+}
 }
@@ -95,6 +95,7 @@ public class Variable
     public int variablesReference;
     public int? namedVariables;
     public int? indexedVariables;
+    public string? memoryReference;
 }
 
 public class VariablePresentationHint
@@ -117,6 +118,7 @@ public class EvaluateResponseBody
     public int variablesReference;
     public int? namedVariables;
     public int? indexedVariables;
+    public string? memoryReference;
 }
 
 public class SetVariableResponse : Response
@@ -229,4 +231,112 @@ public class ModulesResponseBody
     public List<Module> modules = new();
     public int? totalModules = null;
 }
+
+public class ReadMemoryResponse : Response
+{
+    public ReadMemoryResponseBody body = new();
+}
+
+public class ReadMemoryResponseBody
+{
+    public string address = string.Empty;
+    public int? unreadableBytes;
+    public string? data;
+}
+
+public class MetricsResponse : Response
+{
+    public MetricsResponseBody body = new();
+}
+
+public class MetricsResponseBody
+{
+    public Int64 elapsed;
+    public Dictionary<string, Int64> counters = new();
+    public Dictionary<string, MetricsHistogram> histograms = new();
+}
+
+public class MetricsHistogram
+{
+    public UInt64 count;
+    public UInt64 sum;
+    public UInt64 p50;
+    public UInt64 p90;
+    public UInt64 p99;
+    public UInt64 max;
+    // Pairs of bucket upper bound and values count, non empty buckets only.
+    public List<List<UInt64>> buckets = new();
+}
+
+public class StartupProfileResponse : Response
+{
+    public StartupProfileResponseBody body = new();
+}
+
+public class StartupProfileResponseBody
+{
+    public Int64 elapsed;
+    public Int64 callbacksSuspendedUs;
+    public Int64 modulesTotalUs;
+    public int modulesCount;
+    public Dictionary<string, Int64> phasesUs = new();
+    public List<StartupProfileModule> modules = new();
+}
+
+public class StartupProfileModule
+{
+    public string name = string.Empty;
+    public Int64 totalUs;
+    public Dictionary<string, Int64> phasesUs = new();
+}
+
+public class SymbolsMemoryResponse : Response
+{
+    public SymbolsMemoryResponseBody body = new();
+}
+
+public class SymbolsMemoryResponseBody
+{
+    public UInt64 pdbDataSize;
+    public UInt64 sourceNamesSize;
+    public UInt64 indexesSize;
+    // Most recently used modules first.
+    public List<SymbolsMemoryModule> modules = new();
+}
+
+public class SymbolsMemoryModule
+{
+    public string address = string.Empty;
+    public string symbolFilePath = string.Empty;
+    public UInt64 pdbDataSize;
+    public UInt64 sourceNamesSize;
+    public UInt64 indexesSize;
+    public bool indexesEvicted;
+}
+
+public class AllocationProfileResponse : Response
+{
+    public AllocationProfileResponseBody body = new();
+}
+
+public class AllocationProfileResponseBody
+{
+    public bool enabled;
+    public Int64 elapsed;
+    public UInt64 allocations;
+    public UInt64 bytes;
+    public UInt64 untaggedAllocations;
+    public UInt64 untaggedBytes;
+    // Most allocated bytes first.
+    public List<AllocationProfileTag> requests = new();
+    public List<AllocationProfileTag> callbacks = new();
+}
+
+public class AllocationProfileTag
+{
+    public string? command;
+    public string? callback;
+    public UInt64 allocations;
+    public UInt64 bytes;
+}
 }
@@ -1,6 +1,7 @@
 using System;
 using System.IO;
 using System.Net;
+using System.Net.Sockets;
 using System.Collections.Generic;
 using System.Diagnostics;
 
@@ -31,6 +32,11 @@ class Program
             return 1;
         }
 
+        if (cli.Server)
+        {
+            return RunServer((LocalClientInfo)cli.ClientInfo, cli.Environment);
+        }
+
         try
         {
             var localClientInfo = (LocalClientInfo)cli.ClientInfo;
@@ -99,6 +105,99 @@ class Program
         }
         return 0;
     }
+
+    // Server mode, debugger listen on local TCP port and test script is run by successive
+    // sessions over the same debugger process.
+    static int RunServer(LocalClientInfo clientInfo, DbgTestCore.Environment environment)
+    {
+        const int SessionsCount = 2;
+
+        var portListener = new TcpListener(IPAddress.Loopback, 0);
+        portListener.Start();
+        int port = ((IPEndPoint)portListener.LocalEndpoint).Port;
+        portListener.Stop();
+
+        ControlScript script;
+        try
+        {
+            script = new ControlScript(environment.SourceFilesPath!);
+        }
+        catch (ScriptNotBuiltException e)
+        {
+            Console.Error.WriteLine("Script is not built:");
+            Console.Error.WriteLine(e.ToString());
+            return 1;
+        }
+
+        var localDebugger = new LocalDebuggerProcess(clientInfo.DebuggerPath, "--server=" + port);
+        try
+        {
+            localDebugger.Start();
+        }
+        catch
+        {
+            Console.Error.WriteLine("Can't start debugger");
+            return 1;
+        }
+
+        for (int session = 1; session <= SessionsCount; session++)
+        {
+            TcpClient? client = ConnectServer(port, 5000);
+            if (client is null)
+            {
+                Console.Error.WriteLine("Can't connect to debugger server, session {0}", session);
+                localDebugger.Close();
+                return 1;
+            }
+
+            NetworkStream stream = client.GetStream();
+            var debugger = new DAPLocalDebuggerClient(new StreamWriter(stream), new StreamReader(stream));
+            try
+            {
+                ControlPart.Run(script, debugger, environment);
+            }
+            catch (System.Exception e)
+            {
+                Console.Error.WriteLine("Script running is failed in session {0}. Got exception:\n" + e.ToString(), session);
+                debugger.Close();
+                client.Close();
+                localDebugger.Close();
+                return 1;
+            }
+
+            // Debugger must finish session on connection close and accept next client.
+            debugger.Close();
+            client.Close();
+        }
+
+        Console.WriteLine("Success: Test case \"{0}\" is passed!!!", environment.TestName);
+        localDebugger.Close();
+        return 0;
+    }
+
+    static TcpClient? ConnectServer(int port, int timeout)
+    {
+        var stopwatch = Stopwatch.StartNew();
+        while (true)
+        {
+            var client = new TcpClient();
+            try
+            {
+                client.Connect(IPAddress.Loopback, port);
+                client.NoDelay = true;
+                return client;
+            }
+            catch (SocketException)
+            {
+                client.Dispose();
+                if (stopwatch.ElapsedMilliseconds > timeout)
+                {
+                    return null;
+                }
+                System.Threading.Thread.Sleep(100);
+            }
+        }
+    }
 }
 
 class CLInterface
@@ -135,6 +234,7 @@ class CLInterface
                 {
                     string debuggerPath = Path.GetFullPath(args[i + 1]);
                     ClientInfo = new LocalClientInfo(debuggerPath);
+                    Environment.DebuggerPath = debuggerPath;
                 }
                 catch
                 {
@@ -200,6 +300,11 @@ class CLInterface
 
                 i += 2;
 
+                break;
+            case "--server":
+                Server = true;
+                i += 1;
+
                 break;
             case "--dotnet":
                 if (i + 1 >= args.Length)
@@ -249,12 +354,14 @@ options:
     --test name             Test name
     --sources path[;path]   Semicolon separated paths to source files
     --assembly path         Path to target assambly file
+    --server                Run debugger in server mode (local TCP port), test is run by 2 successive sessions
 
 
     ");
     }
 
     public bool NeedHelp { get; } = false;
+    public bool Server { get; } = false;
     public DbgTestCore.Environment Environment { get; }
     public LocalClientInfo? ClientInfo { get; private set; }
 }
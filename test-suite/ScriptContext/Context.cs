@@ -28,10 +28,23 @@ class Context
         initializeRequest.arguments.supportsVariablePaging = true;
         initializeRequest.arguments.supportsRunInTerminalRequest = true;
         initializeRequest.arguments.locale = "en-us";
+        initializeRequest.arguments.supportsMemoryReferences = supportsMemoryReferences;
         Assert.True(DAPDebugger.Request(initializeRequest).Success, @"__FILE__:__LINE__" + "\n" + caller_trace);
     }
 
     public void Launch(bool? JMC, bool? StepFiltering, bool RemoteConsole, int RemoteConsolePort, string caller_trace)
+    {
+        LaunchRequest launchRequest = CreateLaunchRequest(JMC, StepFiltering, RemoteConsole, RemoteConsolePort);
+        Assert.True(DAPDebugger.Request(launchRequest).Success, @"__FILE__:__LINE__" + "\n" + caller_trace);
+    }
+
+    public void LaunchWithStatusOnlyCheck(string caller_trace, bool expectedStatus)
+    {
+        LaunchRequest launchRequest = CreateLaunchRequest(JMC: null, StepFiltering: null, RemoteConsole: false, RemoteConsolePort: 0);
+        Assert.Equal(expectedStatus, DAPDebugger.Request(launchRequest).Success, @"__FILE__:__LINE__" + "\n" + caller_trace);
+    }
+
+    LaunchRequest CreateLaunchRequest(bool? JMC, bool? StepFiltering, bool RemoteConsole, int RemoteConsolePort)
     {
         LaunchRequest launchRequest = new LaunchRequest();
         launchRequest.arguments.name = ".NET Core Launch (console) with pipeline";
@@ -76,9 +89,12 @@ class Context
             launchRequest.arguments.expressionEvaluationOptions = expressionEvaluationOptions;
         }
 
+        launchRequest.arguments.commandTimeouts = commandTimeouts;
+        launchRequest.arguments.symbolsIndexesBudget = symbolsIndexesBudget;
+
         launchRequest.arguments.internalConsoleOptions = "openOnSessionStart";
         launchRequest.arguments.__sessionId = Guid.NewGuid().ToString();
-        Assert.True(DAPDebugger.Request(launchRequest).Success, @"__FILE__:__LINE__" + "\n" + caller_trace);
+        return launchRequest;
     }
 
     public void LaunchWithEnv(string caller_trace)
@@ -921,6 +937,99 @@ class Context
         Assert.True(evaluateResponse.message!.StartsWith(errMsgStart), @"__FILE__:__LINE__" + "\n" + caller_trace);
     }
 
+    public string? GetMemoryReference(string caller_trace, Int64 frameId, string Expression)
+    {
+        EvaluateRequest evaluateRequest = new EvaluateRequest();
+        evaluateRequest.arguments.expression = Expression;
+        evaluateRequest.arguments.frameId = frameId;
+        var ret = DAPDebugger.Request(evaluateRequest);
+        Assert.True(ret.Success, @"__FILE__:__LINE__" + "\n" + caller_trace);
+
+        EvaluateResponse evaluateResponse = JsonConvert.DeserializeObject<EvaluateResponse>(ret.ResponseStr)!;
+        return evaluateResponse.body.memoryReference;
+    }
+
+    public ReadMemoryResponseBody ReadMemory(string caller_trace, string memoryReference, Int64 offset, Int64 count)
+    {
+        ReadMemoryRequest readMemoryRequest = new ReadMemoryRequest();
+        readMemoryRequest.arguments.memoryReference = memoryReference;
+        readMemoryRequest.arguments.offset = offset;
+        readMemoryRequest.arguments.count = count;
+        var ret = DAPDebugger.Request(readMemoryRequest);
+        Assert.True(ret.Success, @"__FILE__:__LINE__" + "\n" + caller_trace);
+
+        return JsonConvert.DeserializeObject<ReadMemoryResponse>(ret.ResponseStr)!.body;
+    }
+
+    public void ErrorReadMemory(string caller_trace, string memoryReference, Int64 count)
+    {
+        ReadMemoryRequest readMemoryRequest = new ReadMemoryRequest();
+        readMemoryRequest.arguments.memoryReference = memoryReference;
+        readMemoryRequest.arguments.count = count;
+        Assert.False(DAPDebugger.Request(readMemoryRequest).Success, @"__FILE__:__LINE__" + "\n" + caller_trace);
+    }
+
+    public MetricsResponseBody GetMetrics(string caller_trace, bool reset)
+    {
+        MetricsRequest metricsRequest = new MetricsRequest();
+        metricsRequest.arguments.reset = reset;
+        var ret = DAPDebugger.Request(metricsRequest);
+        Assert.True(ret.Success, @"__FILE__:__LINE__" + "\n" + caller_trace);
+
+        return JsonConvert.DeserializeObject<MetricsResponse>(ret.ResponseStr)!.body;
+    }
+
+    public StartupProfileResponseBody GetStartupProfile(string caller_trace, int? maxModules)
+    {
+        StartupProfileRequest startupProfileRequest = new StartupProfileRequest();
+        startupProfileRequest.arguments.maxModules = maxModules;
+        var ret = DAPDebugger.Request(startupProfileRequest);
+        Assert.True(ret.Success, @"__FILE__:__LINE__" + "\n" + caller_trace);
+
+        return JsonConvert.DeserializeObject<StartupProfileResponse>(ret.ResponseStr)!.body;
+    }
+
+    public SymbolsMemoryResponseBody GetSymbolsMemory(string caller_trace)
+    {
+        SymbolsMemoryRequest symbolsMemoryRequest = new SymbolsMemoryRequest();
+        var ret = DAPDebugger.Request(symbolsMemoryRequest);
+        Assert.True(ret.Success, @"__FILE__:__LINE__" + "\n" + caller_trace);
+
+        return JsonConvert.DeserializeObject<SymbolsMemoryResponse>(ret.ResponseStr)!.body;
+    }
+
+    public AllocationProfileResponseBody GetAllocationProfile(string caller_trace, bool reset, int? maxTags)
+    {
+        AllocationProfileRequest allocationProfileRequest = new AllocationProfileRequest();
+        allocationProfileRequest.arguments.reset = reset;
+        allocationProfileRequest.arguments.maxTags = maxTags;
+        var ret = DAPDebugger.Request(allocationProfileRequest);
+        Assert.True(ret.Success, @"__FILE__:__LINE__" + "\n" + caller_trace);
+
+        return JsonConvert.DeserializeObject<AllocationProfileResponse>(ret.ResponseStr)!.body;
+    }
+
+    // Run separate debugger process with command line arguments only (no DAP session), check exit code.
+    public void CheckDebuggerArguments(string caller_trace, string arguments, bool success)
+    {
+        Process debuggerProcess = new Process();
+        debuggerProcess.StartInfo.UseShellExecute = false;
+        debuggerProcess.StartInfo.FileName = ControlInfo.DebuggerPath;
+        debuggerProcess.StartInfo.Arguments = arguments;
+        debuggerProcess.StartInfo.RedirectStandardInput = true;
+        debuggerProcess.StartInfo.RedirectStandardOutput = true;
+        debuggerProcess.StartInfo.RedirectStandardError = true;
+        Assert.True(debuggerProcess.Start(), @"__FILE__:__LINE__" + "\n" + caller_trace);
+
+        bool exited = debuggerProcess.WaitForExit(5000);
+        if (!exited)
+        {
+            debuggerProcess.Kill(true);
+        }
+        Assert.True(exited, @"__FILE__:__LINE__" + "\n" + caller_trace);
+        Assert.Equal(success, debuggerProcess.ExitCode == 0, @"__FILE__:__LINE__" + "\n" + caller_trace);
+    }
+
     public void SetExpression(string caller_trace, Int64 frameId, string Expression, string Value)
     {
         SetExpressionRequest setExpressionRequest = new SetExpressionRequest();
@@ -1356,5 +1465,8 @@ class Context
     Dictionary<string, string> sourceFileMap = new Dictionary<string, string>();
     List<string> argsList = new List<string>();
     public ExpressionEvaluationOptions? expressionEvaluationOptions = null;
+    public Dictionary<string, object>? commandTimeouts = null;
+    public UInt64? symbolsIndexesBudget = null;
+    public bool? supportsMemoryReferences = null;
 }
 }
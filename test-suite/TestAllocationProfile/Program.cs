@@ -0,0 +1,85 @@
+using System;
+using System.IO;
+using System.Collections.Generic;
+using System.Diagnostics;
+
+using DbgTest;
+using DbgTest.DAP;
+using DbgTest.Script;
+
+namespace TestAllocationProfile
+{
+class Program
+{
+    static void Main(string[] args)
+    {
+        Label.Checkpoint("init", "bp_test",
+            (Object context) =>
+            {
+                Context Context = (Context)context;
+                Context.Initialize(@"__FILE__:__LINE__");
+                Context.Launch(JMC: null, StepFiltering: null, RemoteConsole: false, RemoteConsolePort: 0, @"__FILE__:__LINE__");
+                Context.AddBreakpoint(@"__FILE__:__LINE__", "bp1");
+                Context.SetBreakpoints(@"__FILE__:__LINE__");
+                Context.ConfigurationDone(@"__FILE__:__LINE__");
+
+                Context.WasEntryPointHit(@"__FILE__:__LINE__");
+                Context.Continue(@"__FILE__:__LINE__");
+            });
+
+        int value = 42;
+        ;                                                       Label.Breakpoint("bp1");
+        Console.WriteLine("Hello world! " + value);
+
+        Label.Checkpoint("bp_test", "finish",
+            (Object context) =>
+            {
+                Context Context = (Context)context;
+                Context.WasBreakpointHit(@"__FILE__:__LINE__", "bp1");
+
+                AllocationProfileResponseBody profile = Context.GetAllocationProfile(@"__FILE__:__LINE__", false, null);
+                if (!profile.enabled)
+                {
+                    // Debugger was built without allocation profiling (`-DALLOCATION_PROFILE=1`), request must still work.
+                    Assert.Equal(0UL, profile.allocations, @"__FILE__:__LINE__");
+                    Assert.Equal(0UL, profile.bytes, @"__FILE__:__LINE__");
+                    Assert.Equal(0, profile.requests.Count, @"__FILE__:__LINE__");
+                    Assert.Equal(0, profile.callbacks.Count, @"__FILE__:__LINE__");
+                }
+                else
+                {
+                    Assert.True(profile.allocations > 0, @"__FILE__:__LINE__");
+                    Assert.True(profile.bytes > 0, @"__FILE__:__LINE__");
+                    Assert.NotNull(profile.requests.Find(tag => tag.command == "stackTrace"), @"__FILE__:__LINE__");
+                    Assert.NotNull(profile.callbacks.Find(tag => tag.callback == "LoadModule"), @"__FILE__:__LINE__");
+                    Assert.NotNull(profile.callbacks.Find(tag => tag.callback == "Breakpoint"), @"__FILE__:__LINE__");
+                    for (int i = 1; i < profile.requests.Count; i++)
+                    {
+                        Assert.True(profile.requests[i - 1].bytes >= profile.requests[i].bytes, @"__FILE__:__LINE__");
+                    }
+
+                    // Reset start new measurement period, only allocations after reset are reported.
+                    Context.GetAllocationProfile(@"__FILE__:__LINE__", true, null);
+                    Int64 frameId = Context.DetectFrameId(@"__FILE__:__LINE__", "bp1");
+                    Context.GetAndCheckValue(@"__FILE__:__LINE__", frameId, "42", "int", "value");
+                    profile = Context.GetAllocationProfile(@"__FILE__:__LINE__", false, null);
+                    Assert.NotNull(profile.requests.Find(tag => tag.command == "evaluate"), @"__FILE__:__LINE__");
+                    Assert.True(profile.callbacks.Find(tag => tag.callback == "LoadModule") is null, @"__FILE__:__LINE__");
+
+                    profile = Context.GetAllocationProfile(@"__FILE__:__LINE__", false, 1);
+                    Assert.True(profile.requests.Count + profile.callbacks.Count <= 1, @"__FILE__:__LINE__");
+                }
+
+                Context.Continue(@"__FILE__:__LINE__");
+            });
+
+        Label.Checkpoint("finish", "",
+            (Object context) =>
+            {
+                Context Context = (Context)context;
+                Context.WasExit(0, @"__FILE__:__LINE__");
+                Context.DebuggerExit(@"__FILE__:__LINE__");
+            });
+    }
+}
+}
@@ -0,0 +1,75 @@
+using System;
+using System.IO;
+using System.Collections.Generic;
+using System.Diagnostics;
+
+using DbgTest;
+using DbgTest.DAP;
+using DbgTest.Script;
+
+namespace TestCommandTimeouts
+{
+class Program
+{
+    static int LongCall()
+    {
+        System.Threading.Thread.Sleep(30000);
+        return 1;
+    }
+
+    static void Main(string[] args)
+    {
+        Label.Checkpoint("init", "bp_test",
+            (Object context) =>
+            {
+                Context Context = (Context)context;
+                Context.Initialize(@"__FILE__:__LINE__");
+
+                // Wrong timeouts must be rejected.
+                Context.commandTimeouts = new Dictionary<string, object> { { "evaluate", -1 } };
+                Context.LaunchWithStatusOnlyCheck(@"__FILE__:__LINE__", false);
+                Context.commandTimeouts = new Dictionary<string, object> { { "default", 1.5 } };
+                Context.LaunchWithStatusOnlyCheck(@"__FILE__:__LINE__", false);
+                Context.commandTimeouts = new Dictionary<string, object> { { "default", "1000" } };
+                Context.LaunchWithStatusOnlyCheck(@"__FILE__:__LINE__", false);
+                Context.commandTimeouts = new Dictionary<string, object> { { "evaluate", 4294967296 } };
+                Context.LaunchWithStatusOnlyCheck(@"__FILE__:__LINE__", false);
+
+                Context.commandTimeouts = new Dictionary<string, object> { { "default", 0 }, { "evaluate", 1000 } };
+                Context.Launch(JMC: null, StepFiltering: null, RemoteConsole: false, RemoteConsolePort: 0, @"__FILE__:__LINE__");
+                Context.AddBreakpoint(@"__FILE__:__LINE__", "bp1");
+                Context.SetBreakpoints(@"__FILE__:__LINE__");
+                Context.ConfigurationDone(@"__FILE__:__LINE__");
+
+                Context.WasEntryPointHit(@"__FILE__:__LINE__");
+                Context.Continue(@"__FILE__:__LINE__");
+            });
+
+        int value = 42;
+        ;                                                       Label.Breakpoint("bp1");
+        Console.WriteLine("Hello world! " + value);
+
+        Label.Checkpoint("bp_test", "finish",
+            (Object context) =>
+            {
+                Context Context = (Context)context;
+                Context.WasBreakpointHit(@"__FILE__:__LINE__", "bp1");
+
+                Int64 frameId = Context.DetectFrameId(@"__FILE__:__LINE__", "bp1");
+                Context.CheckErrorAtRequest(@"__FILE__:__LINE__", frameId, "LongCall()", "Command execution timed out.");
+                // Debugger must be usable after canceled command.
+                Context.GetAndCheckValue(@"__FILE__:__LINE__", frameId, "42", "int", "value");
+
+                Context.Continue(@"__FILE__:__LINE__");
+            });
+
+        Label.Checkpoint("finish", "",
+            (Object context) =>
+            {
+                Context Context = (Context)context;
+                Context.WasExit(0, @"__FILE__:__LINE__");
+                Context.DebuggerExit(@"__FILE__:__LINE__");
+            });
+    }
+}
+}
@@ -0,0 +1,81 @@
+using System;
+using System.IO;
+using System.Collections.Generic;
+using System.Diagnostics;
+
+using DbgTest;
+using DbgTest.DAP;
+using DbgTest.Script;
+
+namespace TestMetrics
+{
+class Program
+{
+    static void Main(string[] args)
+    {
+        Label.Checkpoint("init", "bp_test",
+            (Object context) =>
+            {
+                Context Context = (Context)context;
+
+                // Metrics interval must be parsed as whole number of seconds.
+                Context.CheckDebuggerArguments(@"__FILE__:__LINE__", "--metricsInterval=1 --version", true);
+                Context.CheckDebuggerArguments(@"__FILE__:__LINE__", "--metricsInterval=0 --version", true);
+                Context.CheckDebuggerArguments(@"__FILE__:__LINE__", "--metricsInterval= --version", false);
+                Context.CheckDebuggerArguments(@"__FILE__:__LINE__", "--metricsInterval=-1 --version", false);
+                Context.CheckDebuggerArguments(@"__FILE__:__LINE__", "--metricsInterval=1s --version", false);
+                Context.CheckDebuggerArguments(@"__FILE__:__LINE__", "--metricsInterval=0x10 --version", false);
+                Context.CheckDebuggerArguments(@"__FILE__:__LINE__", "--metricsInterval=4294967296 --version", false);
+
+                Context.Initialize(@"__FILE__:__LINE__");
+                Context.Launch(JMC: null, StepFiltering: null, RemoteConsole: false, RemoteConsolePort: 0, @"__FILE__:__LINE__");
+                Context.AddBreakpoint(@"__FILE__:__LINE__", "bp1");
+                Context.SetBreakpoints(@"__FILE__:__LINE__");
+                Context.ConfigurationDone(@"__FILE__:__LINE__");
+
+                Context.WasEntryPointHit(@"__FILE__:__LINE__");
+                Context.Continue(@"__FILE__:__LINE__");
+            });
+
+        int value = 42;
+        ;                                                       Label.Breakpoint("bp1");
+        Console.WriteLine("Hello world! " + value);
+
+        Label.Checkpoint("bp_test", "finish",
+            (Object context) =>
+            {
+                Context Context = (Context)context;
+                Context.WasBreakpointHit(@"__FILE__:__LINE__", "bp1");
+
+                MetricsResponseBody metrics = Context.GetMetrics(@"__FILE__:__LINE__", false);
+                Assert.True(metrics.counters["stopEvents"] >= 1, @"__FILE__:__LINE__");
+                Assert.True(metrics.counters["symbolsLoaded"] >= 1, @"__FILE__:__LINE__");
+                Assert.True(metrics.counters["symbolsBytesLoaded"] > 0, @"__FILE__:__LINE__");
+                Assert.True(metrics.counters["dapRequestsRead"] > 0, @"__FILE__:__LINE__");
+                Assert.True(metrics.histograms["breakpointStoppedUs"].count >= 1, @"__FILE__:__LINE__");
+                Assert.True(metrics.histograms["breakpointStoppedUs"].buckets.Count > 0, @"__FILE__:__LINE__");
+
+                // Reset start new measurement period, but keep level counters.
+                Context.GetMetrics(@"__FILE__:__LINE__", true);
+                metrics = Context.GetMetrics(@"__FILE__:__LINE__", false);
+                Assert.Equal(0L, metrics.counters["stopEvents"], @"__FILE__:__LINE__");
+                Assert.Equal(0L, metrics.counters["symbolsLoaded"], @"__FILE__:__LINE__");
+                Assert.True(metrics.counters["symbolsBytesLoaded"] > 0, @"__FILE__:__LINE__");
+                Assert.Equal(0UL, metrics.histograms["breakpointStoppedUs"].count, @"__FILE__:__LINE__");
+
+                Int64 frameId = Context.DetectFrameId(@"__FILE__:__LINE__", "bp1");
+                Context.GetAndCheckValue(@"__FILE__:__LINE__", frameId, "42", "int", "value");
+
+                Context.Continue(@"__FILE__:__LINE__");
+            });
+
+        Label.Checkpoint("finish", "",
+            (Object context) =>
+            {
+                Context Context = (Context)context;
+                Context.WasExit(0, @"__FILE__:__LINE__");
+                Context.DebuggerExit(@"__FILE__:__LINE__");
+            });
+    }
+}
+}
@@ -0,0 +1,82 @@
+using System;
+using System.IO;
+using System.Collections.Generic;
+using System.Diagnostics;
+
+using DbgTest;
+using DbgTest.DAP;
+using DbgTest.Script;
+
+namespace TestReadMemory
+{
+class Program
+{
+    static void Main(string[] args)
+    {
+        Label.Checkpoint("init", "bp_test",
+            (Object context) =>
+            {
+                Context Context = (Context)context;
+                Context.supportsMemoryReferences = true;
+                Context.Initialize(@"__FILE__:__LINE__");
+                Context.Launch(JMC: null, StepFiltering: null, RemoteConsole: false, RemoteConsolePort: 0, @"__FILE__:__LINE__");
+                Context.AddBreakpoint(@"__FILE__:__LINE__", "bp1");
+                Context.SetBreakpoints(@"__FILE__:__LINE__");
+                Context.ConfigurationDone(@"__FILE__:__LINE__");
+
+                Context.WasEntryPointHit(@"__FILE__:__LINE__");
+                Context.Continue(@"__FILE__:__LINE__");
+            });
+
+        byte[] bytes = new byte[] { 1, 2, 3, 4, 5, 6 };
+        byte[] empty = new byte[0];
+        string str = "test";
+        int value = 42;
+        ;                                                       Label.Breakpoint("bp1");
+        Console.WriteLine("Hello world! " + bytes.Length + empty.Length + str + value);
+
+        Label.Checkpoint("bp_test", "finish",
+            (Object context) =>
+            {
+                Context Context = (Context)context;
+                Context.WasBreakpointHit(@"__FILE__:__LINE__", "bp1");
+
+                Int64 frameId = Context.DetectFrameId(@"__FILE__:__LINE__", "bp1");
+
+                // Array memory reference is first element address.
+                string? bytesReference = Context.GetMemoryReference(@"__FILE__:__LINE__", frameId, "bytes");
+                Assert.True(bytesReference != null, @"__FILE__:__LINE__");
+                ReadMemoryResponseBody body = Context.ReadMemory(@"__FILE__:__LINE__", bytesReference!, 0, 6);
+                Assert.Equal(bytesReference!, body.address, @"__FILE__:__LINE__");
+                Assert.Equal(Convert.ToBase64String(new byte[] { 1, 2, 3, 4, 5, 6 }), body.data!, @"__FILE__:__LINE__");
+                body = Context.ReadMemory(@"__FILE__:__LINE__", bytesReference!, 2, 3);
+                Assert.Equal(Convert.ToBase64String(new byte[] { 3, 4, 5 }), body.data!, @"__FILE__:__LINE__");
+
+                Assert.True(Context.GetMemoryReference(@"__FILE__:__LINE__", frameId, "str") != null, @"__FILE__:__LINE__");
+                Assert.True(Context.GetMemoryReference(@"__FILE__:__LINE__", frameId, "empty") == null, @"__FILE__:__LINE__");
+                Assert.True(Context.GetMemoryReference(@"__FILE__:__LINE__", frameId, "value") == null, @"__FILE__:__LINE__");
+
+                // Unreadable memory.
+                body = Context.ReadMemory(@"__FILE__:__LINE__", "0x0", 0, 16);
+                Assert.Equal(16, body.unreadableBytes!.Value, @"__FILE__:__LINE__");
+
+                // Wrong memory references.
+                Context.ErrorReadMemory(@"__FILE__:__LINE__", "-0x10", 16);
+                Context.ErrorReadMemory(@"__FILE__:__LINE__", " 0x10", 16);
+                Context.ErrorReadMemory(@"__FILE__:__LINE__", "0x", 16);
+                Context.ErrorReadMemory(@"__FILE__:__LINE__", "0x10000000000000000", 16);
+                Context.ErrorReadMemory(@"__FILE__:__LINE__", "0x10z", 16);
+
+                Context.Continue(@"__FILE__:__LINE__");
+            });
+
+        Label.Checkpoint("finish", "",
+            (Object context) =>
+            {
+                Context Context = (Context)context;
+                Context.WasExit(0, @"__FILE__:__LINE__");
+                Context.DebuggerExit(@"__FILE__:__LINE__");
+            });
+    }
+}
+}
@@ -0,0 +1,57 @@
+using System;
+using System.IO;
+using System.Collections.Generic;
+using System.Diagnostics;
+
+using DbgTest;
+using DbgTest.DAP;
+using DbgTest.Script;
+
+namespace TestServer
+{
+// Note, this test is run by Runner in server mode (`--server` option), script is executed by 2 successive
+// sessions with the same debugger process.
+class Program
+{
+    static void Main(string[] args)
+    {
+        Label.Checkpoint("init", "bp_test",
+            (Object context) =>
+            {
+                Context Context = (Context)context;
+                Context.Initialize(@"__FILE__:__LINE__");
+                Context.Launch(JMC: null, StepFiltering: null, RemoteConsole: false, RemoteConsolePort: 0, @"__FILE__:__LINE__");
+                Context.AddBreakpoint(@"__FILE__:__LINE__", "bp1");
+                Context.SetBreakpoints(@"__FILE__:__LINE__");
+                Context.ConfigurationDone(@"__FILE__:__LINE__");
+
+                Context.WasEntryPointHit(@"__FILE__:__LINE__");
+                Context.Continue(@"__FILE__:__LINE__");
+            });
+
+        int value = 42;
+        ;                                                       Label.Breakpoint("bp1");
+        Console.WriteLine("Hello world! " + value);
+
+        Label.Checkpoint("bp_test", "finish",
+            (Object context) =>
+            {
+                Context Context = (Context)context;
+                Context.WasBreakpointHit(@"__FILE__:__LINE__", "bp1");
+
+                Int64 frameId = Context.DetectFrameId(@"__FILE__:__LINE__", "bp1");
+                Context.GetAndCheckValue(@"__FILE__:__LINE__", frameId, "42", "int", "value");
+
+                Context.Continue(@"__FILE__:__LINE__");
+            });
+
+        Label.Checkpoint("finish", "",
+            (Object context) =>
+            {
+                Context Context = (Context)context;
+                Context.WasExit(0, @"__FILE__:__LINE__");
+                Context.DebuggerExit(@"__FILE__:__LINE__");
+            });
+    }
+}
+}
@@ -0,0 +1,87 @@
+using System;
+using System.IO;
+using System.Collections.Generic;
+using System.Diagnostics;
+
+using DbgTest;
+using DbgTest.DAP;
+using DbgTest.Script;
+
+namespace TestStartupProfile
+{
+class Program
+{
+    static void Main(string[] args)
+    {
+        Label.Checkpoint("init", "bp_test",
+            (Object context) =>
+            {
+                Context Context = (Context)context;
+                Context.Initialize(@"__FILE__:__LINE__");
+                Context.Launch(JMC: null, StepFiltering: null, RemoteConsole: false, RemoteConsolePort: 0, @"__FILE__:__LINE__");
+                Context.AddBreakpoint(@"__FILE__:__LINE__", "bp1");
+                Context.SetBreakpoints(@"__FILE__:__LINE__");
+                Context.ConfigurationDone(@"__FILE__:__LINE__");
+
+                Context.WasEntryPointHit(@"__FILE__:__LINE__");
+                Context.Continue(@"__FILE__:__LINE__");
+            });
+
+        int value = 42;
+        ;                                                       Label.Breakpoint("bp1");
+        Console.WriteLine("Hello world! " + value);
+
+        Label.Checkpoint("bp_test", "finish",
+            (Object context) =>
+            {
+                Context Context = (Context)context;
+                Context.WasBreakpointHit(@"__FILE__:__LINE__", "bp1");
+
+                // All modules loaded since configurationDone are in profile.
+                StartupProfileResponseBody profile = Context.GetStartupProfile(@"__FILE__:__LINE__", null);
+                Assert.True(profile.modulesCount >= 2, @"__FILE__:__LINE__");
+                Assert.Equal(profile.modulesCount, profile.modules.Count, @"__FILE__:__LINE__");
+                Assert.True(profile.callbacksSuspendedUs > 0, @"__FILE__:__LINE__");
+                Assert.True(profile.phasesUs.ContainsKey("pdbDiscovery"), @"__FILE__:__LINE__");
+                Assert.True(profile.phasesUs.ContainsKey("breakpointBinding"), @"__FILE__:__LINE__");
+
+                Int64 modulesTotalUs = 0;
+                bool testModuleFound = false;
+                foreach (StartupProfileModule module in profile.modules)
+                {
+                    Int64 phasesUs = 0;
+                    foreach (Int64 phaseUs in module.phasesUs.Values)
+                    {
+                        phasesUs += phaseUs;
+                    }
+                    // Phases don't overlap, so module total include all of them.
+                    Assert.True(phasesUs <= module.totalUs, @"__FILE__:__LINE__");
+                    modulesTotalUs += module.totalUs;
+                    testModuleFound = testModuleFound || module.name == "TestStartupProfile.dll";
+                }
+                Assert.Equal(profile.modulesTotalUs, modulesTotalUs, @"__FILE__:__LINE__");
+                Assert.True(testModuleFound, @"__FILE__:__LINE__");
+
+                // Slowest modules first.
+                StartupProfileResponseBody slowest = Context.GetStartupProfile(@"__FILE__:__LINE__", 2);
+                Assert.Equal(profile.modulesCount, slowest.modulesCount, @"__FILE__:__LINE__");
+                Assert.Equal(2, slowest.modules.Count, @"__FILE__:__LINE__");
+                Assert.True(slowest.modules[0].totalUs >= slowest.modules[1].totalUs, @"__FILE__:__LINE__");
+                foreach (StartupProfileModule module in profile.modules)
+                {
+                    Assert.True(module.totalUs <= slowest.modules[0].totalUs, @"__FILE__:__LINE__");
+                }
+
+                Context.Continue(@"__FILE__:__LINE__");
+            });
+
+        Label.Checkpoint("finish", "",
+            (Object context) =>
+            {
+                Context Context = (Context)context;
+                Context.WasExit(0, @"__FILE__:__LINE__");
+                Context.DebuggerExit(@"__FILE__:__LINE__");
+            });
+    }
+}
+}
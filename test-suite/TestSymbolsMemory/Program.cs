@@ -0,0 +1,98 @@
+using System;
+using System.IO;
+using System.Collections.Generic;
+using System.Diagnostics;
+
+using DbgTest;
+using DbgTest.DAP;
+using DbgTest.Script;
+
+namespace TestSymbolsMemory
+{
+class Program
+{
+    static void Main(string[] args)
+    {
+        Label.Checkpoint("init", "bp_test",
+            (Object context) =>
+            {
+                Context Context = (Context)context;
+                Context.Initialize(@"__FILE__:__LINE__");
+                // Any module indexes exceed budget, so only indexes of module that is used now are kept.
+                Context.symbolsIndexesBudget = 1;
+                Context.Launch(JMC: null, StepFiltering: null, RemoteConsole: false, RemoteConsolePort: 0, @"__FILE__:__LINE__");
+                Context.AddBreakpoint(@"__FILE__:__LINE__", "bp1");
+                Context.SetBreakpoints(@"__FILE__:__LINE__");
+                Context.ConfigurationDone(@"__FILE__:__LINE__");
+
+                Context.WasEntryPointHit(@"__FILE__:__LINE__");
+                Context.Continue(@"__FILE__:__LINE__");
+            });
+
+        // Library module frame is placed between test module frames in stack trace.
+        TestSymbolsMemoryLib.Library.Invoke(() =>
+        {
+            int value = 42;
+            ;                                                   Label.Breakpoint("bp1");
+            Console.WriteLine("Hello world! " + value);
+        });
+
+        Label.Checkpoint("bp_test", "finish",
+            (Object context) =>
+            {
+                Context Context = (Context)context;
+                // Stack trace use test module, library module and test module symbols again.
+                Context.WasBreakpointHit(@"__FILE__:__LINE__", "bp1");
+
+                SymbolsMemoryResponseBody symbolsMemory = Context.GetSymbolsMemory(@"__FILE__:__LINE__");
+                Assert.True(symbolsMemory.modules.Count >= 2, @"__FILE__:__LINE__");
+
+                SymbolsMemoryModule testModule = symbolsMemory.modules[0];
+                Assert.Equal("TestSymbolsMemory.pdb", Path.GetFileName(testModule.symbolFilePath), @"__FILE__:__LINE__");
+                Assert.False(testModule.indexesEvicted, @"__FILE__:__LINE__");
+                Assert.True(testModule.indexesSize > 0, @"__FILE__:__LINE__");
+                Assert.True(testModule.pdbDataSize > 0, @"__FILE__:__LINE__");
+                Assert.True(testModule.sourceNamesSize > 0, @"__FILE__:__LINE__");
+
+                // Evicted module keep PDB data and source names index, only derived indexes are released.
+                SymbolsMemoryModule? libModule = symbolsMemory.modules.Find(
+                    module => Path.GetFileName(module.symbolFilePath) == "TestSymbolsMemoryLib.pdb");
+                Assert.NotNull(libModule, @"__FILE__:__LINE__");
+                Assert.True(libModule!.indexesEvicted, @"__FILE__:__LINE__");
+                Assert.Equal(0UL, libModule.indexesSize, @"__FILE__:__LINE__");
+                Assert.True(libModule.pdbDataSize > 0, @"__FILE__:__LINE__");
+                Assert.True(libModule.sourceNamesSize > 0, @"__FILE__:__LINE__");
+
+                UInt64 pdbDataSize = 0;
+                UInt64 sourceNamesSize = 0;
+                UInt64 indexesSize = 0;
+                foreach (SymbolsMemoryModule module in symbolsMemory.modules)
+                {
+                    pdbDataSize += module.pdbDataSize;
+                    sourceNamesSize += module.sourceNamesSize;
+                    indexesSize += module.indexesSize;
+                }
+                Assert.Equal(pdbDataSize, symbolsMemory.pdbDataSize, @"__FILE__:__LINE__");
+                Assert.Equal(sourceNamesSize, symbolsMemory.sourceNamesSize, @"__FILE__:__LINE__");
+                Assert.Equal(indexesSize, symbolsMemory.indexesSize, @"__FILE__:__LINE__");
+
+                MetricsResponseBody metrics = Context.GetMetrics(@"__FILE__:__LINE__", false);
+                Assert.True(metrics.counters["symbolsIndexesEvicted"] >= 2, @"__FILE__:__LINE__");
+                Assert.True(metrics.counters["symbolsIndexesRebuilt"] >= 1, @"__FILE__:__LINE__");
+
+                Int64 frameId = Context.DetectFrameId(@"__FILE__:__LINE__", "bp1");
+                Context.GetAndCheckValue(@"__FILE__:__LINE__", frameId, "42", "int", "value");
+
+                Context.Continue(@"__FILE__:__LINE__");
+            });
+
+        Label.Checkpoint("finish", "",
+            (Object context) =>
+            {
+                Context Context = (Context)context;
+                Context.WasExit(0, @"__FILE__:__LINE__");
+                Context.DebuggerExit(@"__FILE__:__LINE__");
+            });
+    }
+}
+}
@@ -0,0 +1,12 @@
+using System;
+
+namespace TestSymbolsMemoryLib
+{
+public static class Library
+{
+    public static void Invoke(Action action)
+    {
+        action();
+    }
+}
+}
@@ -54,6 +54,13 @@ $ALL_TEST_NAMES = @(
     "TestDebuggerBrowsable"
     "TestDebuggerTypeProxy"
     "TestDebuggerRawValues"
+    "TestServer"
+    "TestCommandTimeouts"
+    "TestReadMemory"
+    "TestMetrics"
+    "TestStartupProfile"
+    "TestSymbolsMemory"
+    "TestAllocationProfile"
 )
 
 $TEST_NAMES = $tests
@@ -103,8 +110,13 @@ foreach ($TEST_NAME in $TEST_NAMES) {
         $FRAMEWORK += "-windows"
     }
 
+    $RUNNER_OPTIONS = @()
+    if ($TEST_NAME -eq "TestServer") {
+        $RUNNER_OPTIONS += "--server"
+    }
+
     dotnet run --project Runner -- `
-        --local $DNCDBG `
+        --local $DNCDBG @RUNNER_OPTIONS `
         --test $TEST_NAME `
         --sources $SOURCE_FILES `
         --assembly $TEST_NAME/bin/$BUILD_TYPE/$FRAMEWORK/$TEST_NAME.dll
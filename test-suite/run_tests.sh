@@ -47,6 +47,13 @@ ALL_TEST_NAMES=(
     "TestDebuggerBrowsable"
     "TestDebuggerTypeProxy"
     "TestDebuggerRawValues"
+    "TestServer"
+    "TestCommandTimeouts"
+    "TestReadMemory"
+    "TestMetrics"
+    "TestStartupProfile"
+    "TestSymbolsMemory"
+    "TestAllocationProfile"
 )
 
 TEST_NAMES="$@"
@@ -87,8 +94,14 @@ for TEST_NAME in $TEST_NAMES; do
         SOURCE_FILES="${SOURCE_FILES}${file};"
     done
 
+    RUNNER_OPTIONS=""
+    if [[ $TEST_NAME == "TestServer" ]] ;
+    then
+        RUNNER_OPTIONS="--server"
+    fi
+
     dotnet run --project Runner -- \
-        --local $DNCDBG \
+        --local $DNCDBG $RUNNER_OPTIONS \
         --test $TEST_NAME \
         --sources "$SOURCE_FILES" \
         --assembly $TEST_NAME/bin/$BUILD_TYPE/net10.0/$TEST_NAME.dll
@@ -890,6 +890,10 @@ static size_t get_image_size(mdcxt_t* cxt)
         save_size += get_stream_header_and_contents_size("#Strings", align_to((uint32_t)cxt->strings_heap.size, 4));
     if (cxt->user_string_heap.size != 0)
         save_size += get_stream_header_and_contents_size("#US", cxt->user_string_heap.size);
+#ifdef DNMD_PORTABLE_PDB
+    if (cxt->pdb.size != 0)
+        save_size += get_stream_header_and_contents_size("#Pdb", cxt->pdb.size);
+#endif // DNMD_PORTABLE_PDB
 
     if (cxt->context_flags & mdc_minimal_delta)
         save_size += get_stream_header_and_contents_size("#JTD", 0);
@@ -996,6 +1000,10 @@ bool md_write_to_buffer(mdhandle_t handle, uint8_t* buffer, size_t* len)
         stream_count++;
     if (cxt->user_string_heap.size != 0)
         stream_count++;
+#ifdef DNMD_PORTABLE_PDB
+    if (cxt->pdb.size != 0)
+        stream_count++;
+#endif // DNMD_PORTABLE_PDB
 
     char const* tables_stream_name = (cxt->context_flags & mdc_uncompressed_table_heap) ? "#-" : "#~";
 
@@ -115,6 +115,10 @@ bool try_get_blob(mdcxt_t* cxt, size_t offset, uint8_t const** blob, uint32_t* b
     if (!decompress_u32(&ptr, &data_len, &byte_count))
         return false;
 
+    // Blob must be inside heap.
+    if (byte_count > data_len)
+        return false;
+
     *blob = ptr;
     *blob_len = byte_count;
     return true;
@@ -209,6 +213,10 @@ bool initialize_tables(mdcxt_t* cxt)
         return false;
     }
 
+    // Unknown tables can't be processed (row counts are stored only for known tables).
+    if ((valid_tables >> MDTABLE_MAX_COUNT) != 0)
+        return false;
+
     size_t n = count_set_bits(valid_tables);
     uint8_t const* table_begin = curr + (n * sizeof(uint32_t));
 
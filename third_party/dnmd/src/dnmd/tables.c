@@ -769,6 +769,16 @@ bool initialize_new_table_details(
         table_row_counts[i] = cxt->tables[i].row_count;
     }
 
+#ifdef DNMD_PORTABLE_PDB
+    md_pdb_t pdb;
+    if (try_get_pdb(cxt, &pdb))
+    {
+        // Merge in the PDB reference row counts
+        for (size_t i = 0; i < MDTABLE_MAX_COUNT; ++i)
+            table_row_counts[i] += pdb.type_system_table_rows[i];
+    }
+#endif // DNMD_PORTABLE_PDB
+
     // Set the new table's row count temporarily to 1 to ensure that we initialize the table.
     table_row_counts[id] = 1;
 